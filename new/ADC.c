@@ -6,36 +6,197 @@
 #include <xc.h>
 #include "ADC.h"
 #include "Config.h"
+#include "Timer.h"
+
+/* Channel descriptors, scanned in order. repeat_log2 = burst of 2^n
+ * conversions averaged by the ADCC (ADRPT/ADCRS); filter_shift = software
+ * EMA weight 1/2^n applied to each burst result. */
+static const AdcChannel ADC_CHANNELS[ADC_CH_COUNT] = {
+    /* ADPCH              acq TAD  repeat  filter */
+    {ADC_LDR_CHANNEL,      10,     5,      2},  // LDR on RA3
+    {ADC_LDR2_CHANNEL,     10,     5,      2},  // redundant LDR on RA0
+    {0x3E,                 20,     3,      3},  // FVR buffer 1 (1.024 V); 0x3F is buffer 2
+    {0x3C,                 100,    3,      4},  // temperature indicator (TSEN, ADC_Init); 0x3D is DAC1
+    {ADC_DIM_CHANNEL,      10,     3,      0},  // lit-area LDR on RA1: the loop filters
+};
+
+static volatile uint16_t s_latest[ADC_CH_COUNT];
+static volatile uint16_t s_filter[ADC_CH_COUNT];    /* EMA, scaled by 2^filter_shift */
+static volatile uint16_t s_scans = 0;
+static uint8_t s_channel = 0;                       /* ISR only */
+
+/* One-shot level watch (ADC_Watch): channel, or ADC_CH_COUNT when idle. */
+static volatile uint8_t s_watch_ch = ADC_CH_COUNT;
+static uint16_t s_watch_level;
+static bool s_watch_above;
+static volatile bool s_watch_fired = false;
+static uint32_t s_watch_second;
+static uint16_t s_watch_counts;
+
+static void ADC_Select(uint8_t ch) {
+    const AdcChannel *c = &ADC_CHANNELS[ch];
+
+    ADPCH = c->channel;
+    ADACQ = c->acq;
+    ADRPT = (uint8_t)(1u << c->repeat_log2);
+    ADCON2bits.ADCRS = c->repeat_log2;  // ADFLTR = accumulator / ADRPT
+}
 
 void ADC_Init(void) {
     TRISAbits.TRISA3 = 1;   // LDR input on RA3
     ANSELAbits.ANSELA3 = 1; // RA3 analog 
-    ADPCH = ADC_LDR_CHANNEL; // RA3 
+    TRISAbits.TRISA0 = 1;   // Second LDR on RA0
+    ANSELAbits.ANSELA0 = 1;
+    TRISAbits.TRISA1 = 1;   // Lit-area LDR on RA1 (dimming)
+    ANSELAbits.ANSELA1 = 1;
+
+    // FVR buffer 1 at 1.024 V for the supply measurement; temperature
+    // indicator on, low range (works down to VDD = 1.8 V). Both before
+    // ADC_StartScan samples them.
+    FVRCONbits.ADFVR = 0b01;
+    FVRCONbits.TSRNG = 0;
+    FVRCONbits.TSEN = 1;
+    FVRCONbits.FVREN = 1;
 
     ADCON0bits.ADCS = 1;    // FRC (Fast RC) clock
-    ADACQ = 10;             // 10 TAD acquisition time 
-
     ADCON0bits.ADFM = 1;   
 
-    // Takes several samples to average it 
-    ADCON2bits.ADMD = 0b010;  
-
-    // 32 samples: result is 32x raw value, so we shift right by 5 to get 0-1023. 
-    ADRPT = 32;
+    // Burst average: one ADGO runs ADRPT conversions and ADFLTR holds
+    // their mean; ADTIF fires once the burst is done.
+    ADCON2bits.ADMD = 0b011;
+    ADCON3bits.ADTMD = 0b111;
 
     // Positive reference VREF+ = VDD, negative = VSS. 
     ADREF = 0x00;
 
+    ADC_Select(ADC_CH_LDR);
+
     // Enable the ADC module. 
     ADCON0bits.ADON = 1;
 }
 
-uint16_t ADC_ReadLDR(void) {
-    uint16_t adc_result;
+void ADC_StartScan(void) {
+    // Timer6 on LFINTOSC (31 kHz) / 128 paces the scan rounds.
+    T6CONbits.ON = 0;
+    T6CLKCON = 0b0100;          // LFINTOSC
+    T6CONbits.CKPS = 0b111;     // 1:128
+    T6CONbits.OUTPS = 0;        // 1:1
+    T6HLT = 0;
+    T6PR = (uint8_t)((31000UL / 128u) * ADC_SCAN_PERIOD_MS / 1000u - 1u);
+    T6TMR = 0;
+
+    IPR1bits.ADTIP = 0;
+    PIR1bits.ADTIF = 0;
+    PIE1bits.ADTIE = 1;
+    IPR5bits.TMR6IP = 0;
+    PIR5bits.TMR6IF = 0;
+    PIE5bits.TMR6IE = 1;
+    T6CONbits.ON = 1;
+}
+
+void ADC_Isr(void) {
+    if (PIR1bits.ADTIF) {
+        const AdcChannel *c = &ADC_CHANNELS[s_channel];
+        uint16_t x = ((uint16_t)ADFLTRH << 8) | ADFLTRL;
+
+        PIR1bits.ADTIF = 0;
+        s_latest[s_channel] = x;
+        if (s_channel == s_watch_ch &&
+            (s_watch_above ? (x >= s_watch_level) : (x <= s_watch_level))) {
+            Timer_GetStamp(&s_watch_second, &s_watch_counts);
+            s_watch_ch = ADC_CH_COUNT;
+            s_watch_fired = true;
+        }
+        if (s_scans == 0) {
+            s_filter[s_channel] = x << c->filter_shift;
+        } else {
+            s_filter[s_channel] += x - (s_filter[s_channel] >> c->filter_shift);
+        }
+
+        if (++s_channel < ADC_CH_COUNT) {
+            ADC_Select(s_channel);
+            ADCON0bits.ADGO = 1;
+        } else {
+            s_channel = 0;
+            s_scans++;
+        }
+    }
+    if (PIR5bits.TMR6IF) {
+        PIR5bits.TMR6IF = 0;
+        // Start a round unless the previous one is still running.
+        if (s_channel == 0 && !ADCON0bits.ADGO) {
+            ADC_Select(0);
+            ADCON0bits.ADGO = 1;
+        }
+    }
+}
+
+void ADC_Watch(uint8_t ch, uint16_t level, bool above) {
+    uint8_t giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    s_watch_level = level;
+    s_watch_above = above;
+    s_watch_fired = false;
+    s_watch_ch = ch;
+    INTCONbits.GIEL = giel_save;
+}
 
-    ADPCH = ADC_LDR_CHANNEL;
+bool ADC_WatchFired(uint32_t *seconds, uint16_t *counts) {
+    bool fired;
+    uint8_t giel_save = INTCONbits.GIEL;
 
-    // Start one conversion
+    INTCONbits.GIEL = 0;
+    fired = s_watch_fired;
+    *seconds = s_watch_second;
+    *counts = s_watch_counts;
+    INTCONbits.GIEL = giel_save;
+    return fired;
+}
+
+uint16_t ADC_GetLatest(uint8_t ch) {
+    uint16_t value;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    value = s_latest[ch];
+    INTCONbits.GIEL = giel_save;
+    return value;
+}
+
+uint16_t ADC_GetFiltered(uint8_t ch) {
+    uint16_t value;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    value = s_filter[ch];
+    INTCONbits.GIEL = giel_save;
+    return value >> ADC_CHANNELS[ch].filter_shift;
+}
+
+uint16_t ADC_GetScanCount(void) {
+    uint16_t scans;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    scans = s_scans;
+    INTCONbits.GIEL = giel_save;
+    return scans;
+}
+
+uint16_t ADC_GetSupply_mV(void) {
+    uint16_t fvr = ADC_GetFiltered(ADC_CH_FVR);
+
+    if (fvr == 0) {
+        return 0;
+    }
+    // VDD = 1024 mV * 1023 / reading
+    return (uint16_t)((1024UL * 1023UL) / fvr);
+}
+
+uint16_t ADC_ReadLDR(void) {
+    ADC_Select(ADC_CH_LDR);
+
+    // Start one burst (32 conversions)
     ADCON0bits.ADGO = 1;
 
     // Block until conversion is complete
@@ -43,12 +204,6 @@ uint16_t ADC_ReadLDR(void) {
 
     }
 
-    // Read 16-bit accumulated result
-    adc_result = ADFLTRH;
-    adc_result = (adc_result << 8) | ADFLTRL;
-
-    // Divide by 32  to get average in 0-1023 range. 
-    adc_result = adc_result >> 5;
-
-    return adc_result;
+    // ADFLTR already holds the burst mean (0-1023)
+    return ((uint16_t)ADFLTRH << 8) | ADFLTRL;
 }
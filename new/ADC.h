@@ -4,12 +4,50 @@
 #define ADC_H
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/* Scan table entries (ADC.c); values are read back by index. */
+#define ADC_CH_LDR      0   /* main LDR, RA3 */
+#define ADC_CH_LDR2     1   /* redundant LDR, RA0 */
+#define ADC_CH_FVR      2   /* 1.024 V reference, measured against VDD */
+#define ADC_CH_TEMP     3   /* internal temperature indicator (raw) */
+#define ADC_CH_DIM      4   /* lit-area LDR for the dimming loop, RA1 */
+#define ADC_CH_COUNT    5
+
+typedef struct {
+    uint8_t channel;        /* ADPCH value */
+    uint8_t acq;            /* acquisition time, TADs */
+    uint8_t repeat_log2;    /* burst of 2^n conversions averaged in hardware */
+    uint8_t filter_shift;   /* EMA weight 1/2^n across bursts */
+} AdcChannel;
 
 // Function declarations
 void ADC_Init(void);
-uint16_t ADC_ReadLDR(void);
 
-#endif /* ADC_H */
+/** Start background round-robin scans every ADC_SCAN_PERIOD_MS. */
+void ADC_StartScan(void);
+
+/** Low-priority ISR hook: ADTIF (burst done) and the Timer6 scan pacer. */
+void ADC_Isr(void);
+
+uint16_t ADC_GetLatest(uint8_t ch);
+uint16_t ADC_GetFiltered(uint8_t ch);
+uint16_t ADC_GetScanCount(void);
 
+/**
+ * One-shot level watch: the first burst result on ch at or above level
+ * (else at or below it) is time-stamped in the ISR with Timer_GetStamp,
+ * however late the main loop looks. Re-arming cancels the last watch.
+ */
+void ADC_Watch(uint8_t ch, uint16_t level, bool above);
 
+/** True once the watch has fired; its stamp. */
+bool ADC_WatchFired(uint32_t *seconds, uint16_t *counts);
 
+/** Supply voltage from the FVR channel, in mV. */
+uint16_t ADC_GetSupply_mV(void);
+
+/** Blocking LDR read; only before ADC_StartScan (calibration). */
+uint16_t ADC_ReadLDR(void);
+
+#endif /* ADC_H */
@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * File:   BCD.c
+ * Purpose: Packed BCD helpers (see BCD.h).
+ ******************************************************************************/
+
+#include "BCD.h"
+
+uint8_t BCD_Inc(uint8_t b) {
+    b++;
+    if ((b & 0x0F) == 0x0A) {
+        b += 6;                 // Carry the low digit into the high digit
+    }
+    return (b >= 0xA0) ? 0x00 : b;
+}
+
+uint8_t BCD_ToBin(uint8_t b) {
+    return (uint8_t)((b >> 4) * 10u + (b & 0x0F));
+}
+
+uint8_t BCD_FromBin(uint8_t n) {
+    uint8_t tens = 0;
+
+    while (n >= 10u) {
+        n -= 10u;
+        tens++;
+    }
+    return (uint8_t)((tens << 4) | n);
+}
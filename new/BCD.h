@@ -0,0 +1,22 @@
+/*******************************************************************************
+ * File:   BCD.h
+ * Purpose: Packed BCD helpers (0x00-0x99 per byte) for the time-of-day and
+ *          date counters, so display formatting is nibble extraction and
+ *          the PIC18 never runs its software divide on the refresh path.
+ ******************************************************************************/
+
+#ifndef BCD_H
+#define BCD_H
+
+#include <stdint.h>
+
+/** b + 1 in BCD; 0x99 wraps to 0x00 (caller carries into the next byte). */
+uint8_t BCD_Inc(uint8_t b);
+
+/** Packed BCD to binary (hardware multiply, no divide). */
+uint8_t BCD_ToBin(uint8_t b);
+
+/** Binary 0-99 to packed BCD (subtract loop, no divide). */
+uint8_t BCD_FromBin(uint8_t n);
+
+#endif /* BCD_H */
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * File:   CRC.h
+ * Purpose: The CRC/SCAN peripheral, shared. One CRC-16/CCITT engine
+ *          (polynomial 0x1021, seed 0xFFFF, MSb first) checks both the
+ *          persistence records, fed a byte at a time, and program flash,
+ *          fed a word at a time by the memory scanner in peek mode: the
+ *          scanner only takes instruction cycles in which the CPU is not
+ *          fetching, so a scan never stalls the CPU or delays an interrupt.
+ *          All callers are main-loop code; the engine is never used from an
+ *          ISR.
+ ******************************************************************************/
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CRC_SEED    0xFFFFu
+
+/** Configure the engine and the scanner. Before Persist_Load. */
+void CRC_Init(void);
+
+/**
+ * CRC of a record in RAM. Waits out a scan chunk still running and leaves
+ * its result in place for CRC_ScanResult.
+ */
+uint16_t CRC_Block(const void *data, uint8_t len);
+
+/**
+ * Scan program memory first..last (inclusive, word aligned), continuing
+ * from crc (CRC_SEED for the first chunk). Runs in the background.
+ */
+void CRC_ScanStart(uint32_t first, uint32_t last, uint16_t crc);
+
+/** True while a scan chunk is still running. */
+bool CRC_ScanBusy(void);
+
+/** CRC so far, once the chunk is done: the crc for the next chunk. */
+uint16_t CRC_ScanResult(void);
+
+#endif /* CRC_H */
@@ -1,14 +1,26 @@
 /*******************************************************************************
  * File:   Calendar.c
- * Purpose: Internal calendar with leap year and UK DST (BST) support.
- *          UK DST: BST starts last Sunday March, ends last Sunday October.
+ * Purpose: Internal calendar with leap year support. Provides the
+ *          nth-weekday-of-month lookup the DST rule table (DST.c) is built on.
  ******************************************************************************/
 
+#include <xc.h>
 #include "Calendar.h"
-
-static uint16_t s_year = 2026;
-static uint8_t s_month = 1;
-static uint8_t s_day = 1;
+#include "BCD.h"
+
+/* Read by the schedule, DST and log time stamps on every pass: kept in
+ * the access bank (see Main.c). The BCD copies are for display and are
+ * advanced with BCD increments. */
+typedef struct {
+    uint16_t year;
+    uint8_t  month;
+    uint8_t  day;
+    uint16_t year_bcd;
+    uint8_t  month_bcd;
+    uint8_t  day_bcd;
+} CalendarDate;
+
+static __near CalendarDate s_date = {2026, 1, 1, 0x2026, 0x01, 0x01};
 
 /* Days in each month (non-leap). Index 0 = January. */
 static const uint8_t DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
@@ -37,61 +49,126 @@ static uint8_t LastDayOfMonth(uint16_t y, uint8_t m) {
     return (uint8_t)(28 + Calendar_IsLeapYear(y));
 }
 
-/* Get day number of last Sunday in given month. */
-static uint8_t LastSundayOfMonth(uint16_t y, uint8_t m) {
-    uint8_t last = LastDayOfMonth(y, m);
-    return last - DayOfWeek(y, m, last);
+uint8_t Calendar_NthWeekdayOfMonth(uint16_t y, uint8_t m, uint8_t week, uint8_t weekday) {
+    if (week >= CALENDAR_WEEK_LAST) {
+        uint8_t last = LastDayOfMonth(y, m);
+        return (uint8_t)(last - (DayOfWeek(y, m, last) + 7u - weekday) % 7u);
+    }
+    return (uint8_t)(1u + (weekday + 7u - DayOfWeek(y, m, 1)) % 7u + (week - 1u) * 7u);
+}
+
+uint8_t Calendar_DaysInMonth(uint16_t y, uint8_t m) {
+    return (m >= 1 && m <= 12) ? LastDayOfMonth(y, m) : 0;
 }
 
 void Calendar_Init(uint16_t year, uint8_t month, uint8_t day) {
-    s_year = year;
-    s_month = (month >= 1 && month <= 12) ? month : 1;
-    s_day = day;
+    uint8_t last;
+
+    s_date.year = year;
+    s_date.month = (month >= 1 && month <= 12) ? month : 1;
+    last = LastDayOfMonth(year, s_date.month);
+    s_date.day = (day < 1) ? 1 : ((day > last) ? last : day);
+
+    uint8_t century = 0;
+    while (year >= 100u) {
+        year -= 100u;
+        century++;
+    }
+    s_date.year_bcd = ((uint16_t)BCD_FromBin(century) << 8) | BCD_FromBin((uint8_t)year);
+    s_date.month_bcd = BCD_FromBin(s_date.month);
+    s_date.day_bcd = BCD_FromBin(s_date.day);
 }
 
 void Calendar_AdvanceDay(void) {
-    uint8_t last = LastDayOfMonth(s_year, s_month);
-
-    if (s_day >= last) {
-        s_day = 1;
-        if (s_month >= 12) {
-            s_month = 1;
-            s_year++;
+    uint8_t last = LastDayOfMonth(s_date.year, s_date.month);
+
+    if (s_date.day >= last) {
+        s_date.day = 1;
+        s_date.day_bcd = 0x01;
+        if (s_date.month >= 12) {
+            s_date.month = 1;
+            s_date.month_bcd = 0x01;
+            s_date.year++;
+            uint8_t low = BCD_Inc((uint8_t)s_date.year_bcd);
+            uint8_t high = (uint8_t)(s_date.year_bcd >> 8);
+            if (low == 0x00) {
+                high = BCD_Inc(high);
+            }
+            s_date.year_bcd = ((uint16_t)high << 8) | low;
         } else {
-            s_month++;
+            s_date.month++;
+            s_date.month_bcd = BCD_Inc(s_date.month_bcd);
         }
     } else {
-        s_day++;
+        s_date.day++;
+        s_date.day_bcd = BCD_Inc(s_date.day_bcd);
     }
 }
 
-uint8_t Calendar_DayOfWeek(void) {
-    return DayOfWeek(s_year, s_month, s_day);
+void Calendar_RetreatDay(void) {
+    if (s_date.day > 1) {
+        Calendar_Init(s_date.year, s_date.month, (uint8_t)(s_date.day - 1u));
+    } else if (s_date.month > 1) {
+        Calendar_Init(s_date.year, (uint8_t)(s_date.month - 1u), LastDayOfMonth(s_date.year, (uint8_t)(s_date.month - 1u)));
+    } else {
+        Calendar_Init(s_date.year - 1u, 12, 31);
+    }
 }
 
-uint8_t Calendar_LastSundayOfMarch(void) {
-    return LastSundayOfMonth(s_year, 3);
+uint8_t Calendar_DayOfWeek(void) {
+    return DayOfWeek(s_date.year, s_date.month, s_date.day);
 }
 
-uint8_t Calendar_LastSundayOfOctober(void) {
-    return LastSundayOfMonth(s_year, 10);
+/* Days since 1 Jan CALENDAR_EPOCH_YEAR (day 0). Used for log/journal time stamps. */
+uint16_t Calendar_DaysSinceEpoch(void) {
+    uint16_t days = 0;
+
+    for (uint16_t y = CALENDAR_EPOCH_YEAR; y < s_date.year; y++) {
+        days += 365u + Calendar_IsLeapYear(y);
+    }
+    for (uint8_t m = 1; m < s_date.month; m++) {
+        days += LastDayOfMonth(s_date.year, m);
+    }
+    return days + (uint16_t)(s_date.day - 1u);
 }
 
-uint8_t Calendar_IsDST(void) {
-    if (s_month < 3 || s_month > 10) return 0;
-    if (s_month > 3 && s_month < 10) return 1;
-    if (s_month == 3) return (s_day >= LastSundayOfMonth(s_year, 3));
-    return (s_day <= LastSundayOfMonth(s_year, 10));  /* month == 10 */
+void Calendar_FromDays(uint16_t days, uint16_t *year, uint8_t *month, uint8_t *day) {
+    uint16_t y = CALENDAR_EPOCH_YEAR;
+    uint8_t m = 1;
+
+    while (days >= 365u + Calendar_IsLeapYear(y)) {
+        days -= 365u + Calendar_IsLeapYear(y);
+        y++;
+    }
+    while (days >= LastDayOfMonth(y, m)) {
+        days -= LastDayOfMonth(y, m);
+        m++;
+    }
+    *year = y;
+    *month = m;
+    *day = (uint8_t)(days + 1u);
 }
 
 uint16_t Calendar_GetYear(void) {
-    return s_year;
+    return s_date.year;
 }
 
 uint8_t Calendar_GetMonth(void) {
-    return s_month;
+    return s_date.month;
 }
 
 uint8_t Calendar_GetDay(void) {
-    return s_day;
+    return s_date.day;
+}
+
+uint16_t Calendar_GetYearBCD(void) {
+    return s_date.year_bcd;
+}
+
+uint8_t Calendar_GetMonthBCD(void) {
+    return s_date.month_bcd;
+}
+
+uint8_t Calendar_GetDayBCD(void) {
+    return s_date.day_bcd;
 }
@@ -1,6 +1,6 @@
 /*******************************************************************************
  * File:   Calendar.h
- * Purpose: Internal calendar with leap year and UK DST (BST) support.
+ * Purpose: Internal calendar with leap year support. DST rules live in DST.c.
  ******************************************************************************/
 
 #ifndef CALENDAR_H
@@ -8,15 +8,35 @@
 
 #include <stdint.h>
 
+#define CALENDAR_EPOCH_YEAR  2000u
+
+/* A month out of range becomes January, a day out of range the nearest
+ * day of that month: saved state or a set request never makes 31 Feb. */
 void Calendar_Init(uint16_t year, uint8_t month, uint8_t day);
 void Calendar_AdvanceDay(void);
+void Calendar_RetreatDay(void);     /* for UTC offsets west of Greenwich */
 uint8_t Calendar_IsLeapYear(uint16_t y);
+uint8_t Calendar_DaysInMonth(uint16_t y, uint8_t m);   /* 28-31; 0 if m is not 1-12 */
 uint8_t Calendar_DayOfWeek(void);
-uint8_t Calendar_IsDST(void);
-uint8_t Calendar_LastSundayOfMarch(void);
-uint8_t Calendar_LastSundayOfOctober(void);
+
+#define CALENDAR_WEEK_LAST  5u
+
+/**
+ * Day of month of the week'th weekday (0=Sun..6=Sat) of month m in year y.
+ * week is 1-4, or CALENDAR_WEEK_LAST for the last one in the month.
+ */
+uint8_t Calendar_NthWeekdayOfMonth(uint16_t y, uint8_t m, uint8_t week, uint8_t weekday);
+uint16_t Calendar_DaysSinceEpoch(void);
+
+/* The date that many days after 1 Jan CALENDAR_EPOCH_YEAR (inverse of the above). */
+void Calendar_FromDays(uint16_t days, uint16_t *year, uint8_t *month, uint8_t *day);
 uint16_t Calendar_GetYear(void);
 uint8_t Calendar_GetMonth(void);
 uint8_t Calendar_GetDay(void);
 
+/* Same date in packed BCD (year 0x2026), kept in step by Calendar_AdvanceDay. */
+uint16_t Calendar_GetYearBCD(void);
+uint8_t Calendar_GetMonthBCD(void);
+uint8_t Calendar_GetDayBCD(void);
+
 #endif /* CALENDAR_H */
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * File:   Comparator.c
+ * Purpose: Comparator C1 + DAC1 darkness detection (see Comparator.h).
+ *          Polarity is set so C1OUT = 1 means dark. Hysteresis: once dark,
+ *          the DAC moves to the light trip point, so it has to get clearly
+ *          lighter than the threshold to switch back.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Comparator.h"
+#include "Config.h"
+
+static uint8_t s_dac_dark = 16;         /* DAC1R code while light: dusk trip */
+static uint8_t s_dac_light = 17;        /* while dark: dawn trip */
+static bool s_dark_when_low = true;
+static volatile uint16_t s_edges = 0;
+
+/* DAC1R for the current state: dusk trip while light, dawn trip while dark. */
+static void Comparator_Retune(void) {
+    DAC1CON1bits.DAC1R = CM1CON0bits.OUT ? s_dac_light : s_dac_dark;
+}
+
+/* 10-bit ADC count to 5-bit DAC code, both ratios of VDD. */
+static uint8_t Comparator_Code(uint16_t count) {
+    uint16_t code = (count + 16u) >> 5;
+
+    return (code > 31u) ? 31u : (uint8_t)code;
+}
+
+void Comparator_Init(uint16_t dark_trip, uint16_t light_trip, bool dark_when_low) {
+    s_dark_when_low = dark_when_low;
+
+    DAC1CON0bits.PSS = 0b00;    // VDD, same reference as the ADC
+    DAC1CON0bits.NSS = 0;       // VSS
+    DAC1CON0bits.DAC1EN = 1;
+
+    TRISFbits.TRISF7 = 1;       // LDR divider on RF7
+    ANSELFbits.ANSELF7 = 1;
+    CM1NCHbits.NCH = 0b011;     // C1IN3- = RF7
+    CM1PCHbits.PCH = 0b101;     // DAC output on the + input
+    CM1CON0bits.HYS = 1;
+    /* OUT = (DAC > LDR) ^ POL, so OUT = 1 is dark either way round. */
+    CM1CON0bits.POL = dark_when_low ? 0 : 1;
+    CM1CON1bits.INTP = 1;       // both edges: dusk and dawn
+    CM1CON1bits.INTN = 1;
+
+    Comparator_SetThreshold(dark_trip, light_trip);
+    CM1CON0bits.EN = 1;
+
+    IPR2bits.C1IP = 0;
+    PIR2bits.C1IF = 0;
+    PIE2bits.C1IE = 1;
+}
+
+void Comparator_SetThreshold(uint16_t dark_trip, uint16_t light_trip) {
+    uint8_t dark = Comparator_Code(dark_trip);
+    uint8_t light = Comparator_Code(light_trip);
+
+    /* At least one DAC step of hysteresis, towards the light side. */
+    if (s_dark_when_low) {
+        if (light <= dark) {
+            light = (dark < 31u) ? (uint8_t)(dark + 1u) : 31u;
+        }
+    } else if (light >= dark) {
+        light = (dark > 0u) ? (uint8_t)(dark - 1u) : 0u;
+    }
+    uint8_t giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;        // C1IF retunes from these
+    s_dac_dark = dark;
+    s_dac_light = light;
+    Comparator_Retune();
+    INTCONbits.GIEL = giel_save;
+}
+
+bool Comparator_IsDark(void) {
+    return CM1CON0bits.OUT != 0;
+}
+
+uint16_t Comparator_GetEdges(void) {
+    uint16_t edges;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    edges = s_edges;
+    INTCONbits.GIEL = giel_save;
+    return edges;
+}
+
+void Comparator_Isr(void) {
+    if (PIR2bits.C1IF) {
+        PIR2bits.C1IF = 0;
+        Comparator_Retune();
+        s_edges++;
+    }
+}
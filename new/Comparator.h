@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * File:   Comparator.h
+ * Purpose: Continuous darkness detection with comparator C1 against DAC1.
+ *          The LDR divider drives C1IN3- (RF7), the DAC is set from the
+ *          calibrated threshold, and dusk/dawn edges raise C1IF. The ADC is
+ *          then only needed for calibration and telemetry.
+ ******************************************************************************/
+
+#ifndef COMPARATOR_H
+#define COMPARATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Start C1 and DAC1. dark_trip and light_trip are the 10-bit ADC counts of
+ * the dusk and dawn trip points (Lux_ToAdc); dark_when_low selects dark =
+ * reading below them (else above them).
+ */
+void Comparator_Init(uint16_t dark_trip, uint16_t light_trip, bool dark_when_low);
+
+/** Move the trip points (e.g. a new threshold over Modbus). */
+void Comparator_SetThreshold(uint16_t dark_trip, uint16_t light_trip);
+
+/** Live comparator output: true while it is dark. */
+bool Comparator_IsDark(void);
+
+/** Dusk/dawn edges seen since start-up. */
+uint16_t Comparator_GetEdges(void);
+
+/** Low-priority ISR hook: C1IF, retunes the DAC for hysteresis. */
+void Comparator_Isr(void);
+
+#endif /* COMPARATOR_H */
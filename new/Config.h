@@ -14,31 +14,92 @@
 #include <stdint.h>
 #include <stdbool.h>
 
- // test mode configuration 
-#define TEST_MODE
-
-
-#ifdef TEST_MODE
-    #define TMR0_RELOAD_HIGH    0x0B
-    #define TMR0_RELOAD_LOW     0xDB
-    #define TICKS_PER_SECOND    1
-    #define TICKS_PER_HOUR      1
-    #define SENSOR_INTERVAL     TICKS_PER_HOUR
-#else
-    #define TMR0_RELOAD_HIGH    0x0B
-    #define TMR0_RELOAD_LOW     0xDB
-    #define TICKS_PER_SECOND    1       /* Normal: 1 tick = 1 real second */
-    #define TICKS_PER_HOUR      3600    /* 1 hour = 3600 ticks */
-    #define SENSOR_INTERVAL     60
+ // timebase configuration 
+#define TMR0_RELOAD_HIGH    0x0B
+#define TMR0_RELOAD_LOW     0xDB
+#define TICKS_PER_SECOND    1       /* 1 tick = 1 real second */
+#define SENSOR_INTERVAL     60      /* clock seconds between LDR reads */
+
+/* Time acceleration: clock seconds per real second. 1 = deployment,
+ * 3600 = demo (one hour per second). Same code path either way; change it
+ * at run time over Modbus (MB_REG_TIME_SCALE) or the console ('t'). */
+#define TIME_SCALE_DEFAULT  1
+#define TIME_SCALE_MAX      3600
+
+
+/* Main-loop cycle profiler (Profile.h): debug builds only. MPLAB defines
+ * __DEBUG for the debug configuration. */
+#ifdef __DEBUG
+#define PROFILE_ENABLED
 #endif
 
-
 /* LDR: calibrated delta used for binary day/night (see Main.c calibration) */
 
+/* Main light brightness (0-255) inside an energy-save window. 0 (the
+ * default) switches it off, as the controller always has; a level such as
+ * 77 (~30%) dims it instead, a policy change that uses more energy than
+ * the switch-off (MB_REG_ENERGY_SAVED goes negative). */
+#define LIGHT_DIM_LEVEL         0
+#define LIGHT_RAMP_SECONDS      4       /* off <-> full ramp time (real seconds) */
+
+/* Constant-illuminance dimming (Dimmer.c): the scheduled level becomes a
+ * ceiling and a PI loop holds the light on its own LDR (ADC_DIM_CHANNEL)
+ * at the setpoint. That sensor must see the lit area; the dark/light LDR
+ * must not. Its divider orientation is fixed by the wiring, not learned in
+ * calibration like the main LDR's: true = LDR on the ground side (dark
+ * reads high). Gains are Q8 levels per lux per step at the ADC scan rate;
+ * the defaults suit a lamp adding 40-600 lux at the sensor at full power.
+ * DIM_RATE_STEP per step must stay below the Light.c ramp rate (~64
+ * levels/s). Off by default: the loop is only tested on the host
+ * (test/host/test_dimmer.c) and no board has the RA1 sensor fitted yet. */
+//#define DIMMING_ENABLED
+#define ADC_DIM_CHANNEL         0x01    /* lit-area LDR on RA1 */
+#define DIM_SENSOR_DARK_ABOVE   false
+#define DIM_SETPOINT_LUX        20u
+#define DIM_KP_Q8               32      /* 0.125 level per lux */
+#define DIM_KI_Q8               48      /* 0.19 level per lux per step */
+#define DIM_RATE_STEP           6       /* levels per step: 60/s at 10 Hz */
+
+/* Base energy-save rule (every day); more rules in Schedule.c */
 #define ENERGY_SAVE_START_HOUR  1       // 1am - turn light off 
 #define ENERGY_SAVE_END_HOUR    5       // 5am - turn light back on 
 
-/* Start date - change before flashing for DST/leap year demos */
+/* Daylight-saving rule set for this installation (DST.h DST_ZONE_*) */
+#define DST_ZONE        DST_ZONE_UK
+
+/* Time sources set the date and clock (UTC, converted for DST_ZONE) at
+ * the 1x time scale. MSF 60 kHz receiver (MSF.c) output on RD3. Off by
+ * default: the decoder is only tested on the host (test/host/test_msf.c)
+ * and no receiver has been fitted to a board yet. */
+//#define MSF_ENABLED
+#define MSF_CARRIER_OFF_LEVEL   1       /* receiver output while carrier is off */
+
+/* GPS module (GPS.c): NMEA on RC7 at 9600 baud, 1PPS on RB4. Off by
+ * default: the parser is only tested on the host (test/host/test_gps.c)
+ * and no module has been fitted to a board yet. */
+//#define GPS_ENABLED
+
+/* Clock agreement between controllers on the Modbus bus (TimeSync.c):
+ * followers slew to the broadcasts of one master. Define TIMESYNC_MASTER
+ * on the controller with the best time source, one per bus. Where a SCADA
+ * master also polls the bus a broadcast can still meet a request head on
+ * (a lost frame, the next comes a period later); there, better to have the
+ * SCADA send the frame and leave TIMESYNC_MASTER undefined everywhere.
+ * Off by default: master and follower are only tested against each other
+ * on the host (test/host/test_timesync.c), not yet on a shared bus. */
+//#define TIME_SYNC
+//#define TIMESYNC_MASTER
+#define TIMESYNC_PERIOD     16u     /* seconds between broadcasts */
+
+/* Timebase discipline (Discipline.c) from a 1PPS reference on RB4: trims
+ * the crystal's frequency error; the trim is kept in data EEPROM. Off by
+ * default: the loop is only tested on the host (test/host/test_discipline.c)
+ * and no board has a 1PPS source wired to RB4 yet. */
+//#define PPS_DISCIPLINE
+#define DISC_EE_ADDRESS     0x000u    /* 4 bytes */
+
+/* Start date until a time source sets it - change before flashing for
+ * DST/leap year demos */
 #define START_YEAR   2026
 #define START_MONTH  3     /* March - near DST spring-forward */
 #define START_DAY    25    /* Last Sun Mar 2026 = Mar 29 */
@@ -47,6 +108,67 @@
 #define MINUTES_PER_HOUR        60
 #define HOURS_PER_DAY           24
 #define ADC_LDR_CHANNEL 0x03
+#define ADC_LDR2_CHANNEL 0x00     /* redundant LDR on RA0 */
+#define ADC_SCAN_PERIOD_MS  100   /* background scan round, 5-1000 ms */
+
+/* Darkness from comparator C1 vs DAC1 (Comparator.c) instead of the
+ * per-minute ADC compare. Off by default: the LDR divider must also be
+ * wired to RF7 (C1IN3-), which the current board does not do. */
+//#define DARK_DETECT_COMPARATOR
+
+/* Dark/light hysteresis as a light ratio, in centi-log10 lux (Lux.h):
+ * once dark, it must get 10^(10/100) = 1.26x brighter than the threshold
+ * to count as light again. Used by both detection paths. */
+#define LUX_HYST_CLX        10
+
+/* Heartbeat LED from NCO1/CLC (LEDS.c), gated by a main-loop liveness
+ * token. Off by default (the software toggle) until the CLC input
+ * selections, the RB0 PPS output code and N1CKS have been checked against
+ * the PIC18F66K40 datasheet on a board. */
+//#define HEARTBEAT_HARDWARE
+#define HEARTBEAT_PERIOD_MS 4000      /* 2 s on, 2 s off */
+
+/* Windowed WDT (Main.c config bits: 4 s period, open for the last 2 s):
+ * clear every 3 Timer0 ticks, at the same point in the tick each time
+ * (Watchdog.c). With LFINTOSC off by up to 15% the window is 2.3-3.4 s at
+ * worst, so 3 s leaves 0.7 s before it and 0.4 s after it for main-loop
+ * latency jitter and phase steps of the tick. */
+#define WDT_FEED_TICKS          3
+
+/* Modbus-RTU slave address on the RS-485 bus (1-247) */
+#define MODBUS_SLAVE_ADDRESS    1
+
+/* Timer0 ISR entry latency budget (Latency.c reports PASS/FAIL against it) */
+#define ISR_LATENCY_BUDGET_US   64
+
+/* Memory: the hot main-loop and calendar state is __near (access bank).
+ * The project compiles with -maddrqual=require so the qualifier is
+ * honoured and an overfull access bank fails the build instead of
+ * silently banking it. tools/memreport.py checks per-module RAM/flash
+ * against its budgets after each build and fails it on an overrun. */
+
+/* LDR history log: upper 32 KB of program flash less the journal rows
+ * (254 rows = 3+ weeks of per-minute data). Link with
+ * -mreserve=rom@0x8000:0xFFFF so no code is placed there. */
+#define LOG_FLASH_START 0x8000UL
+#define LOG_FLASH_END   0xFF00UL
+#define LOG_DUMP_PER_PASS 4         /* console 'g' records per main-loop pass */
+
+/* Program flash integrity (FlashCheck.c): the CRC/SCAN module checks the
+ * code area below the log against a CRC-16/CCITT stored by the build in
+ * its last word. The project links with -mreserve=rom@0x7FFE:0x7FFF and
+ * -mchecksum=0-7FFD@7FFE,width=-2,algorithm=5,offset=FFFF,polynomial=1021,revword=2
+ * (revword: the scanner feeds each word high byte first). Off by default
+ * until the scan has been run against a built image on a board. */
+//#define FLASH_CHECK
+#define FLASH_CHECK_CRC_ADDRESS (LOG_FLASH_START - 2u)
+#define FLASH_CHECK_CHUNK       1024u     /* bytes scanned per main-loop pass */
+#define FLASH_CHECK_PERIOD      60u       /* ticks from pass to pass */
+
+/* Event journal brown-out flush: last two rows of flash. HLVD trip point
+ * 0b0111 = 3.05 V, early warning on a 3.3 V supply ahead of BOR. */
+#define JOURNAL_FLASH_START 0xFF00UL
+#define JOURNAL_HLVD_SEL    0b0111
 
 #endif 
 
@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * File:   DST.c
+ * Purpose: Table-driven daylight-saving rules. Each zone gives the start and
+ *          end rule (month, week, weekday, local switch hour) and the shift.
+ *          Switch hours are local wall-clock time before the change: standard
+ *          time for the start rule, summer time for the end rule.
+ ******************************************************************************/
+
+#include "DST.h"
+#include "Calendar.h"
+#include "BCD.h"
+
+typedef struct {
+    uint8_t month;      /* 1-12; 0 = zone has no summer time */
+    uint8_t week;       /* 1-4, or CALENDAR_WEEK_LAST */
+    uint8_t weekday;    /* 0=Sun..6=Sat */
+    uint8_t hour;       /* packed BCD, compared directly with the clock */
+} DstRule;
+
+typedef struct {
+    DstRule start;
+    DstRule end;
+    uint8_t shift;      /* minutes added while summer time is in force */
+    int16_t utc_offset; /* standard time minus UTC, minutes */
+    char std_name[5];
+    char dst_name[5];
+} DstZone;
+
+static const DstZone ZONES[DST_ZONE_COUNT] = {
+    /* start                              end                                 shift  UTC */
+    {{ 0, 0,                 0, 0x00}, { 0, 0,                 0, 0x00},  0,    0, "UTC",  "UTC"},
+    {{ 3, CALENDAR_WEEK_LAST, 0, 0x01}, {10, CALENDAR_WEEK_LAST, 0, 0x02}, 60,    0, "GMT",  "BST"},
+    {{ 3, CALENDAR_WEEK_LAST, 0, 0x02}, {10, CALENDAR_WEEK_LAST, 0, 0x03}, 60,   60, "CET",  "CEST"},
+    {{ 3, 2,                 0, 0x02}, {11, 1,                 0, 0x02}, 60, -300, "EST",  "EDT"},
+    {{10, 1,                 0, 0x02}, { 4, 1,                 0, 0x03}, 60,  600, "AEST", "AEDT"},
+};
+
+/* Ordered key for a local instant within a year (4:5:6 bits); BCD hours
+ * (0x00-0x23) fit in 6 bits and sort correctly. */
+#define DST_INSTANT(month, day, hour) \
+    (((uint16_t)(month) << 11) | ((uint16_t)(day) << 6) | (hour))
+
+#define DST_MINUTES_PER_DAY 1440
+
+static uint8_t s_zone = DST_ZONE_NONE;
+static bool s_active = false;
+
+/* Date and hour of the next change; month 0 = never. */
+static uint8_t s_next_month = 0;
+static uint8_t s_next_day = 0;
+static uint8_t s_next_hour = DST_NO_SWITCH;
+
+static uint8_t s_switch_hour = DST_NO_SWITCH;
+
+static uint16_t DST_RuleInstant(const DstRule *rule, uint16_t year) {
+    uint8_t day = Calendar_NthWeekdayOfMonth(year, rule->month, rule->week, rule->weekday);
+    return DST_INSTANT(rule->month, day, rule->hour);
+}
+
+static uint16_t DST_Today(uint8_t hour) {
+    return DST_INSTANT(Calendar_GetMonth(), Calendar_GetDay(), hour);
+}
+
+/* Next change strictly after now: this year's rule date, else next year's. */
+static void DST_ScheduleNext(uint16_t now) {
+    const DstRule *rule = s_active ? &ZONES[s_zone].end : &ZONES[s_zone].start;
+    uint16_t year = Calendar_GetYear();
+    uint16_t next;
+
+    if (rule->month == 0) {
+        s_next_month = 0;
+        return;
+    }
+    next = DST_RuleInstant(rule, year);
+    if (next <= now) {
+        next = DST_RuleInstant(rule, year + 1u);
+    }
+    s_next_month = rule->month;
+    s_next_day = (uint8_t)((next >> 6) & 0x1F);
+    s_next_hour = rule->hour;
+}
+
+/* Summer time in force? now_start is read on the start rule's clock
+ * (standard time), now_end on the end rule's (summer time). */
+static bool DST_InSummer(const DstZone *z, uint16_t now_start, uint16_t now_end) {
+    uint16_t start, end;
+
+    if (z->start.month == 0) {
+        return false;
+    }
+    start = DST_RuleInstant(&z->start, Calendar_GetYear());
+    end = DST_RuleInstant(&z->end, Calendar_GetYear());
+    if (start < end) {
+        return now_start >= start && now_end < end;
+    }
+    /* Southern hemisphere: summer time spans the new year. */
+    return now_start >= start || now_end < end;
+}
+
+/* Bring a minute of the day back into 0-1439, moving the calendar. A UTC
+ * minute before the calendar's date plus a zone offset west of Greenwich
+ * can be two days back. */
+static int16_t DST_RollDay(int16_t minute) {
+    while (minute < 0) {
+        Calendar_RetreatDay();
+        minute = (int16_t)(minute + DST_MINUTES_PER_DAY);
+    }
+    while (minute >= DST_MINUTES_PER_DAY) {
+        Calendar_AdvanceDay();
+        minute = (int16_t)(minute - DST_MINUTES_PER_DAY);
+    }
+    return minute;
+}
+
+bool DST_Init(uint8_t zone, uint8_t hours) {
+    uint16_t now;
+
+    if (zone >= DST_ZONE_COUNT) {
+        return false;
+    }
+    s_zone = zone;
+    now = DST_Today(hours);
+    s_active = DST_InSummer(&ZONES[zone], now, now);
+    DST_ScheduleNext(now);
+    DST_NewDay();
+    return true;
+}
+
+uint16_t DST_FromUTC(uint8_t zone, int16_t utc_minute) {
+    const DstZone *z;
+    int16_t minute;
+    uint8_t hour;
+
+    if (zone < DST_ZONE_COUNT) {
+        s_zone = zone;
+    }
+    z = &ZONES[s_zone];
+    minute = DST_RollDay((int16_t)(utc_minute + z->utc_offset));
+
+    /* The same instant on both rule clocks, so the hour either side of a
+     * change is decided correctly. */
+    hour = (uint8_t)(minute / 60);
+    s_active = DST_InSummer(z, DST_Today(BCD_FromBin(hour)),
+                            DST_Today(BCD_FromBin((uint8_t)(hour + 1u))));
+    if (s_active) {
+        minute = DST_RollDay((int16_t)(minute + z->shift));
+    }
+    DST_ScheduleNext(DST_Today(BCD_FromBin((uint8_t)(minute / 60))));
+    DST_NewDay();
+    return (uint16_t)minute;
+}
+
+bool DST_Restore(uint8_t zone, uint8_t hours, bool active) {
+    if (zone >= DST_ZONE_COUNT) {
+        return false;
+    }
+    s_zone = zone;
+    s_active = active && ZONES[zone].start.month != 0;
+    DST_ScheduleNext(DST_Today(hours));
+    DST_NewDay();
+    return true;
+}
+
+void DST_NewDay(void) {
+    if (Calendar_GetMonth() == s_next_month && Calendar_GetDay() == s_next_day) {
+        s_switch_hour = s_next_hour;
+    } else {
+        s_switch_hour = DST_NO_SWITCH;
+    }
+}
+
+uint8_t DST_SwitchHour(void) {
+    return s_switch_hour;
+}
+
+int8_t DST_Apply(void) {
+    int8_t minutes = (int8_t)ZONES[s_zone].shift;
+
+    if (s_active) {
+        minutes = (int8_t)-minutes;
+    }
+    s_active = !s_active;
+    DST_ScheduleNext(DST_Today(s_switch_hour));
+    s_switch_hour = DST_NO_SWITCH;   /* at most one change per day */
+    return minutes;
+}
+
+bool DST_IsActive(void) {
+    return s_active;
+}
+
+int16_t DST_UtcOffset(void) {
+    const DstZone *z = &ZONES[s_zone];
+
+    return (int16_t)(z->utc_offset + (s_active ? z->shift : 0));
+}
+
+uint8_t DST_GetZone(void) {
+    return s_zone;
+}
+
+const char *DST_ZoneName(void) {
+    return s_active ? ZONES[s_zone].dst_name : ZONES[s_zone].std_name;
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * File:   DST.h
+ * Purpose: Table-driven daylight-saving rules for several jurisdictions.
+ *          The next transition date is worked out once, at start-up and
+ *          after each change, so the clock only has to compare the hour.
+ ******************************************************************************/
+
+#ifndef DST_H
+#define DST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Rule sets in the DST.c zone table; pick one per device with DST_ZONE. */
+#define DST_ZONE_NONE       0   /* no summer time (UTC) */
+#define DST_ZONE_UK         1   /* GMT/BST */
+#define DST_ZONE_EU         2   /* CET/CEST */
+#define DST_ZONE_US         3   /* US Eastern EST/EDT */
+#define DST_ZONE_AU         4   /* Australian Eastern AEST/AEDT */
+#define DST_ZONE_COUNT      5
+
+#define DST_NO_SWITCH       0xFF
+
+/**
+ * Select a zone and decide from the calendar date and the (packed BCD)
+ * hour whether summer time is in force, then find the next transition.
+ * Call after Calendar_Init. Returns false (zone unchanged) if out of range.
+ */
+bool DST_Init(uint8_t zone, uint8_t hours);
+
+/**
+ * As DST_Init, but with the summer-time state known (warm restart), so the
+ * repeated hour after falling back is not mistaken for summer time.
+ */
+bool DST_Restore(uint8_t zone, uint8_t hours, bool active);
+
+/**
+ * Convert a time source's UTC to local wall-clock time in a zone (out of
+ * range keeps the current one). The calendar must hold the UTC date; it is
+ * moved across midnight as needed. Decides summer time and arms the next
+ * change as DST_Init does. utc_minute may be -1439..1439 around that date.
+ * Returns the local minute of the day (0-1439).
+ */
+uint16_t DST_FromUTC(uint8_t zone, int16_t utc_minute);
+
+/** Call once after each Calendar_AdvanceDay: arms today's switch hour. */
+void DST_NewDay(void);
+
+/** Packed BCD hour at which the clock changes today, or DST_NO_SWITCH. */
+uint8_t DST_SwitchHour(void);
+
+/**
+ * Make the change due at the switch hour and schedule the next one.
+ * Returns the minutes to add to the wall clock (negative when falling back).
+ */
+int8_t DST_Apply(void);
+
+bool DST_IsActive(void);
+
+/** Local time in force minus UTC, minutes (standard offset plus any shift). */
+int16_t DST_UtcOffset(void);
+uint8_t DST_GetZone(void);
+
+/** Abbreviation of the time currently in force, at most 4 characters. */
+const char *DST_ZoneName(void);
+
+#endif /* DST_H */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * File:   Dimmer.c
+ * Purpose: PI illuminance loop (see Dimmer.h). Works in linear lux, where
+ *          the lamp adds a fixed amount per level, so one pair of gains
+ *          holds from dusk to full night. The integrator is the output in
+ *          8.8 fixed point, clamped to 0..ceiling; a step whose output
+ *          saturates or is rate limited does not integrate further in the
+ *          same direction (anti-windup). Output steps are limited to
+ *          DIM_RATE_STEP so a passing shadow or headlight only nudges the
+ *          lamp, and so the Light.c ramp always keeps up.
+ ******************************************************************************/
+
+#include "Dimmer.h"
+#include "Config.h"
+#include "ADC.h"
+#include "Light.h"
+#include "Lux.h"
+
+#define DIM_ERROR_LIMIT     2000    // lux: keeps Kp * e within 16 bits
+
+static uint16_t s_setpoint = DIM_SETPOINT_LUX;
+static uint16_t s_measured = 0;
+static uint8_t  s_ceiling = LIGHT_LEVEL_OFF;
+static int32_t  s_integral = 0;         // Q8 level
+static uint8_t  s_output = LIGHT_LEVEL_OFF;
+static uint16_t s_last_scan = 0;
+
+void Dimmer_Init(void) {
+    s_setpoint = DIM_SETPOINT_LUX;
+    s_ceiling = LIGHT_LEVEL_OFF;
+    s_integral = 0;
+    s_output = LIGHT_LEVEL_OFF;
+    s_last_scan = ADC_GetScanCount();
+}
+
+void Dimmer_SetCeiling(uint8_t level) {
+    s_ceiling = level;
+}
+
+void Dimmer_SetSetpoint(uint16_t lux) {
+    if (lux != 0u) {
+        s_setpoint = lux;
+    }
+}
+
+uint16_t Dimmer_GetSetpoint(void) {
+    return s_setpoint;
+}
+
+uint16_t Dimmer_GetMeasured(void) {
+    return s_measured;
+}
+
+void Dimmer_Task(void) {
+    uint16_t scan = ADC_GetScanCount();
+    int16_t error, target;
+    int32_t integral, e;
+
+    if (scan == s_last_scan) {
+        return;
+    }
+    s_last_scan = scan;
+
+    s_measured = Lux_ToLux(Lux_FromAdcOriented(ADC_GetLatest(ADC_CH_DIM), DIM_SENSOR_DARK_ABOVE));
+    if (s_ceiling == LIGHT_LEVEL_OFF) {
+        /* Daytime: start each night from off, ramping up at the rate limit. */
+        s_integral = 0;
+        s_output = LIGHT_LEVEL_OFF;
+        Light_SetLevel(LIGHT_LEVEL_OFF);
+        return;
+    }
+
+    e = (int32_t)s_setpoint - s_measured;
+    if (e > DIM_ERROR_LIMIT) {
+        e = DIM_ERROR_LIMIT;
+    } else if (e < -DIM_ERROR_LIMIT) {
+        e = -DIM_ERROR_LIMIT;
+    }
+    error = (int16_t)e;
+
+    integral = s_integral + (int32_t)error * DIM_KI_Q8;
+    if (integral < 0) {
+        integral = 0;
+    } else if (integral > ((int32_t)s_ceiling << 8)) {
+        integral = (int32_t)s_ceiling << 8;
+    }
+    target = (int16_t)((integral + (int32_t)error * DIM_KP_Q8) >> 8);
+
+    /* Limits: output range, then rate. */
+    if (target < (int16_t)LIGHT_LEVEL_OFF) {
+        target = LIGHT_LEVEL_OFF;
+    } else if (target > (int16_t)s_ceiling) {
+        target = s_ceiling;
+    }
+    if (target > (int16_t)s_output + DIM_RATE_STEP) {
+        target = (int16_t)s_output + DIM_RATE_STEP;
+        if (error > 0) {
+            integral = s_integral;      // already climbing as fast as allowed
+        }
+    } else if (target < (int16_t)s_output - DIM_RATE_STEP) {
+        target = (int16_t)s_output - DIM_RATE_STEP;
+        if (error < 0) {
+            integral = s_integral;
+        }
+    }
+    if (integral > ((int32_t)s_ceiling << 8)) {
+        integral = (int32_t)s_ceiling << 8;     // ceiling lowered (save window)
+    }
+    s_integral = integral;
+    s_output = (uint8_t)target;
+    Light_SetLevel(s_output);           // ramps in the Timer4 ISR
+}
@@ -0,0 +1,36 @@
+/*******************************************************************************
+ * File:   Dimmer.h
+ * Purpose: Constant-illuminance dimming. A fixed-point PI loop sets the main
+ *          light level so that the total light on the dimming sensor (its
+ *          own LDR on RA1, facing the lit area: daylight plus lamp) meets
+ *          a setpoint in lux.
+ *          The schedule's level (off / dim / full) is the ceiling, so at
+ *          dusk the lamp only makes up what daylight no longer gives.
+ ******************************************************************************/
+
+#ifndef DIMMER_H
+#define DIMMER_H
+
+#include <stdint.h>
+
+/** Default setpoint, ceiling off. Before ADC_StartScan. */
+void Dimmer_Init(void);
+
+/** Highest level the loop may use (0 = off, resets the loop). */
+void Dimmer_SetCeiling(uint8_t level);
+
+/** Target illuminance, lux (> 0). */
+void Dimmer_SetSetpoint(uint16_t lux);
+uint16_t Dimmer_GetSetpoint(void);
+
+/** Last measured total illuminance, lux. */
+uint16_t Dimmer_GetMeasured(void);
+
+/**
+ * Main loop: one control step per completed ADC scan round, so the loop
+ * runs at the Timer6 scan rate (1000 / ADC_SCAN_PERIOD_MS Hz) with a
+ * fixed sample interval. Bounded: no loops, two 16 x 16 multiplies.
+ */
+void Dimmer_Task(void);
+
+#endif /* DIMMER_H */
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * File:   Discipline.c
+ * Purpose: 1PPS frequency-locked loop (see Discipline.h). Each edge gives
+ *          the reference second's offset from the nearest tick, in Timer0
+ *          counts. Over a window of W seconds the offset drifts by W times
+ *          the tick length error, so one count of drift resolves 16/W ppm.
+ *          Half the measured error is trimmed out per window; the window
+ *          starts at 4 s to pull in a raw crystal quickly and doubles to
+ *          64 s as the drift falls. An edge that jumps from the last one is
+ *          noise (or a missing second) and restarts the measurement.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Discipline.h"
+#include "Config.h"
+#include "Timer.h"
+#include "NVM.h"
+#include "CRC.h"
+
+#define DISC_WINDOW_MIN     4u      // seconds
+#define DISC_WINDOW_MAX     64u
+#define DISC_PHASE_LIMIT    63      // counts (~1 ms) before a phase step
+#define DISC_JUMP_LIMIT     16      // counts between edges: 200 ppm + jitter
+#define DISC_SETTLED_DRIFT  2       // counts per window to lengthen it
+#define DISC_TRIM_LIMIT     3200    // 1/256 counts = 200 ppm
+#define DISC_SAVE_DELTA     16      // 1 ppm
+#define DISC_LOST_TICKS     3u      // no edge for this long: holdover
+
+#define DISC_PPS_RB4        0x0C
+#define DISC_SAVE_BYTES     4u      // trim low, high, then its CRC low, high
+
+static uint8_t  s_state = DISC_NO_REFERENCE;
+static bool     s_have_prev = false;
+static int16_t  s_prev_phase;
+static uint32_t s_last_edge;
+static uint32_t s_window_start;
+static int16_t  s_start_phase;
+static uint8_t  s_window = DISC_WINDOW_MIN;
+
+static int16_t  s_saved_trim = 0;
+static uint8_t  s_save_buf[DISC_SAVE_BYTES];
+static uint8_t  s_save_next = DISC_SAVE_BYTES;     // idle
+
+static int16_t Disc_Abs(int16_t v) {
+    return (v < 0) ? (int16_t)-v : v;
+}
+
+void Discipline_Init(void) {
+    uint8_t rec[DISC_SAVE_BYTES];
+
+    for (uint8_t i = 0; i < DISC_SAVE_BYTES; i++) {
+        rec[i] = NVM_EERead(DISC_EE_ADDRESS + i);
+    }
+    /* Torn or never-written copy: the CRC does not match. */
+    if (CRC_Block(rec, 2) == (uint16_t)(((uint16_t)rec[3] << 8) | rec[2])) {
+        int16_t trim = (int16_t)(((uint16_t)rec[1] << 8) | rec[0]);
+        if (Disc_Abs(trim) <= DISC_TRIM_LIMIT) {
+            Timer_SetTrim(trim);
+            s_saved_trim = trim;
+            s_state = DISC_HOLDOVER;
+        }
+    }
+
+    INT1PPS = DISC_PPS_RB4;
+    TRISBbits.TRISB4 = 1;
+    ANSELBbits.ANSELB4 = 0;
+    INTCONbits.INT1EDG = 1;
+    IPR0bits.INT1IP = 1;        // snapshot beside the tick, fixed latency
+    PIR0bits.INT1IF = 0;
+    PIE0bits.INT1IE = 1;
+}
+
+/* One EEPROM byte per call, only when the previous write has finished. */
+static void Discipline_SaveStep(void) {
+    if (s_save_next < DISC_SAVE_BYTES && !NVM_EEBusy()) {
+        NVM_EEWrite(DISC_EE_ADDRESS + s_save_next, s_save_buf[s_save_next]);
+        s_save_next++;
+    }
+}
+
+static void Discipline_Save(int16_t trim) {
+    uint16_t crc;
+
+    s_save_buf[0] = (uint8_t)trim;
+    s_save_buf[1] = (uint8_t)((uint16_t)trim >> 8);
+    crc = CRC_Block(s_save_buf, 2);
+    s_save_buf[2] = (uint8_t)crc;
+    s_save_buf[3] = (uint8_t)(crc >> 8);
+    s_save_next = 0;
+    s_saved_trim = trim;
+}
+
+static void Discipline_Restart(uint32_t tick, int16_t phase) {
+    s_have_prev = true;
+    s_prev_phase = phase;
+    s_window_start = tick;
+    s_start_phase = phase;
+}
+
+void Discipline_Task(uint32_t now) {
+    int16_t phase, drift, trim;
+    uint32_t tick, elapsed;
+
+    Discipline_SaveStep();
+
+    if (!Timer_GetPps(&phase, &tick)) {
+        if (s_have_prev && (now - s_last_edge) > DISC_LOST_TICKS) {
+            s_have_prev = false;
+            s_window = DISC_WINDOW_MIN;
+            s_state = (Timer_GetTrim() != 0) ? DISC_HOLDOVER : DISC_NO_REFERENCE;
+        }
+        return;
+    }
+    s_last_edge = now;
+
+    if (!s_have_prev || Disc_Abs((int16_t)(phase - s_prev_phase)) > DISC_JUMP_LIMIT) {
+        Discipline_Restart(tick, phase);
+        return;
+    }
+    s_prev_phase = phase;
+    if (s_state < DISC_TRACKING) {
+        s_state = DISC_TRACKING;
+    }
+
+    if (Disc_Abs(phase) > DISC_PHASE_LIMIT) {
+        /* Line the tick up with the reference; measure again from the
+         * first edge after the step. A long window would drift past the
+         * limit again before it ends, so pull in from the shortest. */
+        Timer_StepPhase(phase);
+        s_have_prev = false;
+        s_window = DISC_WINDOW_MIN;
+        s_state = DISC_TRACKING;
+        return;
+    }
+
+    elapsed = tick - s_window_start;
+    if (elapsed < s_window) {
+        return;
+    }
+    drift = (int16_t)(phase - s_start_phase);
+
+    /* Positive drift: ticks arriving early, so lengthen them. Half the
+     * error per window, in 1/256 counts per tick. */
+    trim = (int16_t)(Timer_GetTrim() + (int16_t)(((int32_t)drift * 128) / (int32_t)elapsed));
+    if (trim > DISC_TRIM_LIMIT) {
+        trim = DISC_TRIM_LIMIT;
+    } else if (trim < -DISC_TRIM_LIMIT) {
+        trim = -DISC_TRIM_LIMIT;
+    }
+    Timer_SetTrim(trim);
+
+    if (Disc_Abs(drift) <= DISC_SETTLED_DRIFT) {
+        if (s_window < DISC_WINDOW_MAX) {
+            s_window <<= 1;
+        } else {
+            s_state = DISC_LOCKED;
+            if (Disc_Abs((int16_t)(trim - s_saved_trim)) >= DISC_SAVE_DELTA) {
+                Discipline_Save(trim);
+            }
+        }
+    } else {
+        s_state = DISC_TRACKING;
+    }
+    s_window_start = tick;
+    s_start_phase = phase;
+}
+
+uint8_t Discipline_GetState(void) {
+    return s_state;
+}
+
+int16_t Discipline_GetTrim_dppm(void) {
+    /* 1/256 count = 0.0625 ppm = 0.625 x 0.1 ppm */
+    return (int16_t)(((int32_t)Timer_GetTrim() * 5) / 8);
+}
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * File:   Discipline.h
+ * Purpose: Frequency-locked timebase. A 1PPS reference (the GPS module's,
+ *          or any other) on RB4 is timed against the Timer0 tick; the
+ *          phase drift over a measurement window gives the crystal's
+ *          frequency error, which is trimmed out in 1/256-count steps
+ *          (Timer_SetTrim). The phase is stepped once to line the tick up
+ *          with the reference second. The learned trim is kept in data
+ *          EEPROM, so the clock holds its accuracy when the reference goes
+ *          away or the controller is power-cycled.
+ ******************************************************************************/
+
+#ifndef DISCIPLINE_H
+#define DISCIPLINE_H
+
+#include <stdint.h>
+
+/* Discipline_GetState */
+#define DISC_NO_REFERENCE   0   /* no edges, nominal period */
+#define DISC_HOLDOVER       1   /* no edges, learned trim in use */
+#define DISC_TRACKING       2   /* edges arriving, trim being adjusted */
+#define DISC_LOCKED         3   /* residual under ~0.5 ppm over 64 s */
+
+/** Load the saved trim and enable INT1 (1PPS, rising edge, high priority). */
+void Discipline_Init(void);
+
+/**
+ * Main-loop step: takes the latest 1PPS snapshot, adjusts phase and trim,
+ * and writes a changed trim to EEPROM a byte at a time (never waits).
+ */
+void Discipline_Task(uint32_t now);
+
+uint8_t Discipline_GetState(void);
+
+/** Current frequency correction in 0.1 ppm, positive = clock slowed. */
+int16_t Discipline_GetTrim_dppm(void);
+
+#endif /* DISCIPLINE_H */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * File:   FlashCheck.c
+ * Purpose: Program flash check (see FlashCheck.h). The log and journal
+ *          rows above LOG_FLASH_START change at run time and are left out;
+ *          the stored CRC covers 0 up to FLASH_CHECK_CRC_ADDRESS. A pass is
+ *          32 chunks of 1 KB, each done in the spare cycles of one loop
+ *          pass, so a full check takes well under a second of loop passes
+ *          and repeats every minute.
+ ******************************************************************************/
+
+#include "FlashCheck.h"
+#include "Config.h"
+#include "CRC.h"
+#include "NVM.h"
+#include "Journal.h"
+
+#define FLASH_CHECK_LAST    (FLASH_CHECK_CRC_ADDRESS - 1u)
+#define FLASH_CHECK_IDLE    0xFFFFFFFFUL    // s_next: no pass running
+
+static uint8_t  s_state = FLASH_CHECK_PENDING;
+static uint32_t s_next = 0;         // next chunk; FLASH_CHECK_IDLE between passes
+static bool     s_chunk = false;    // a chunk has been started
+static uint16_t s_crc = CRC_SEED;
+static uint32_t s_pass_start = 0;   // tick
+
+void FlashCheck_Init(void) {
+    s_state = FLASH_CHECK_PENDING;
+    s_next = 0;
+    s_chunk = false;
+    s_crc = CRC_SEED;
+}
+
+static void FlashCheck_Compare(void) {
+    uint16_t stored = (uint16_t)NVM_FlashReadByte(FLASH_CHECK_CRC_ADDRESS) |
+                      ((uint16_t)NVM_FlashReadByte(FLASH_CHECK_CRC_ADDRESS + 1u) << 8);
+    uint8_t state;
+
+    if (stored == 0xFFFFu) {
+        state = FLASH_CHECK_NO_CRC;         // erased: no checksum step in the build
+    } else if (stored == s_crc) {
+        state = FLASH_CHECK_GOOD;
+    } else {
+        state = FLASH_CHECK_BAD;
+    }
+    if (state == FLASH_CHECK_BAD && s_state != FLASH_CHECK_BAD) {
+        Journal_Write(JOURNAL_FLASH_CRC, s_crc);
+    }
+    s_state = state;
+}
+
+void FlashCheck_Task(uint32_t now) {
+    uint32_t last;
+
+    if (CRC_ScanBusy()) {
+        return;
+    }
+    if (s_chunk) {
+        s_crc = CRC_ScanResult();
+        s_chunk = false;
+    }
+    if (s_next > FLASH_CHECK_LAST) {
+        if (s_next != FLASH_CHECK_IDLE) {
+            FlashCheck_Compare();
+            s_next = FLASH_CHECK_IDLE;
+        }
+        if ((now - s_pass_start) < FLASH_CHECK_PERIOD) {
+            return;
+        }
+        s_next = 0;
+        s_crc = CRC_SEED;
+    }
+    if (s_next == 0) {
+        s_pass_start = now;
+    }
+
+    last = s_next + FLASH_CHECK_CHUNK - 1u;
+    if (last > FLASH_CHECK_LAST) {
+        last = FLASH_CHECK_LAST;
+    }
+    CRC_ScanStart(s_next, last, s_crc);
+    s_chunk = true;
+    s_next = last + 1u;
+}
+
+uint8_t FlashCheck_GetState(void) {
+    return s_state;
+}
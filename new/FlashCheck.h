@@ -0,0 +1,30 @@
+/*******************************************************************************
+ * File:   FlashCheck.h
+ * Purpose: Background program-flash integrity check. The code area is
+ *          CRC'd by the scanner (CRC.c) a chunk per main-loop pass and the
+ *          result compared with the CRC the build stores at the top of it
+ *          (Config.h), once every FLASH_CHECK_PERIOD ticks. A mismatch is
+ *          journalled and reported over Modbus before corrupted code gets
+ *          the chance to switch the lamp wrongly.
+ ******************************************************************************/
+
+#ifndef FLASHCHECK_H
+#define FLASHCHECK_H
+
+#include <stdint.h>
+
+#define FLASH_CHECK_PENDING     0   /* no pass finished yet */
+#define FLASH_CHECK_GOOD        1
+#define FLASH_CHECK_BAD         2   /* CRC mismatch: flash corrupted */
+#define FLASH_CHECK_NO_CRC      3   /* image built without the stored CRC */
+
+/** First pass starts on the first Task call. */
+void FlashCheck_Init(void);
+
+/** Main loop: collect a finished chunk and start the next one. */
+void FlashCheck_Task(uint32_t now);
+
+/** FLASH_CHECK_* result of the last complete pass. */
+uint8_t FlashCheck_GetState(void);
+
+#endif /* FLASHCHECK_H */
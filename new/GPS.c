@@ -0,0 +1,372 @@
+/*******************************************************************************
+ * File:   GPS.c
+ * Purpose: NMEA time/position receiver (see GPS.h). Each RX byte advances a
+ *          small state machine: the sentence type is matched from the
+ *          address field, digits are packed into BCD (integer part) and a
+ *          two-digit fraction as they arrive, and the field index decides
+ *          what a finished field means. Fields go into one of two fix
+ *          buffers; a good checksum flips them, so a corrupt sentence never
+ *          touches the last good fix. Unwanted sentence types are dropped
+ *          at the end of their address field.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "GPS.h"
+#include "Config.h"
+#include "BCD.h"
+
+#define GPS_IDLE            0xFF    // s_field: waiting for '$'
+
+#define GPS_OTHER           0
+#define GPS_RMC             1
+#define GPS_ZDA             2
+
+/* Fields seen in the sentence being parsed */
+#define GPS_HAVE_TIME       0x01
+#define GPS_HAVE_DAY        0x02
+#define GPS_HAVE_MONTH      0x04
+#define GPS_HAVE_YEAR       0x08
+#define GPS_HAVE_FIX        0x10    // RMC status 'A'
+#define GPS_HAVE_LAT        0x20
+#define GPS_HAVE_LON        0x40
+#define GPS_HAVE_DATETIME   (GPS_HAVE_TIME | GPS_HAVE_DAY | GPS_HAVE_MONTH | GPS_HAVE_YEAR)
+
+#define GPS_RX_RC7          0x17
+
+typedef struct {
+    GpsTime  time;
+    uint8_t  have;          /* GPS_HAVE_* */
+    uint8_t  lat_deg;
+    uint16_t lat_cmin;      /* hundredths of an arc minute */
+    uint8_t  lon_deg;
+    uint16_t lon_cmin;
+    bool     south;
+    bool     west;
+} GpsFix;
+
+static const char GPS_TYPE_NAMES[][4] = {"", "RMC", "ZDA"};
+
+/* Sentence state */
+static uint8_t  s_field = GPS_IDLE;
+static uint8_t  s_type;
+static uint8_t  s_sum;
+static uint8_t  s_star;             // 0 body, 1-2 checksum digits
+static uint8_t  s_check;
+
+/* Field state */
+static uint8_t  s_len;
+static uint32_t s_digits;           // integer part, packed BCD
+static uint8_t  s_int_len;
+static uint8_t  s_frac;             // first two fraction digits
+static uint8_t  s_frac_len;
+static bool     s_point;
+static uint8_t  s_letter;
+
+static GpsFix   s_fix[2];
+static uint8_t  s_work = 0;         // buffer being parsed into
+static uint8_t  s_ready = 1;        // last good fix
+static volatile bool s_fresh = false;
+
+static GpsFix   s_position;         // last fix that carried a position
+static bool     s_have_position = false;
+
+static uint16_t s_sentences = 0;
+static uint16_t s_errors = 0;
+
+void GPS_Init(void) {
+    // EUSART1 receive only, from RC7
+    RX1PPS = GPS_RX_RC7;
+    TRISCbits.TRISC7 = 1;
+    ANSELCbits.ANSELC7 = 0;
+
+    // 64 MHz / (4 * (1666 + 1)) = 9598 baud (-0.02 %)
+    BAUD1CONbits.BRG16 = 1;
+    TX1STAbits.BRGH = 1;
+    SP1BRGL = 0x82;
+    SP1BRGH = 0x06;
+    RC1STAbits.CREN = 1;
+    RC1STAbits.SPEN = 1;
+
+    IPR3bits.RC1IP = 0;
+    PIE3bits.RC1IE = 1;
+}
+
+static void GPS_StartField(void) {
+    s_len = 0;
+    s_digits = 0;
+    s_int_len = 0;
+    s_frac = 0;
+    s_frac_len = 0;
+    s_point = false;
+    s_letter = 0;
+}
+
+static void GPS_FieldChar(uint8_t c) {
+    if (s_field == 0) {
+        /* Address: two-letter talker (GP, GN, ...), then the type. */
+        if (s_len == 2) {
+            s_type = (c == 'R') ? GPS_RMC : ((c == 'Z') ? GPS_ZDA : GPS_OTHER);
+        } else if (s_len > 2 && s_type != GPS_OTHER &&
+                   (s_len > 4 || c != (uint8_t)GPS_TYPE_NAMES[s_type][s_len - 2u])) {
+            s_type = GPS_OTHER;
+        }
+    } else if (c >= '0' && c <= '9') {
+        if (s_point) {
+            if (s_frac_len < 2u) {
+                s_frac = (uint8_t)(s_frac * 10u + (c - '0'));
+                s_frac_len++;
+            }
+        } else if (s_int_len < 8u) {
+            s_digits = (s_digits << 4) | (uint8_t)(c - '0');
+            s_int_len++;
+        }
+    } else if (c == '.') {
+        s_point = true;
+    } else {
+        s_letter = c;
+    }
+}
+
+/* Hundredths of a minute from the fraction digits seen. */
+static uint16_t GPS_Centiminutes(uint8_t minutes_bcd) {
+    uint8_t frac = (s_frac_len == 1u) ? (uint8_t)(s_frac * 10u) : s_frac;
+    return (uint16_t)BCD_ToBin(minutes_bcd) * 100u + frac;
+}
+
+static void GPS_EndField(void) {
+    GpsFix *f = &s_fix[s_work];
+    uint8_t lo = (uint8_t)s_digits;
+    uint8_t mid = (uint8_t)(s_digits >> 8);
+    uint8_t hi = (uint8_t)(s_digits >> 16);
+
+    if (s_field == 0) {
+        if (s_type == GPS_OTHER || s_len != 5u) {
+            s_field = GPS_IDLE;     // not a sentence we use
+        }
+        return;
+    }
+    if (s_field == 1) {
+        if (s_int_len == 6u) {      // hhmmss(.ss)
+            f->time.hours = hi;
+            f->time.minutes = mid;
+            f->time.seconds = lo;
+            f->have |= GPS_HAVE_TIME;
+        }
+        return;
+    }
+    if (s_type == GPS_RMC) {
+        switch (s_field) {
+        case 2:
+            if (s_letter == 'A') {
+                f->have |= GPS_HAVE_FIX;
+            }
+            break;
+        case 3:                     // ddmm.mmmm
+            if (s_int_len == 4u) {
+                f->lat_deg = BCD_ToBin(mid);
+                f->lat_cmin = GPS_Centiminutes(lo);
+                f->have |= GPS_HAVE_LAT;
+            }
+            break;
+        case 4:
+            f->south = (s_letter == 'S');
+            break;
+        case 5:                     // dddmm.mmmm
+            if (s_int_len == 5u) {
+                f->lon_deg = (uint8_t)((hi & 0x0Fu) * 100u + BCD_ToBin(mid));
+                f->lon_cmin = GPS_Centiminutes(lo);
+                f->have |= GPS_HAVE_LON;
+            }
+            break;
+        case 6:
+            f->west = (s_letter == 'W');
+            break;
+        case 9:                     // ddmmyy
+            if (s_int_len == 6u) {
+                f->time.day = hi;
+                f->time.month = mid;
+                f->time.year = lo;
+                f->have |= GPS_HAVE_DAY | GPS_HAVE_MONTH | GPS_HAVE_YEAR;
+            }
+            break;
+        default:
+            break;
+        }
+    } else {
+        /* ZDA: day, month, four-digit year */
+        if (s_field == 2 && s_int_len == 2u) {
+            f->time.day = lo;
+            f->have |= GPS_HAVE_DAY;
+        } else if (s_field == 3 && s_int_len == 2u) {
+            f->time.month = lo;
+            f->have |= GPS_HAVE_MONTH;
+        } else if (s_field == 4 && s_int_len == 4u) {
+            f->time.year = lo;
+            f->have |= GPS_HAVE_YEAR;
+        }
+    }
+}
+
+/* Checksum matched: publish if the sentence carried a usable time. */
+static void GPS_EndSentence(void) {
+    GpsFix *f = &s_fix[s_work];
+    GpsTime *t = &f->time;
+
+    if ((f->have & GPS_HAVE_DATETIME) != GPS_HAVE_DATETIME ||
+        (s_type == GPS_RMC && !(f->have & GPS_HAVE_FIX)) ||
+        t->hours > 0x23u || t->minutes > 0x59u || t->seconds > 0x60u ||
+        t->day == 0 || t->day > 0x31u || t->month == 0 || t->month > 0x12u) {
+        return;
+    }
+    if (t->seconds == 0x60u) {
+        t->seconds = 0x59;          // leap second: hold 59
+    }
+    if ((f->have & (GPS_HAVE_LAT | GPS_HAVE_LON)) == (GPS_HAVE_LAT | GPS_HAVE_LON)) {
+        s_position = *f;
+        s_have_position = true;
+    }
+    s_ready = s_work;
+    s_work ^= 1u;
+    s_fresh = true;
+    s_sentences++;
+}
+
+static uint8_t GPS_HexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') {
+        return (uint8_t)(c - '0');
+    }
+    if (c >= 'A' && c <= 'F') {
+        return (uint8_t)(c - 'A' + 10u);
+    }
+    return 0xFF;
+}
+
+static void GPS_Byte(uint8_t c) {
+    if (c == '$') {
+        s_field = 0;
+        s_type = GPS_OTHER;
+        s_sum = 0;
+        s_star = 0;
+        s_check = 0;
+        s_fix[s_work].have = 0;
+        GPS_StartField();
+        return;
+    }
+    if (s_field == GPS_IDLE) {
+        return;
+    }
+    if (s_star != 0) {
+        uint8_t v = GPS_HexValue(c);
+        if (v > 15u) {
+            s_errors++;
+            s_field = GPS_IDLE;
+            return;
+        }
+        s_check = (uint8_t)((s_check << 4) | v);
+        if (++s_star > 2u) {
+            if (s_check == s_sum) {
+                GPS_EndSentence();
+            } else {
+                s_errors++;
+            }
+            s_field = GPS_IDLE;
+        }
+        return;
+    }
+    if (c == '*') {
+        GPS_EndField();
+        if (s_field != GPS_IDLE) {
+            s_star = 1;
+        }
+        return;
+    }
+    if (c < ' ' || c > '~') {
+        s_errors++;                 // line ended without a checksum
+        s_field = GPS_IDLE;
+        return;
+    }
+    s_sum ^= c;
+    if (c == ',') {
+        GPS_EndField();
+        if (s_field != GPS_IDLE) {
+            s_field++;
+            GPS_StartField();
+        }
+        return;
+    }
+    GPS_FieldChar(c);
+    s_len++;
+}
+
+void GPS_Isr(void) {
+    if (PIE3bits.RC1IE && PIR3bits.RC1IF) {
+        uint8_t framing = RC1STAbits.FERR;
+        uint8_t c = RC1REG;
+
+        if (RC1STAbits.OERR) {
+            RC1STAbits.CREN = 0;    // Clear overrun by restarting the receiver
+            RC1STAbits.CREN = 1;
+            framing = 1;
+        }
+        if (framing) {
+            if (s_field != GPS_IDLE) {
+                s_errors++;
+            }
+            s_field = GPS_IDLE;
+        } else {
+            GPS_Byte(c);
+        }
+    }
+}
+
+bool GPS_GetTime(GpsTime *time) {
+    if (!s_fresh) {
+        return false;
+    }
+    uint8_t giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    *time = s_fix[s_ready].time;
+    s_fresh = false;
+    INTCONbits.GIEL = giel_save;
+    return true;
+}
+
+bool GPS_GetPosition(int16_t *latitude, int16_t *longitude) {
+    GpsFix p;
+    bool have;
+    int16_t lat, lon;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    p = s_position;
+    have = s_have_position;
+    INTCONbits.GIEL = giel_save;
+    if (!have) {
+        return false;
+    }
+    lat = (int16_t)((uint16_t)p.lat_deg * 100u + p.lat_cmin / 60u);
+    lon = (int16_t)((uint16_t)p.lon_deg * 100u + p.lon_cmin / 60u);
+    *latitude = p.south ? (int16_t)-lat : lat;
+    *longitude = p.west ? (int16_t)-lon : lon;
+    return true;
+}
+
+uint16_t GPS_GetSentences(void) {
+    uint16_t n;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    n = s_sentences;
+    INTCONbits.GIEL = giel_save;
+    return n;
+}
+
+uint16_t GPS_GetErrors(void) {
+    uint16_t n;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    n = s_errors;
+    INTCONbits.GIEL = giel_save;
+    return n;
+}
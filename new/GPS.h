@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * File:   GPS.h
+ * Purpose: GPS time and position from NMEA $--RMC / $--ZDA sentences on
+ *          EUSART1 (RX RC7, 9600 8N1), parsed a byte at a time in the RX
+ *          interrupt: fields are decoded as they arrive and the checksum is
+ *          run alongside, so no sentence is ever buffered. The module's 1PPS
+ *          output goes to the timebase discipline (Discipline.c).
+ ******************************************************************************/
+
+#ifndef GPS_H
+#define GPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* UTC of the last 1PPS edge, from a sentence with a good checksum. */
+typedef struct {
+    uint8_t year;       /* packed BCD 0x00-0x99 (20xx) */
+    uint8_t month;      /* packed BCD */
+    uint8_t day;        /* packed BCD */
+    uint8_t hours;      /* packed BCD */
+    uint8_t minutes;    /* packed BCD */
+    uint8_t seconds;    /* packed BCD */
+} GpsTime;
+
+/** EUSART1 receiver, low priority. */
+void GPS_Init(void);
+
+/** True (and the time) when a new valid fix arrived since the last call. */
+bool GPS_GetTime(GpsTime *time);
+
+/**
+ * Last reported position in hundredths of a degree, north and east
+ * positive. False until an RMC sentence with a fix has been received.
+ */
+bool GPS_GetPosition(int16_t *latitude, int16_t *longitude);
+
+/** Sentences accepted, and those dropped on a checksum or framing error. */
+uint16_t GPS_GetSentences(void);
+uint16_t GPS_GetErrors(void);
+
+/** Low-priority ISR hook: RC1IF (NMEA byte). */
+void GPS_Isr(void);
+
+#endif /* GPS_H */
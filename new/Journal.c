@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * File:   Journal.c
+ * Purpose: RAM event journal (see Journal.h). The ring is laid out exactly
+ *          as its flash image, so the brown-out flush is two row writes
+ *          straight from RAM into rows erased in advance (~4 ms, no erase).
+ ******************************************************************************/
+
+#include <xc.h>
+#include <string.h>
+#include "Journal.h"
+#include "NVM.h"
+#include "UART.h"
+#include "Config.h"
+
+#define JOURNAL_MAGIC       0x4A
+#define JOURNAL_ROWS        2u
+#define JOURNAL_HLVD_WAIT   100u    /* x 10 us for HLVD to settle; typically ~50 us */
+
+typedef struct {
+    uint8_t  magic;
+    uint8_t  next;          /* slot the next record goes to */
+    uint8_t  count;         /* records held, up to JOURNAL_RECORDS */
+    uint8_t  flushes;       /* brown-out flushes since the image was cleared */
+    JournalRecord rec[JOURNAL_RECORDS];
+} JournalImage;
+
+typedef char journal_image_is_two_rows[
+    (sizeof(JournalImage) == JOURNAL_ROWS * NVM_FLASH_ROW_SIZE) ? 1 : -1];
+
+static JournalImage s_image;
+static uint16_t s_total = 0;            /* records ever written (wraps) */
+static uint32_t s_minute = 0;
+static volatile bool s_flushed = false;
+static uint32_t s_last_tick = 0;
+
+/* Brown-out interrupt on, once HLVD has settled (else Journal_Task retries). */
+static void Journal_Arm(void) {
+    if (HLVDCON0bits.RDY) {
+        IPR2bits.HLVDIP = 0;
+        PIR2bits.HLVDIF = 0;
+        PIE2bits.HLVDIE = 1;
+    }
+}
+
+static bool Journal_FlashErased(void) {
+    return NVM_FlashReadByte(JOURNAL_FLASH_START) == 0xFF &&
+           NVM_FlashReadByte(JOURNAL_FLASH_START + NVM_FLASH_ROW_SIZE) == 0xFF;
+}
+
+static void Journal_EraseFlash(void) {
+    for (uint8_t row = 0; row < JOURNAL_ROWS; row++) {
+        NVM_FlashEraseRow(JOURNAL_FLASH_START + (uint32_t)row * NVM_FLASH_ROW_SIZE);
+    }
+}
+
+void Journal_Init(void) {
+    uint8_t *image = (uint8_t *)&s_image;
+
+    for (uint8_t row = 0; row < JOURNAL_ROWS; row++) {
+        NVM_FlashRead(JOURNAL_FLASH_START + (uint32_t)row * NVM_FLASH_ROW_SIZE,
+                      image + row * NVM_FLASH_ROW_SIZE, NVM_FLASH_ROW_SIZE);
+    }
+    if (s_image.magic != JOURNAL_MAGIC || s_image.next >= JOURNAL_RECORDS ||
+        s_image.count > JOURNAL_RECORDS) {
+        memset(&s_image, 0, sizeof(s_image));
+        s_image.magic = JOURNAL_MAGIC;
+    }
+    s_total = s_image.count;
+    if (!Journal_FlashErased()) {
+        Journal_EraseFlash();
+    }
+
+    Journal_Write(JOURNAL_BOOT, PCON0);
+    PCON0 = 0x3F;               // Re-arm the active-low reset flags
+
+    // HLVD: interrupt when VDD falls through JOURNAL_HLVD_SEL
+    HLVDCON1bits.SEL = JOURNAL_HLVD_SEL;
+    HLVDCON0bits.INTL = 1;
+    HLVDCON0bits.INTH = 0;
+    HLVDCON0bits.EN = 1;
+    for (uint8_t i = 0; i < JOURNAL_HLVD_WAIT && !HLVDCON0bits.RDY; i++) {
+        __delay_us(10);
+    }
+    Journal_Arm();
+}
+
+void Journal_SetMinute(uint32_t minute) {
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    s_minute = minute;
+    INTCONbits.GIE = gie_save;
+}
+
+void Journal_Write(uint8_t type, uint16_t payload) {
+    uint8_t gie_save = INTCONbits.GIE;
+    JournalRecord *r;
+
+    INTCONbits.GIE = 0;
+    r = &s_image.rec[s_image.next];
+    r->type = type;
+    r->minute[0] = (uint8_t)s_minute;
+    r->minute[1] = (uint8_t)(s_minute >> 8);
+    r->minute[2] = (uint8_t)(s_minute >> 16);
+    r->payload = payload;
+    if (++s_image.next >= JOURNAL_RECORDS) {
+        s_image.next = 0;
+    }
+    if (s_image.count < JOURNAL_RECORDS) {
+        s_image.count++;
+    }
+    s_total++;
+    INTCONbits.GIE = gie_save;
+}
+
+void Journal_QueryBegin(JournalQuery *q, uint8_t types, uint32_t from, uint32_t to) {
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    q->seq = (uint16_t)(s_total - s_image.count);
+    INTCONbits.GIE = gie_save;
+    q->types = types;
+    q->from = from;
+    q->to = to;
+}
+
+bool Journal_QueryNext(JournalQuery *q, JournalEvent *ev) {
+    while (1) {
+        uint8_t gie_save = INTCONbits.GIE;
+        uint16_t back;
+        uint8_t slot;
+        JournalRecord r;
+
+        INTCONbits.GIE = 0;
+        back = (uint16_t)(s_total - q->seq);
+        if (back == 0) {
+            INTCONbits.GIE = gie_save;
+            return false;
+        }
+        if (back > s_image.count) {
+            /* Overwritten while we were iterating: skip to the oldest. */
+            back = s_image.count;
+            q->seq = (uint16_t)(s_total - back);
+        }
+        slot = (s_image.next >= back) ? (uint8_t)(s_image.next - back)
+                                      : (uint8_t)(s_image.next + JOURNAL_RECORDS - back);
+        r = s_image.rec[slot];
+        INTCONbits.GIE = gie_save;
+
+        q->seq++;
+        ev->type = r.type;
+        ev->minute = r.minute[0] | ((uint32_t)r.minute[1] << 8) | ((uint32_t)r.minute[2] << 16);
+        ev->payload = r.payload;
+        if (ev->type < 8 && (q->types & (1u << ev->type)) &&
+            ev->minute >= q->from && ev->minute <= q->to) {
+            return true;
+        }
+    }
+}
+
+void Journal_Dump(void) {
+    JournalQuery q;
+    JournalEvent ev;
+
+    UART_WriteString("journal flushes=");
+    UART_WriteUInt(s_image.flushes);
+    UART_WriteString("\r\n");
+    Journal_QueryBegin(&q, JOURNAL_ALL_TYPES, 0, 0xFFFFFFFFUL);
+    while (Journal_QueryNext(&q, &ev)) {
+        UART_WriteUInt(ev.minute);
+        UART_WriteByte(' ');
+        UART_WriteUInt(ev.type);
+        UART_WriteByte(' ');
+        UART_WriteUInt(ev.payload);
+        UART_WriteString("\r\n");
+    }
+}
+
+void Journal_Isr(void) {
+    if (PIE2bits.HLVDIE && PIR2bits.HLVDIF) {
+        const uint8_t *image = (const uint8_t *)&s_image;
+
+        PIR2bits.HLVDIF = 0;
+        PIE2bits.HLVDIE = 0;        // Once per brown-out; Journal_Task re-arms
+        /* Main-loop NVM calls hold GIEL off, so none is half done here. */
+        Journal_Write(JOURNAL_BROWNOUT, 0);
+        s_image.flushes++;
+        for (uint8_t row = 0; row < JOURNAL_ROWS; row++) {
+            NVM_FlashWriteRow(JOURNAL_FLASH_START + (uint32_t)row * NVM_FLASH_ROW_SIZE,
+                              image + row * NVM_FLASH_ROW_SIZE);
+        }
+        s_flushed = true;
+    }
+}
+
+void Journal_Task(uint32_t now) {
+    if (now == s_last_tick) {
+        return;
+    }
+    s_last_tick = now;
+    if (s_flushed && !HLVDCON0bits.OUT) {
+        /* Supply back above the trip point and no reset came. */
+        s_flushed = false;
+        Journal_EraseFlash();
+        Journal_Arm();
+    } else if (!s_flushed && !PIE2bits.HLVDIE) {
+        Journal_Arm();              /* HLVD was not ready at Journal_Init */
+    }
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * File:   Journal.h
+ * Purpose: RAM event journal: a ring of 6-byte records (type, epoch minute,
+ *          payload) that can be written in constant time from main-loop or
+ *          ISR context, queried by type and time range, and flushed to flash
+ *          when the HLVD detects the supply collapsing.
+ ******************************************************************************/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 4-byte header + 42 x 6-byte records = two flash rows */
+#define JOURNAL_RECORDS     42
+
+/* Event types (bit n of a query type mask selects type n). */
+#define JOURNAL_BOOT        0   /* payload = PCON0 reset flags */
+#define JOURNAL_CALIBRATION 1   /* payload = new threshold, centi-log10 lux */
+#define JOURNAL_LAMP        2   /* payload = main light level (0-255) */
+#define JOURNAL_DST         3   /* payload = 1 summer time started, 0 ended */
+#define JOURNAL_CONFIG      4   /* payload = Modbus register written */
+#define JOURNAL_BROWNOUT    5   /* payload = 0; written just before the flush */
+#define JOURNAL_CLOCK_SET   6   /* payload = time source (JOURNAL_SRC_*) */
+#define JOURNAL_FLASH_CRC   7   /* payload = program flash CRC that failed */
+
+#define JOURNAL_SRC_MSF     1
+#define JOURNAL_SRC_GPS     2
+#define JOURNAL_SRC_SYNC    3   /* bus time-sync master (TimeSync.c) */
+
+#define JOURNAL_ALL_TYPES   0xFF
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  minute[3];     /* epoch minute, 24-bit little-endian */
+    uint16_t payload;
+} JournalRecord;
+
+typedef struct {
+    uint8_t  type;
+    uint32_t minute;        /* minutes since 00:00 1 Jan CALENDAR_EPOCH_YEAR */
+    uint16_t payload;
+} JournalEvent;
+
+typedef struct {
+    uint16_t seq;           /* next record to visit */
+    uint8_t  types;         /* type mask */
+    uint32_t from;          /* minute range, inclusive */
+    uint32_t to;
+} JournalQuery;
+
+/**
+ * Reload the journal flushed before the last reset (so a dump covers it),
+ * re-erase the flush rows and arm the HLVD. Logs a JOURNAL_BOOT record.
+ */
+void Journal_Init(void);
+
+/** Time stamp for subsequent records; the main loop calls it each minute. */
+void Journal_SetMinute(uint32_t minute);
+
+/** Append a record; overwrites the oldest when full. ISR-safe. */
+void Journal_Write(uint8_t type, uint16_t payload);
+
+/** Start a query, oldest record first. */
+void Journal_QueryBegin(JournalQuery *q, uint8_t types, uint32_t from, uint32_t to);
+
+/** Next matching record. Returns false when there are no more. */
+bool Journal_QueryNext(JournalQuery *q, JournalEvent *ev);
+
+/** Print every record over the UART console. */
+void Journal_Dump(void);
+
+/** Low-priority ISR hook: HLVD (supply falling) writes the RAM image to flash. */
+void Journal_Isr(void);
+
+/**
+ * After a flush the supply may recover without a reset: once HLVD reports
+ * it good again, re-erase the rows (on a tick edge, like Logger_Task).
+ */
+void Journal_Task(uint32_t now);
+
+#endif /* JOURNAL_H */
@@ -4,20 +4,11 @@
 #include <xc.h>
 #include "LCD.h"
 #include "Config.h"
+#include "BCD.h"
+#include "PinMap.h"
 
 
-// PIN DEFINITIONS - Where the LCD is connected on the PIC
-
-
-// Control pins
-#define LCD_RS  LATCbits.LATC6    // Register Select: 0=command, 1=data
-#define LCD_E   LATCbits.LATC2    // Enable: pulse this to send data
-
-// Data pins (4-bit mode uses only D4-D7)
-#define LCD_D4  LATBbits.LATB3
-#define LCD_D5  LATBbits.LATB2
-#define LCD_D6  LATEbits.LATE3
-#define LCD_D7  LATEbits.LATE1
+// PIN DEFINITIONS - LCD_RS, LCD_E and LCD_DATA_PINS (D4-D7) live in PinMap.h
 
 static void LCD_Delay_ms(uint16_t milliseconds) {
     for (uint16_t i = 0; i < milliseconds; i++) {
@@ -26,11 +17,8 @@ static void LCD_Delay_ms(uint16_t milliseconds) {
 }
 
 static void LCD_Send4Bits(uint8_t data) {
-    // Put the 4 bits on the data pins
-    LCD_D4 = (data >> 0) & 1;  // Bit 0
-    LCD_D5 = (data >> 1) & 1;  // Bit 1
-    LCD_D6 = (data >> 2) & 1;  // Bit 2
-    LCD_D7 = (data >> 3) & 1;  // Bit 3
+    // Put the 4 bits on the data pins: one masked write each to LATB and LATE
+    PINMAP_WRITE(LCD_DATA_PINS, data);
     
     // Pulse the Enable pin to tell LCD to read the data
     LCD_E = 1;
@@ -75,47 +63,92 @@ static void LCD_SetCursor(uint8_t row, uint8_t col) {
     LCD_SendCommand(address);
 }
 
-void LCD_Init(void) {
-    // Force digital mode on LCD pins (PIC18 may default some to analog)
-    ANSELBbits.ANSELB2 = 0;  // RB2 (D5) digital
-    ANSELBbits.ANSELB3 = 0;  // RB3 (D4) digital
-    ANSELEbits.ANSELE1 = 0;  // RE1 (D7) digital
-    ANSELEbits.ANSELE3 = 0;  // RE3 (D6) digital
-
-    // Configure all LCD pins as outputs
-    TRISCbits.TRISC2 = 0;  // E
-    TRISCbits.TRISC6 = 0;  // RS
-    TRISBbits.TRISB3 = 0;  // D4
-    TRISBbits.TRISB2 = 0;  // D5
-    TRISEbits.TRISE3 = 0;  // D6
-    TRISEbits.TRISE1 = 0;  // D7
+/*
+ * Power-on sequence run from the Timer3 interrupt, one step per expiry:
+ * {byte, kind, wait after (ms)}. Start-up carries on while the LCD waits.
+ */
+#define LCD_STEP_WAIT       0   // nothing sent
+#define LCD_STEP_NIBBLE     1   // one 4-bit transfer (8-bit mode re-sync)
+#define LCD_STEP_COMMAND    2   // full command, two nibbles
+
+static const uint8_t LCD_INIT_STEPS[][3] = {
+    {0x00, LCD_STEP_WAIT,    50},   // LCD power-up time
+    {0x03, LCD_STEP_NIBBLE,  5},
+    {0x03, LCD_STEP_NIBBLE,  1},
+    {0x03, LCD_STEP_NIBBLE,  1},
+    {0x02, LCD_STEP_NIBBLE,  1},    // now in 4-bit mode
+    {0x28, LCD_STEP_COMMAND, 2},    // 4-bit mode, 2 lines, 5x8 font
+    {0x0C, LCD_STEP_COMMAND, 2},    // Display ON, cursor OFF
+    {0x06, LCD_STEP_COMMAND, 2},    // Auto-increment cursor
+    {0x01, LCD_STEP_COMMAND, 2},    // Clear screen
+};
+#define LCD_INIT_STEP_COUNT (sizeof(LCD_INIT_STEPS) / sizeof(LCD_INIT_STEPS[0]))
+
+// Timer3 on LFINTOSC: 31 counts per ms
+#define LCD_TMR3_COUNTS_PER_MS  31u
+
+static volatile bool s_ready = false;
+static uint8_t s_step = 0;
+
+static void LCD_StartWait(uint8_t ms) {
+    uint16_t start = (uint16_t)(0u - (uint16_t)ms * LCD_TMR3_COUNTS_PER_MS);
+
+    T3CONbits.ON = 0;
+    TMR3H = (uint8_t)(start >> 8);
+    TMR3L = (uint8_t)start;
+    PIR5bits.TMR3IF = 0;
+    T3CONbits.ON = 1;
+}
+
+void LCD_Begin(void) {
+    // Data pins: digital outputs (PIC18 may default some to analog)
+    LCD_DATA_PINS(PINMAP_INIT_OUTPUT, 0)
+
+    // Control pins as outputs
+    LCD_E_TRIS = 0;   // E
+    LCD_RS_TRIS = 0;  // RS
     
     // Start with everything low
     LCD_RS = 0;
     LCD_E = 0;
-    LCD_D4 = 0;
-    LCD_D5 = 0;
-    LCD_D6 = 0;
-    LCD_D7 = 0;
-    
-    // Wait for LCD to power up (LCD needs time after power on)
-    LCD_Delay_ms(50);
-    
-    // Initialize LCD in 4-bit mode (special sequence required)
-    LCD_Send4Bits(0x03);  
-    LCD_Delay_ms(5);
-    LCD_Send4Bits(0x03);  
-    LCD_Delay_ms(1);
-    LCD_Send4Bits(0x03);  
-    LCD_Delay_ms(1);
-    LCD_Send4Bits(0x02);  
-    
-    // Configure LCD settings
-    LCD_SendCommand(0x28);  // 4-bit mode, 2 lines, 5x8 font
-    LCD_SendCommand(0x0C);  // Display ON, cursor OFF
-    LCD_SendCommand(0x06);  // Auto-increment cursor
-    LCD_SendCommand(0x01);  // Clear screen
-    LCD_Delay_ms(2);
+    PINMAP_WRITE(LCD_DATA_PINS, 0u);
+
+    s_ready = false;
+    s_step = 0;
+    T3CONbits.ON = 0;
+    T3CLK = 0b0100;             // LFINTOSC
+    T3CONbits.CKPS = 0b00;      // 1:1
+    T3CONbits.RD16 = 1;
+    T3GCONbits.GE = 0;
+    IPR5bits.TMR3IP = 0;
+    PIE5bits.TMR3IE = 1;
+    LCD_StartWait(LCD_INIT_STEPS[0][2]);
+}
+
+bool LCD_IsReady(void) {
+    return s_ready;
+}
+
+void LCD_Isr(void) {
+    if (PIE5bits.TMR3IE && PIR5bits.TMR3IF) {
+        PIR5bits.TMR3IF = 0;
+        if (++s_step >= LCD_INIT_STEP_COUNT) {
+            T3CONbits.ON = 0;
+            PIE5bits.TMR3IE = 0;
+            s_ready = true;
+            return;
+        }
+
+        const uint8_t *step = LCD_INIT_STEPS[s_step];
+        LCD_RS = 0;
+        if (step[1] == LCD_STEP_COMMAND) {
+            LCD_Send4Bits(step[0] >> 4);
+            LCD_Send4Bits(step[0] & 0x0F);
+        } else if (step[1] == LCD_STEP_NIBBLE) {
+            LCD_Send4Bits(step[0]);
+        }
+        LCD_StartWait(step[2]);
+    }
 }
 
 void LCD_Clear(void) {
@@ -123,47 +156,44 @@ void LCD_Clear(void) {
     LCD_Delay_ms(2);
 }
 
-static void LCD_PrintNumber2Digit(uint8_t n) {
-    LCD_SendData('0' + (n / 10));
-    LCD_SendData('0' + (n % 10));
-}
-
-static void LCD_PrintNumber4Digit(uint16_t n) {
-    LCD_SendData('0' + (n / 1000));
-    LCD_SendData('0' + ((n / 100) % 10));
-    LCD_SendData('0' + ((n / 10) % 10));
-    LCD_SendData('0' + (n % 10));
+// Packed BCD: each digit is one nibble, no division needed
+static void LCD_PrintBCD(uint8_t bcd) {
+    LCD_SendData('0' + (bcd >> 4));
+    LCD_SendData('0' + (bcd & 0x0F));
 }
 
 void LCD_UpdateDisplay(uint8_t hours, uint8_t minutes,
                       uint8_t day, uint8_t month, uint16_t year,
-                      bool is_dst) {
-    uint8_t h = (hours == 0) ? 12 : (hours > 12 ? hours - 12 : hours);
-    uint8_t pm = (hours >= 12);
+                      const char *zone) {
+    uint8_t h = hours;
+    uint8_t pm = (hours >= 0x12);
+
+    if (h == 0x00) {
+        h = 0x12;
+    } else if (h > 0x12) {
+        h = BCD_FromBin(BCD_ToBin(h) - 12u);
+    }
 
-    /* Row 0: Time + DST as sequential stream */
+    /* Row 0: Time + zone as sequential stream */
     LCD_SetCursor(0, 0);
-    if (h < 10) { LCD_SendData(' '); LCD_SendData('0' + h); } else { LCD_PrintNumber2Digit(h); }
+    if (h < 0x10) { LCD_SendData(' '); LCD_SendData('0' + h); } else { LCD_PrintBCD(h); }
     LCD_SendData(':');
-    LCD_PrintNumber2Digit(minutes);
+    LCD_PrintBCD(minutes);
     LCD_SendData(pm ? 'P' : 'A');
     LCD_SendData('M');
     LCD_SendData(' ');
-    LCD_SendData(is_dst ? 'B' : 'G');
-    LCD_SendData(is_dst ? 'S' : 'M');
-    LCD_SendData(is_dst ? 'T' : 'T');
-    LCD_SendData(' ');
-    LCD_SendData(' ');
-    LCD_SendData(' ');
-    LCD_SendData(' ');
+    for (uint8_t i = 0; i < 7; i++) {
+        LCD_SendData(*zone ? *zone++ : ' ');
+    }
 
     /* Row 1: Date DD/MM/YYYY as sequential stream */
     LCD_SetCursor(1, 0);
-    LCD_PrintNumber2Digit(day);
+    LCD_PrintBCD(day);
     LCD_SendData('/');
-    LCD_PrintNumber2Digit(month);
+    LCD_PrintBCD(month);
     LCD_SendData('/');
-    LCD_PrintNumber4Digit(year);
+    LCD_PrintBCD((uint8_t)(year >> 8));
+    LCD_PrintBCD((uint8_t)year);
     LCD_SendData(' ');
     LCD_SendData(' ');
     LCD_SendData(' ');
@@ -9,10 +9,17 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-void LCD_Init(void);
+/* Set up the pins and start the power-on sequence in the background
+ * (Timer3 interrupt, ~67 ms); nothing may be displayed until ready. */
+void LCD_Begin(void);
+bool LCD_IsReady(void);
+/* Low-priority ISR hook: steps the power-on sequence on Timer3 expiry. */
+void LCD_Isr(void);
+/* All fields packed BCD (hours 0x00-0x23, year e.g. 0x2026); zone is the
+ * time abbreviation shown after the time (up to 4 characters). */
 void LCD_UpdateDisplay(uint8_t hours, uint8_t minutes,
                       uint8_t day, uint8_t month, uint16_t year,
-                      bool is_dst);
+                      const char *zone);
 void LCD_Clear(void);
 
 #endif /* LCD_H */
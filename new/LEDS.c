@@ -4,35 +4,32 @@
  *              Controls 9 LEDs from the 10 LED bus: 
  *              - Binary clock (LEDs 1-5 for 5-bit hour),
  *              - LEDs 6-7 off, 
- *              - Heartbeat (LED 8, RB0), 
- *              - Main light (LED 9, RB1).
+ *              - Heartbeat (LED 8, RB0; NCO1/CLC1 hardware blink), 
+ *              - Main light (LED 9, RB1; PWM-dimmed by Light.c).
  ******************************************************************************/
 
  #include <xc.h>
  #include "LEDS.h"
  #include "Config.h"
+ #include "PinMap.h"
+ #include "Light.h"
+
+ /* CLC data input codes (device CLCxSELy table) and PPS output code. */
+ #define CLC_IN_NCO1     0x1B
+ #define CLC_IN_CLC2     0x21
+ #define PPS_CLC1OUT     0x01
+
+ /* NCO1 in fixed-duty mode on LFINTOSC: f = 31 kHz * INC / 2^21. */
+ #define HEARTBEAT_NCO_INC  ((2097152UL * 1000UL) / (31000UL * HEARTBEAT_PERIOD_MS))
  
  /**
   * Initialize the 10-LED bus.
   * Set the first 9 LED pins (10 is unused) as outputs (initially off).
   */
  void LEDs_Init(void) {
-     // LED 1: RG0 
-     TRISGbits.TRISG0 = 0;
-     LATGbits.LATG0 = 0;
-     // LED 2: RG1 
-     TRISGbits.TRISG1 = 0;
-     LATGbits.LATG1 = 0;
-     // LED 3: RA2 
-     TRISAbits.TRISA2 = 0;
-     LATAbits.LATA2 = 0;
-     // LED 4: RF6 
-     TRISFbits.TRISF6 = 0;
-     LATFbits.LATF6 = 0;
-     // LED 5: RA4 
-     ANSELAbits.ANSELA4 = 0;
-     TRISAbits.TRISA4 = 0;
-     LATAbits.LATA4 = 0;
+     // LEDs 1-5: binary clock pins from CLOCK_PINS (PinMap.h)
+     CLOCK_PINS(PINMAP_INIT_OUTPUT, 0)
+     LEDs_SetClockDisplay(0);
      // LED 6: RA5 
      TRISAbits.TRISA5 = 0;
      LATAbits.LATA5 = 0;
@@ -42,36 +39,88 @@
      // LED 8: RB0 
      TRISBbits.TRISB0 = 0;
      LATBbits.LATB0 = 0;
+ #ifdef HEARTBEAT_HARDWARE
+     LEDs_InitHeartbeat();
+ #endif
      // LED 9: RB1 
      TRISBbits.TRISB1 = 0;
      LATBbits.LATB1 = 0;
  }
  
  /**
-  * Set the main streetlight on or off (LED 9, RB1).
+  * Set the main streetlight fully on or off (LED 9, RB1), no ramp.
   */
  void LEDs_SetMainLight(bool state) {
-     LATBbits.LATB1 = state ? 1 : 0;
+     Light_SetLevelNow(state ? LIGHT_LEVEL_FULL : LIGHT_LEVEL_OFF);
  }
  
 /**
   * Update the binary clock display to show the current hour (LEDs 1-5).
   * Display  current hour (0-23) as a 5-bit binary pattern on LEDs 1 through 5.
+  * One masked write per port (LATG, LATA, LATF) instead of one per LED.
   */
  void LEDs_SetClockDisplay(uint8_t hour) {
      if (hour >= HOURS_PER_DAY) {
          hour = 0;
      }
- 
-     LATGbits.LATG0 = (hour & 1) ? 1 : 0;   // LED 1: bit 0
-     LATGbits.LATG1 = (hour & 2) ? 1 : 0;   // LED 2: bit 1 
-     LATAbits.LATA2 = (hour & 4) ? 1 : 0;   // LED 3: bit 2 
-     LATFbits.LATF6 = (hour & 8) ? 1 : 0;   // LED 4: bit 3 
-     LATAbits.LATA4 = (hour & 16) ? 1 : 0;  // LED 5: bit 4 
+     PINMAP_WRITE(CLOCK_PINS, hour);
  }
  
  /**
-  * Toggle the heartbeat LED (LED 8, RB0) for visual status indication.
+  * Hardware heartbeat on LED 8 (RB0), no CPU time:
+  *   NCO1  - fixed-rate square wave (HEARTBEAT_PERIOD_MS) from LFINTOSC.
+  *   CLC2  - D flip-flop: every NCO1 rising edge clocks in 0, a liveness
+  *           token from the main loop sets it (S via gate 4 polarity).
+  *   CLC1  - NCO1 AND CLC2 -> RB0.
+  * So the LED blinks only while tokens keep arriving; a stalled loop (or a
+  * stopped CPU) leaves it dark from the next NCO1 edge.
+  */
+ void LEDs_InitHeartbeat(void) {
+     NCO1CONbits.N1EN = 0;
+     NCO1CONbits.N1PFM = 0;         // Fixed duty (50%)
+     NCO1CLKbits.N1CKS = 0b0011;    // LFINTOSC
+     NCO1INCU = (uint8_t)(HEARTBEAT_NCO_INC >> 16);
+     NCO1INCH = (uint8_t)(HEARTBEAT_NCO_INC >> 8);
+     NCO1INCL = (uint8_t)HEARTBEAT_NCO_INC;   // INCL last: loads the increment
+     NCO1CONbits.N1EN = 1;
+
+     // CLC2: 1-input D flip-flop with S and R (G1 = CLK, G2 = D, G3 = R, G4 = S)
+     CLC2CONbits.LC2EN = 0;
+     CLC2SEL0 = CLC_IN_NCO1;
+     CLC2GLS0 = 0x02;               // G1 = NCO1 (true)
+     CLC2GLS1 = 0x00;               // G2 = 0: D
+     CLC2GLS2 = 0x00;               // G3 = 0: R
+     CLC2GLS3 = 0x00;               // G4 = 0 until a token flips its polarity
+     CLC2POL = 0x00;
+     CLC2CONbits.LC2MODE = 0b100;
+     CLC2CONbits.LC2EN = 1;
+
+     // CLC1: 4-input AND of NCO1 and CLC2, unused gates held at 1
+     CLC1CONbits.LC1EN = 0;
+     CLC1SEL0 = CLC_IN_NCO1;
+     CLC1SEL1 = CLC_IN_CLC2;
+     CLC1GLS0 = 0x02;               // G1 = NCO1
+     CLC1GLS1 = 0x08;               // G2 = CLC2
+     CLC1GLS2 = 0x00;
+     CLC1GLS3 = 0x00;
+     CLC1POL = 0x0C;                // G3, G4 inverted: constant 1
+     CLC1CONbits.LC1MODE = 0b010;
+     CLC1CONbits.LC1EN = 1;
+
+     RB0PPS = PPS_CLC1OUT;
+ }
+
+ /**
+  * Main-loop liveness token: pulse CLC2's S input.
+  */
+ void LEDs_HeartbeatToken(void) {
+     CLC2POLbits.G4POL = 1;
+     CLC2POLbits.G4POL = 0;
+ }
+
+ /**
+  * Toggle the heartbeat LED (LED 8, RB0) for visual status indication
+  * (software heartbeat, when HEARTBEAT_HARDWARE is not defined).
   */
  void LEDs_ToggleHeartbeat(void) {
      LATBbits.LATB0 ^= 1;
@@ -4,8 +4,8 @@
  *              Controls 9 LEDs from the 10 LED bus: 
  *              - Binary clock (LEDs 1-5 for 5-bit hour),
  *              - LEDs 6-7 off, 
- *              - Heartbeat (LED 8, RB0), 
- *              - Main light (LED 9, RB1).
+ *              - Heartbeat (LED 8, RB0; NCO1/CLC1 hardware blink), 
+ *              - Main light (LED 9, RB1; PWM-dimmed by Light.c).
  ******************************************************************************/
 
  #ifndef LEDS_H
@@ -21,7 +21,8 @@
  void LEDs_Init(void);
  
  /**
-  * Set the main streetlight on or off (LED 9, RB1).
+  * Set the main streetlight fully on or off (LED 9, RB1), no ramp.
+  * Brightness and ramps: Light.h.
   */
  void LEDs_SetMainLight(bool state);
  
@@ -32,7 +33,20 @@
  void LEDs_SetClockDisplay(uint8_t hour);
  
  /**
-  * Toggle the heartbeat LED (LED 8, RB0) for visual status indication.
+  * Start the NCO1/CLC hardware heartbeat on LED 8 (RB0); LEDs_Init calls it
+  * when HEARTBEAT_HARDWARE is defined.
+  */
+ void LEDs_InitHeartbeat(void);
+
+ /**
+  * Liveness token: keeps the hardware heartbeat blinking. Call every
+  * main-loop pass; without it the LED goes dark.
+  */
+ void LEDs_HeartbeatToken(void);
+
+ /**
+  * Toggle the heartbeat LED (LED 8, RB0) for visual status indication
+  * (software heartbeat, when HEARTBEAT_HARDWARE is not defined).
   */
  void LEDs_ToggleHeartbeat(void);
  
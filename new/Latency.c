@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * File:   Latency.c
+ * Purpose: Timer0 ISR entry latency/jitter statistics (see Latency.h).
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Latency.h"
+#include "Config.h"
+#include "UART.h"
+
+static const char * const TAG_NAMES[LAT_TAG_COUNT] = {
+    "loop", "time", "dst", "clockled", "sensor", "lcd", "logger", "delay",
+    "dimmer", "getticks", "nvm", "startup"
+};
+
+volatile uint8_t g_latency_tag = LAT_TAG_STARTUP;
+
+static volatile uint16_t s_hist[LAT_HIST_BUCKETS];
+static volatile LatencyWorst s_worst;
+static volatile uint32_t s_samples = 0;
+
+void Latency_Record(uint16_t cycles, uint32_t tick) {
+    uint16_t bucket = cycles / LAT_CYCLES_PER_BUCKET;
+    uint8_t b = (bucket >= LAT_HIST_BUCKETS) ? (LAT_HIST_BUCKETS - 1) : (uint8_t)bucket;
+
+    if (s_hist[b] != 0xFFFFu) {
+        s_hist[b]++;
+    }
+    s_samples++;
+    if (cycles >= s_worst.cycles) {
+        s_worst.cycles = cycles;
+        s_worst.tag = g_latency_tag;
+        s_worst.tick = tick;
+    }
+}
+
+void Latency_GetWorst(LatencyWorst *worst) {
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    worst->cycles = s_worst.cycles;
+    worst->tag = s_worst.tag;
+    worst->tick = s_worst.tick;
+    INTCONbits.GIE = gie_save;
+}
+
+bool Latency_WithinBudget(void) {
+    LatencyWorst w;
+
+    Latency_GetWorst(&w);
+    return (uint32_t)w.cycles <= (uint32_t)ISR_LATENCY_BUDGET_US * LAT_CYCLES_PER_US;
+}
+
+void Latency_Reset(void) {
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++) {
+        s_hist[b] = 0;
+    }
+    s_samples = 0;
+    s_worst.cycles = 0;
+    s_worst.tag = 0;
+    s_worst.tick = 0;
+    INTCONbits.GIE = gie_save;
+}
+
+void Latency_Dump(void) {
+    LatencyWorst w;
+
+    Latency_GetWorst(&w);
+    UART_WriteString("\r\nISR LATENCY (Timer1 at entry, 4 us/bucket) samples=");
+    UART_WriteUInt(s_samples);
+    UART_WriteString("\r\n");
+    for (uint8_t b = 0; b < LAT_HIST_BUCKETS; b++) {
+        uint16_t n;
+        uint8_t gie_save = INTCONbits.GIE;
+
+        INTCONbits.GIE = 0;
+        n = s_hist[b];
+        INTCONbits.GIE = gie_save;
+        if (n == 0) {
+            continue;
+        }
+        UART_WriteString((b == LAT_HIST_BUCKETS - 1) ? " >=" : "  ");
+        UART_WriteUInt((uint32_t)b * (LAT_CYCLES_PER_BUCKET / LAT_CYCLES_PER_US));
+        UART_WriteString("us ");
+        UART_WriteUInt(n);
+        UART_WriteString("\r\n");
+    }
+    UART_WriteString("worst=");
+    UART_WriteUInt(w.cycles / LAT_CYCLES_PER_US);
+    UART_WriteByte('.');
+    UART_WriteUInt((w.cycles % LAT_CYCLES_PER_US) * 10u / LAT_CYCLES_PER_US);
+    UART_WriteString("us in ");
+    UART_WriteString(w.tag < LAT_TAG_COUNT ? TAG_NAMES[w.tag] : "?");
+    UART_WriteString(" at tick ");
+    UART_WriteUInt(w.tick);
+    UART_WriteString(" budget=");
+    UART_WriteUInt(ISR_LATENCY_BUDGET_US);
+    UART_WriteString(Latency_WithinBudget() ? "us PASS\r\n" : "us FAIL\r\n");
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * File:   Latency.h
+ * Purpose: Timer0 ISR entry latency/jitter statistics. The ISR reads
+ *          Timer1 (free-running at Fosc/4, 62.5 ns) on entry and subtracts
+ *          the Timer1 value the overflow was due at, worked out when the
+ *          tick before reloaded Timer0 (Timer.c). A couple of cycles of
+ *          read/write skew are in every sample alike.
+ *          The main loop publishes a region tag so the worst case can be
+ *          attributed to the code that was running.
+ ******************************************************************************/
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Tags 0-8 are the PROF_* region ids (Profile.h); these mark the
+ * interrupt-off windows and start-up. */
+#define LAT_TAG_GETTICKS    9
+#define LAT_TAG_NVM         10
+#define LAT_TAG_STARTUP     11
+#define LAT_TAG_COUNT       12
+
+#define LAT_CYCLES_PER_US   16u     /* Fosc/4 = 16 MHz */
+#define LAT_CYCLES_PER_BUCKET 64u   /* 4 us */
+#define LAT_HIST_BUCKETS    16      /* 0-60 us, last = 60 us and over */
+
+typedef struct {
+    uint16_t cycles;    /* Fosc/4 cycles from overflow to ISR entry */
+    uint8_t  tag;       /* region tag when the worst case was seen */
+    uint32_t tick;      /* tick number it happened on */
+} LatencyWorst;
+
+extern volatile uint8_t g_latency_tag;
+
+/** Publish the region now running (one byte store, safe anywhere). */
+#define Latency_Tag(tag)    (g_latency_tag = (uint8_t)(tag))
+
+/** Called from the Timer0 ISR with the entry latency (0xFFFF = 4 ms+). */
+void Latency_Record(uint16_t cycles, uint32_t tick);
+
+/** Copy the worst-case record (interrupt-safe). */
+void Latency_GetWorst(LatencyWorst *worst);
+
+/** True while the worst latency seen is within ISR_LATENCY_BUDGET_US. */
+bool Latency_WithinBudget(void);
+
+/** Print histogram, worst case and budget verdict over the UART. */
+void Latency_Dump(void);
+
+/** Clear the statistics. */
+void Latency_Reset(void);
+
+#endif /* LATENCY_H */
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * File:   Light.c
+ * Purpose: Main light brightness on PWM6 (see Light.h). Timer4 runs the PWM
+ *          period (Fosc/4, 1:16, PR 255 = 256 us); its 1:16 postscaler
+ *          interrupt (~4 ms) steps ramps in 8.8 fixed point and is disabled
+ *          again as soon as the target is reached.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Light.h"
+#include "Config.h"
+#include "Timer.h"
+
+#define LIGHT_RAMP_HZ           244u    /* 16 MHz / 16 / 256 / 16 */
+#define LIGHT_RAMP_STEP_Q8      ((uint16_t)((LIGHT_LEVEL_FULL * 256UL) / \
+                                 (LIGHT_RAMP_SECONDS * LIGHT_RAMP_HZ)))
+
+/* Level-seconds (255 = full power for one second) per full-power minute. */
+#define LIGHT_FULL_MINUTE       ((uint32_t)LIGHT_LEVEL_FULL * SECONDS_PER_MINUTE)
+
+static volatile uint8_t s_level = LIGHT_LEVEL_OFF;
+static volatile uint8_t s_target = LIGHT_LEVEL_OFF;
+static uint16_t s_level_q8 = 0;         /* ISR only */
+
+static uint32_t s_on_second;            /* when the output last left off */
+static uint16_t s_on_counts;
+static volatile uint8_t s_on_seq = 0;
+
+static uint32_t s_used = 0;             /* level-seconds tonight */
+static uint32_t s_baseline = 0;
+
+static void Light_WriteDuty(uint8_t level) {
+    if (level != LIGHT_LEVEL_OFF && PWM6DCH == LIGHT_LEVEL_OFF) {
+        Timer_GetStamp(&s_on_second, &s_on_counts);
+        s_on_seq++;
+    }
+    /* 10-bit duty: level in DCH, its top two bits repeated as the LSBs so
+     * 255 gives 1023/1024. */
+    PWM6DCH = level;
+    PWM6DCL = level & 0xC0;
+}
+
+void Light_Init(void) {
+    T4CONbits.ON = 0;
+    T4CLKCON = 0b0001;          // Fosc/4
+    T4CONbits.CKPS = 0b100;     // 1:16
+    T4CONbits.OUTPS = 0b1111;   // 1:16 interrupt for ramp steps
+    T4HLT = 0;
+    T4PR = 0xFF;
+    T4TMR = 0;
+
+    Light_WriteDuty(LIGHT_LEVEL_OFF);
+    CCPTMRS1bits.P6TSEL = 0b10; // PWM6 timebase = Timer4
+    RB1PPS = 0x0A;              // PWM6OUT on RB1 (LED 9)
+    TRISBbits.TRISB1 = 0;
+    PWM6CONbits.PWM6EN = 1;
+
+    IPR5bits.TMR4IP = 0;
+    PIR5bits.TMR4IF = 0;
+    T4CONbits.ON = 1;
+}
+
+void Light_SetLevel(uint8_t level) {
+    if (level != s_target) {
+        s_target = level;
+        PIE5bits.TMR4IE = 1;
+    }
+}
+
+void Light_SetLevelNow(uint8_t level) {
+    PIE5bits.TMR4IE = 0;
+    s_target = level;
+    s_level = level;
+    s_level_q8 = (uint16_t)level << 8;
+    Light_WriteDuty(level);
+}
+
+uint8_t Light_GetLevel(void) {
+    return s_level;
+}
+
+void Light_Isr(void) {
+    if (PIE5bits.TMR4IE && PIR5bits.TMR4IF) {
+        uint16_t target = (uint16_t)s_target << 8;
+
+        PIR5bits.TMR4IF = 0;
+        if (s_level_q8 < target) {
+            s_level_q8 = (target - s_level_q8 > LIGHT_RAMP_STEP_Q8)
+                ? s_level_q8 + LIGHT_RAMP_STEP_Q8 : target;
+        } else {
+            s_level_q8 = (s_level_q8 - target > LIGHT_RAMP_STEP_Q8)
+                ? s_level_q8 - LIGHT_RAMP_STEP_Q8 : target;
+        }
+        s_level = (uint8_t)(s_level_q8 >> 8);
+        Light_WriteDuty(s_level);
+        if (s_level_q8 == target) {
+            PIE5bits.TMR4IE = 0;
+        }
+    }
+}
+
+bool Light_GetSwitchOn(uint32_t *seconds, uint16_t *counts) {
+    static uint8_t seen = 0;
+    bool fresh;
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    fresh = (s_on_seq != seen);
+    seen = s_on_seq;
+    *seconds = s_on_second;
+    *counts = s_on_counts;
+    INTCONbits.GIEL = giel_save;
+    return fresh;
+}
+
+void Light_AccountSecond(bool dark, bool saving) {
+    s_used += s_level;
+    if (dark && !saving) {
+        s_baseline += LIGHT_LEVEL_FULL;
+    }
+}
+
+void Light_EndNight(void) {
+    s_used = 0;
+    s_baseline = 0;
+}
+
+uint16_t Light_GetEnergyUsed(void) {
+    return (uint16_t)(s_used / LIGHT_FULL_MINUTE);
+}
+
+int16_t Light_GetEnergySaved(void) {
+    if (s_baseline < s_used) {
+        return -(int16_t)((s_used - s_baseline) / LIGHT_FULL_MINUTE);
+    }
+    return (int16_t)((s_baseline - s_used) / LIGHT_FULL_MINUTE);
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * File:   Light.h
+ * Purpose: Main light (RB1) brightness control on PWM6 / Timer4. Level
+ *          changes ramp in the Timer4 interrupt, so the main loop only sets
+ *          a target. Also keeps the per-night energy account.
+ ******************************************************************************/
+
+#ifndef LIGHT_H
+#define LIGHT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LIGHT_LEVEL_OFF     0u
+#define LIGHT_LEVEL_FULL    255u
+
+/** Route PWM6 to RB1, start Timer4 (~3.9 kHz PWM), light off. */
+void Light_Init(void);
+
+/** Ramp towards level (0-255) at LIGHT_RAMP_SECONDS for full scale. */
+void Light_SetLevel(uint8_t level);
+
+/** Jump straight to level, cancelling any ramp in progress. */
+void Light_SetLevelNow(uint8_t level);
+
+/** Level currently on the output (moves during a ramp). */
+uint8_t Light_GetLevel(void);
+
+/**
+ * New switch-on (output off to any duty) since the last call? Its
+ * Timer_GetStamp, taken as the duty register was written.
+ */
+bool Light_GetSwitchOn(uint32_t *seconds, uint16_t *counts);
+
+/** Low-priority ISR hook: one ramp step per Timer4 postscaler period. */
+void Light_Isr(void);
+
+/**
+ * Add one clock second to tonight's account: the output level actually
+ * used, and the baseline of the previous policy, full power whenever it is
+ * dark outside an energy-save window and off inside one.
+ */
+void Light_AccountSecond(bool dark, bool saving);
+
+/** Close the night's account (called at noon). */
+void Light_EndNight(void);
+
+/** Tonight so far, in full-power minutes; saved is against the baseline,
+ *  negative when more was used. */
+uint16_t Light_GetEnergyUsed(void);
+int16_t Light_GetEnergySaved(void);
+
+#endif /* LIGHT_H */
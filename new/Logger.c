@@ -0,0 +1,341 @@
+/*******************************************************************************
+ * File:   Logger.c
+ * Purpose: Per-minute LDR and lamp-state history logger in program flash.
+ *          The log area (LOG_FLASH_START..LOG_FLASH_END) is a ring of
+ *          128-byte pages, one flash row each. Every page starts with a
+ *          header (magic, sequence number, start minute) so it decodes on
+ *          its own; records are delta/run-length coded so a steady reading
+ *          costs well under one byte per minute.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Logger.h"
+#include "NVM.h"
+#include "Config.h"
+
+#define LOG_PAGE_COUNT  ((uint16_t)((LOG_FLASH_END - LOG_FLASH_START) / NVM_FLASH_ROW_SIZE))
+#define LOG_PAGE_MAGIC  0x4C
+#define LOG_HDR_SIZE    7       /* magic, seq (2), minute of last record (4) */
+
+/*
+ * Record encoding. "cur" is the minute of the last record; a light record
+ * first advances cur by one minute, a lamp record is stamped with cur.
+ *  0x00-0x7F  light, zigzag delta -64..63 from the previous reading
+ *  0x80-0xBF  light unchanged for (n & 0x3F) + 1 minutes
+ *  0xC0-0xC3  light absolute: 2 high bits here, low byte follows
+ *  0xD0/0xD1  lamp switched off/on
+ *  0xE0       time mark: cur = following 4-byte minute (gaps, DST steps)
+ *  0xFF       erased flash, end of page
+ */
+#define LOG_TAG_RUN     0x80
+#define LOG_TAG_ABS     0xC0
+#define LOG_TAG_LAMP    0xD0
+#define LOG_TAG_MARK    0xE0
+#define LOG_ERASED      0xFF
+#define LOG_RUN_MAX     64
+#define LOG_MARK_SIZE   5
+#define LOG_NO_RUN      0xFF
+
+#define LOG_OP_NONE     0
+#define LOG_OP_ERASE    1
+#define LOG_OP_WRITE    2
+
+#define LOG_DUMP_FLASH   0
+#define LOG_DUMP_PENDING 1
+#define LOG_DUMP_FILL    2
+#define LOG_DUMP_DONE    3
+
+/* Two row buffers: one being filled, the other waiting for its flash write. */
+static uint8_t  s_buf[2][NVM_FLASH_ROW_SIZE];
+static uint8_t  s_fill = 0;
+static uint8_t  s_len = 0;
+static uint16_t s_fill_page = 0;
+static uint16_t s_seq = 0;
+
+static uint32_t s_cur_minute = 0;
+static uint16_t s_prev_value = 0;
+static bool     s_prev_valid = false;
+static uint8_t  s_run_pos = LOG_NO_RUN;    /* offset of an open run byte */
+
+static uint8_t  s_op = LOG_OP_NONE;         /* pending op on s_buf[s_fill ^ 1] */
+static uint16_t s_op_page = 0;
+static uint32_t s_last_tick = 0;
+
+static struct {
+    uint8_t  stage;
+    bool     in_page;
+    uint8_t  pos;
+    uint8_t  run_left;
+    uint16_t page;
+    uint16_t pages_left;
+    uint16_t value;
+    uint32_t minute;
+} s_dump;
+
+static uint32_t PageAddress(uint16_t page) {
+    return LOG_FLASH_START + (uint32_t)page * NVM_FLASH_ROW_SIZE;
+}
+
+static void PutByte(uint8_t b) {
+    s_buf[s_fill][s_len++] = b;
+}
+
+static void Put32(uint32_t v) {
+    for (uint8_t i = 0; i < 4; i++) {
+        PutByte((uint8_t)v);
+        v >>= 8;
+    }
+}
+
+static uint32_t Get32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void StartPage(void) {
+    for (uint8_t i = 0; i < NVM_FLASH_ROW_SIZE; i++) {
+        s_buf[s_fill][i] = LOG_ERASED;
+    }
+    s_len = 0;
+    PutByte(LOG_PAGE_MAGIC);
+    PutByte((uint8_t)s_seq);
+    PutByte((uint8_t)(s_seq >> 8));
+    Put32(s_cur_minute);
+    s_prev_valid = false;       /* first light record of a page is absolute */
+    s_run_pos = LOG_NO_RUN;
+}
+
+/* Synchronous fallback; only reached if two pages fill within one tick. */
+static void FlushPending(void) {
+    if (s_op == LOG_OP_ERASE) {
+        NVM_FlashEraseRow(PageAddress(s_op_page));
+        s_op = LOG_OP_WRITE;
+    }
+    if (s_op == LOG_OP_WRITE) {
+        NVM_FlashWriteRow(PageAddress(s_op_page), s_buf[s_fill ^ 1]);
+        s_op = LOG_OP_NONE;
+    }
+}
+
+/* Make room for len bytes, handing a full page to Logger_Task if needed. */
+static void Reserve(uint8_t len) {
+    if ((uint16_t)s_len + len <= NVM_FLASH_ROW_SIZE) {
+        return;
+    }
+    if (s_op != LOG_OP_NONE) {
+        FlushPending();
+    }
+    s_op = LOG_OP_ERASE;
+    s_op_page = s_fill_page;
+    s_fill ^= 1;
+    s_fill_page = (uint16_t)((s_fill_page + 1u) % LOG_PAGE_COUNT);
+    s_seq++;
+    StartPage();
+}
+
+void Logger_Init(void) {
+    uint8_t hdr[LOG_HDR_SIZE];
+    bool found = false;
+    uint16_t newest = 0;
+    uint16_t newest_seq = 0;
+
+    for (uint16_t page = 0; page < LOG_PAGE_COUNT; page++) {
+        NVM_FlashRead(PageAddress(page), hdr, LOG_HDR_SIZE);
+        if (hdr[0] != LOG_PAGE_MAGIC) {
+            continue;
+        }
+        uint16_t seq = (uint16_t)(hdr[1] | ((uint16_t)hdr[2] << 8));
+        if (!found || (int16_t)(seq - newest_seq) > 0) {
+            found = true;
+            newest = page;
+            newest_seq = seq;
+        }
+    }
+
+    if (found) {
+        s_fill_page = (uint16_t)((newest + 1u) % LOG_PAGE_COUNT);
+        s_seq = (uint16_t)(newest_seq + 1u);
+    } else {
+        s_fill_page = 0;
+        s_seq = 0;
+    }
+    s_fill = 0;
+    s_op = LOG_OP_NONE;
+    s_cur_minute = 0;
+    StartPage();
+}
+
+void Logger_LogLight(uint32_t minute, uint16_t value) {
+    bool need_mark = (minute != s_cur_minute + 1u);
+
+    if (value > 1023u) {
+        value = 1023u;
+    }
+    Reserve(need_mark ? (LOG_MARK_SIZE + 2) : 2);
+
+    if (need_mark) {
+        PutByte(LOG_TAG_MARK);
+        Put32(minute - 1u);
+        s_run_pos = LOG_NO_RUN;
+    }
+
+    int16_t delta = (int16_t)(value - s_prev_value);
+    if (!s_prev_valid || delta < -64 || delta > 63) {
+        PutByte((uint8_t)(LOG_TAG_ABS | (value >> 8)));
+        PutByte((uint8_t)value);
+        s_run_pos = LOG_NO_RUN;
+    } else if (delta != 0) {
+        PutByte((uint8_t)(delta >= 0 ? (delta << 1) : ((-delta << 1) - 1)));
+        s_run_pos = LOG_NO_RUN;
+    } else if (s_run_pos != LOG_NO_RUN &&
+               (s_buf[s_fill][s_run_pos] & 0x3F) < (LOG_RUN_MAX - 1)) {
+        s_buf[s_fill][s_run_pos]++;   /* extend the open run in place */
+    } else {
+        s_run_pos = s_len;
+        PutByte(LOG_TAG_RUN);
+    }
+
+    s_prev_value = value;
+    s_prev_valid = true;
+    s_cur_minute = minute;
+}
+
+void Logger_LogLamp(uint32_t minute, bool on) {
+    bool need_mark = (minute != s_cur_minute);
+
+    Reserve(need_mark ? (LOG_MARK_SIZE + 1) : 1);
+    if (need_mark) {
+        PutByte(LOG_TAG_MARK);
+        Put32(minute);
+        s_cur_minute = minute;
+    }
+    PutByte((uint8_t)(LOG_TAG_LAMP | (on ? 1u : 0u)));
+    s_run_pos = LOG_NO_RUN;
+}
+
+void Logger_Task(uint32_t now) {
+    if (now == s_last_tick) {
+        return;
+    }
+    s_last_tick = now;
+
+    /* Erase and write go on separate ticks: one CPU stall per tick at most. */
+    if (s_op == LOG_OP_ERASE) {
+        NVM_FlashEraseRow(PageAddress(s_op_page));
+        s_op = LOG_OP_WRITE;
+    } else if (s_op == LOG_OP_WRITE) {
+        NVM_FlashWriteRow(PageAddress(s_op_page), s_buf[s_fill ^ 1]);
+        s_op = LOG_OP_NONE;
+    }
+}
+
+/* ---- Dump ---------------------------------------------------------------- */
+
+static uint8_t DumpByte(uint8_t pos) {
+    if (pos >= NVM_FLASH_ROW_SIZE) {
+        return LOG_ERASED;
+    }
+    if (s_dump.stage == LOG_DUMP_FLASH) {
+        return NVM_FlashReadByte(PageAddress(s_dump.page) + pos);
+    }
+    if (s_dump.stage == LOG_DUMP_PENDING) {
+        return s_buf[s_fill ^ 1][pos];
+    }
+    return s_buf[s_fill][pos];
+}
+
+static uint32_t DumpRead32(void) {
+    uint8_t b[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        b[i] = DumpByte(s_dump.pos++);
+    }
+    return Get32(b);
+}
+
+static void DumpNextPage(void) {
+    s_dump.in_page = false;
+    if (s_dump.stage == LOG_DUMP_FLASH) {
+        s_dump.page = (uint16_t)((s_dump.page + 1u) % LOG_PAGE_COUNT);
+        if (--s_dump.pages_left == 0) {
+            s_dump.stage = (s_op != LOG_OP_NONE) ? LOG_DUMP_PENDING : LOG_DUMP_FILL;
+        }
+    } else if (s_dump.stage == LOG_DUMP_PENDING) {
+        s_dump.stage = LOG_DUMP_FILL;
+    } else {
+        s_dump.stage = LOG_DUMP_DONE;
+    }
+}
+
+static bool DumpOpenPage(void) {
+    /* A page waiting for its write still holds stale data in flash. */
+    if (s_dump.stage == LOG_DUMP_FLASH && s_op != LOG_OP_NONE &&
+        s_dump.page == s_op_page) {
+        DumpNextPage();
+        return false;
+    }
+    s_dump.pos = 0;
+    if (DumpByte(s_dump.pos++) != LOG_PAGE_MAGIC) {
+        DumpNextPage();
+        return false;
+    }
+    s_dump.pos = 3;
+    s_dump.minute = DumpRead32();
+    s_dump.in_page = true;
+    return true;
+}
+
+void Logger_DumpBegin(void) {
+    s_dump.stage = LOG_DUMP_FLASH;
+    s_dump.in_page = false;
+    s_dump.run_left = 0;
+    s_dump.page = s_fill_page;      /* oldest page in the ring */
+    s_dump.pages_left = LOG_PAGE_COUNT;
+    s_dump.value = 0;
+    s_dump.minute = 0;
+}
+
+bool Logger_DumpNext(LogRecord *rec) {
+    while (s_dump.stage != LOG_DUMP_DONE) {
+        if (s_dump.run_left != 0) {
+            s_dump.run_left--;
+            s_dump.minute++;
+            rec->type = LOG_REC_LIGHT;
+            rec->minute = s_dump.minute;
+            rec->value = s_dump.value;
+            return true;
+        }
+        if (!s_dump.in_page && !DumpOpenPage()) {
+            continue;
+        }
+
+        uint8_t b = DumpByte(s_dump.pos++);
+        if (b < LOG_TAG_RUN) {
+            int16_t delta = (b & 1u) ? -(int16_t)((b + 1u) >> 1) : (int16_t)(b >> 1);
+            s_dump.value = (uint16_t)(s_dump.value + delta);
+            s_dump.minute++;
+            rec->type = LOG_REC_LIGHT;
+            rec->minute = s_dump.minute;
+            rec->value = s_dump.value;
+            return true;
+        } else if (b < LOG_TAG_ABS) {
+            s_dump.run_left = (uint8_t)((b & 0x3F) + 1u);
+        } else if ((b & 0xFC) == LOG_TAG_ABS) {
+            s_dump.value = (uint16_t)(((uint16_t)(b & 0x03) << 8) | DumpByte(s_dump.pos++));
+            s_dump.minute++;
+            rec->type = LOG_REC_LIGHT;
+            rec->minute = s_dump.minute;
+            rec->value = s_dump.value;
+            return true;
+        } else if ((b & 0xFE) == LOG_TAG_LAMP) {
+            rec->type = LOG_REC_LAMP;
+            rec->minute = s_dump.minute;
+            rec->value = (uint16_t)(b & 1u);
+            return true;
+        } else if (b == LOG_TAG_MARK) {
+            s_dump.minute = DumpRead32();
+        } else {
+            DumpNextPage();         /* end of page (or unknown byte) */
+        }
+    }
+    return false;
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * File:   Logger.h
+ * Purpose: Per-minute LDR and lamp-state history logger kept in the unused
+ *          upper half of program flash (delta/run-length encoded pages).
+ ******************************************************************************/
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Record types returned by the dump API. */
+#define LOG_REC_LIGHT   0   /* value = averaged LDR reading (0-1023) */
+#define LOG_REC_LAMP    1   /* value = 1 lamp switched on, 0 switched off */
+
+typedef struct {
+    uint8_t  type;          /* LOG_REC_* */
+    uint32_t minute;        /* Minutes since 00:00 1 Jan CALENDAR_EPOCH_YEAR */
+    uint16_t value;
+} LogRecord;
+
+/** Scan the flash log area and continue after the newest stored page. */
+void Logger_Init(void);
+
+/** Append one averaged LDR reading taken at the given epoch minute. */
+void Logger_LogLight(uint32_t minute, uint16_t value);
+
+/** Append a lamp on/off change at the given epoch minute. */
+void Logger_LogLamp(uint32_t minute, bool on);
+
+/**
+ * Run at most one pending flash erase/write, and only on the first call
+ * after the tick count changes, so the CPU stall always lands straight
+ * after a Timer0 interrupt and never delays the next one.
+ */
+void Logger_Task(uint32_t now);
+
+/** Start a dump from the oldest record still held (flash, then RAM). */
+void Logger_DumpBegin(void);
+
+/** Decode the next record of the dump. Returns false when finished. */
+bool Logger_DumpNext(LogRecord *rec);
+
+#endif /* LOGGER_H */
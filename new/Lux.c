@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * File:   Lux.c
+ * Purpose: Log-lux conversion (see Lux.h). The table is for a GL5528-class
+ *          LDR (10 kohm at 10 lux, gamma 0.7) on the supply side of a
+ *          10 kohm divider: 33 points, one per 32 counts, within +/-4 clx
+ *          (+/-10 %) of the LDR law from 0.3 lux to 1 klux. The other
+ *          divider orientation reads the table mirrored.
+ ******************************************************************************/
+
+#include "Lux.h"
+
+#define LUX_STEP_SHIFT  5u                      // 32 counts per segment
+#define LUX_STEP        (1u << LUX_STEP_SHIFT)
+#define LUX_ADC_MAX     1023u
+
+static const int16_t LUX_TABLE[] = {
+    -100, -100,  -68,  -41,  -21,   -5,    9,   21,
+      32,   42,   51,   60,   68,   76,   84,   92,
+     100,  108,  116,  124,  132,  140,  149,  158,
+     168,  179,  191,  205,  221,  241,  268,  313,
+     500,
+};
+#define LUX_POINTS  (sizeof(LUX_TABLE) / sizeof(LUX_TABLE[0]))
+
+/* 10^(k/10) x 100, k = 0..10: one decade of lux mantissa. */
+static const uint16_t LUX_DECADE[] = {
+    100, 126, 158, 200, 251, 316, 398, 501, 631, 794, 1000,
+};
+
+static bool s_mirror = false;
+
+void Lux_Init(bool dark_above) {
+    s_mirror = dark_above;      // then light pulls the reading down
+}
+
+int16_t Lux_FromAdc(uint16_t adc) {
+    return Lux_FromAdcOriented(adc, s_mirror);
+}
+
+int16_t Lux_FromAdcOriented(uint16_t adc, bool dark_above) {
+    uint8_t i, frac;
+    int16_t base;
+
+    if (adc > LUX_ADC_MAX) {
+        adc = LUX_ADC_MAX;
+    }
+    if (dark_above) {
+        adc = LUX_ADC_MAX - adc;
+    }
+    i = (uint8_t)(adc >> LUX_STEP_SHIFT);
+    frac = (uint8_t)(adc & (LUX_STEP - 1u));
+    base = LUX_TABLE[i];
+    /* Rising table: the step is >= 0 and the product fits 16 bits. */
+    return (int16_t)(base + (int16_t)(((uint16_t)(LUX_TABLE[i + 1u] - base) * frac) >> LUX_STEP_SHIFT));
+}
+
+uint16_t Lux_ToAdc(int16_t clx) {
+    uint16_t adc = LUX_ADC_MAX;
+
+    for (uint8_t i = 0; i + 1u < LUX_POINTS; i++) {
+        int16_t lo = LUX_TABLE[i];
+        int16_t hi = LUX_TABLE[i + 1u];
+        if (clx < hi) {
+            adc = (uint16_t)i * LUX_STEP;
+            if (clx > lo) {
+                adc += (uint16_t)(((uint16_t)(clx - lo) * LUX_STEP) / (uint16_t)(hi - lo));
+            }
+            break;
+        }
+    }
+    if (adc > LUX_ADC_MAX) {
+        adc = LUX_ADC_MAX;
+    }
+    return s_mirror ? (uint16_t)(LUX_ADC_MAX - adc) : adc;
+}
+
+uint16_t Lux_ToLux(int16_t clx) {
+    int8_t decade = 0;
+    uint8_t k, r;
+    uint32_t lux;
+
+    if (clx >= 482) {
+        return 0xFFFF;          // 10^4.82 = 66 klux
+    }
+    while (clx < 0) {
+        clx += 100;
+        decade--;
+    }
+    while (clx >= 100) {
+        clx -= 100;
+        decade++;
+    }
+    k = (uint8_t)clx / 10u;
+    r = (uint8_t)clx % 10u;
+    lux = LUX_DECADE[k] + ((uint16_t)(LUX_DECADE[k + 1u] - LUX_DECADE[k]) * r) / 10u;  /* x100 */
+    for (; decade > 0; decade--) {
+        lux *= 10u;
+    }
+    for (; decade < 0; decade++) {
+        lux /= 10u;
+    }
+    lux = (lux + 50u) / 100u;
+    return (lux > 0xFFFFu) ? 0xFFFF : (uint16_t)lux;
+}
+
+int16_t Lux_FromLux(uint16_t lux) {
+    uint32_t m = (uint32_t)lux * 100u;      // mantissa x100, 100-999
+    int16_t clx = 0;
+    uint8_t k = 0;
+
+    if (lux == 0u) {
+        return LUX_CLX_MIN;
+    }
+    while (m >= 1000u) {
+        m /= 10u;
+        clx += 100;
+    }
+    while (k < 9u && LUX_DECADE[k + 1u] <= m) {
+        k++;
+    }
+    return (int16_t)(clx + k * 10 +
+                     (int16_t)(((uint16_t)m - LUX_DECADE[k]) * 10u / (LUX_DECADE[k + 1u] - LUX_DECADE[k])));
+}
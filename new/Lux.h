@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * File:   Lux.h
+ * Purpose: LDR reading to light level. Filtered ADC counts map to log-lux
+ *          through a flash table with fixed-point linear interpolation, so
+ *          thresholds sit at the perceptual (geometric) midpoint and
+ *          hysteresis is a fixed ratio of lux. Log-lux is held as
+ *          centi-log10 lux ("clx"): 0 = 1 lux, 100 = 10 lux, 200 = 100 lux.
+ ******************************************************************************/
+
+#ifndef LUX_H
+#define LUX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LUX_CLX_MIN     (-100)  /* 0.1 lux: table floor */
+#define LUX_CLX_MAX     500     /* 100 klux: table ceiling */
+
+/**
+ * Divider orientation from calibration: dark_above = dark gives the
+ * higher reading (LDR on the ground side).
+ */
+void Lux_Init(bool dark_above);
+
+/** ADC counts (0-1023) to clx: one table step and a multiply, no divide. */
+int16_t Lux_FromAdc(uint16_t adc);
+
+/** As Lux_FromAdc, for another LDR with its own divider orientation. */
+int16_t Lux_FromAdcOriented(uint16_t adc, bool dark_above);
+
+/** clx to the ADC count where it is crossed (configuration only: divides). */
+uint16_t Lux_ToAdc(int16_t clx);
+
+/** clx to lux, saturating at 65535 (telemetry). */
+uint16_t Lux_ToLux(int16_t clx);
+
+/** lux to clx (thresholds set in lux). 0 gives LUX_CLX_MIN. */
+int16_t Lux_FromLux(uint16_t lux);
+
+#endif /* LUX_H */
@@ -0,0 +1,306 @@
+/*******************************************************************************
+ * File:   MSF.c
+ * Purpose: MSF time-code decoder (see MSF.h). Every second starts with the
+ *          carrier switched off; the off time carries two bits:
+ *              100 ms  A=0 B=0       200 ms  A=1 B=0
+ *              300 ms  A=1 B=1       100 off, 100 on, 100 off  A=0 B=1
+ *              500 ms  minute marker (second 0)
+ *          Widths are measured from CCP4 captures of Timer5. A second that
+ *          does not fit, a stray edge or a missing second drops the frame
+ *          and the decoder re-synchronises on the next carrier-off edge, so
+ *          noise costs a minute rather than setting a wrong time.
+ *          Bits 17-59 are counted back from the marker, so leap-second
+ *          minutes (59 or 61 seconds) decode the same way.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "MSF.h"
+#include "Config.h"
+#include "BCD.h"
+
+/* Timer5 on LFINTOSC: 31 counts per ms, wraps every ~2.1 s. */
+#define MSF_COUNTS_PER_MS   31u
+#define MSF_MS(ms)          ((uint16_t)((ms) * MSF_COUNTS_PER_MS))
+
+/* Acceptance windows (counts); receivers move edges by up to ~40 ms. */
+#define MSF_SECOND_MIN      MSF_MS(940)     // next second's carrier-off
+#define MSF_SECOND_MAX      MSF_MS(1060)
+#define MSF_PULSE_MIN       MSF_MS(50)
+#define MSF_PULSE_100_MAX   MSF_MS(150)
+#define MSF_PULSE_200_MAX   MSF_MS(250)
+#define MSF_PULSE_300_MAX   MSF_MS(400)
+#define MSF_MARKER_MAX      MSF_MS(650)
+#define MSF_B_START_MIN     MSF_MS(150)     // second pulse of an A=0 B=1
+#define MSF_B_START_MAX     MSF_MS(250)
+
+#define MSF_PIN             PORTDbits.RD3
+#define MSF_PPS_RD3         0x1B
+
+#define MINUTES_PER_DAY     (MINUTES_PER_HOUR * HOURS_PER_DAY)
+
+/* Per-second pulse timing, offsets from the second's carrier-off edge. */
+static uint16_t s_offset = 0;
+static uint16_t s_pulse1 = 0;           /* first off pulse width, 0 = open */
+static uint16_t s_pulse2_start = 0;
+static uint16_t s_pulse2_end = 0;
+static uint16_t s_last_capture = 0;
+static uint8_t  s_wraps = 0;            /* Timer5 overflows since last edge */
+static bool     s_in_sync = false;      /* s_offset counts from a second start */
+
+/* Minute being received: A bits of the last 48 seconds (second 59 in bit 0
+ * of s_a_lo), B bits of the last 8. */
+static bool     s_framing = false;      /* marker seen, every second since good */
+static uint8_t  s_seconds = 0;
+static uint32_t s_a_lo = 0;
+static uint16_t s_a_hi = 0;
+static uint8_t  s_b = 0;
+
+/* Completed minute, handed to the main loop. */
+static volatile bool s_frame_ready = false;
+static uint32_t s_frame_a_lo;
+static uint16_t s_frame_a_hi;
+static uint8_t  s_frame_b;
+static uint16_t s_frames_seen = 0;
+static uint16_t s_frames_good = 0;
+
+/* Last good frame, for the one-minute-later confirmation. */
+static bool     s_have_prev = false;
+static uint16_t s_prev_minute;
+static uint8_t  s_prev_day;
+
+void MSF_Init(void) {
+    TRISDbits.TRISD3 = 1;
+    ANSELDbits.ANSELD3 = 0;
+    CCP4PPS = MSF_PPS_RD3;
+
+    T5CONbits.ON = 0;
+    T5CLK = 0b0100;             // LFINTOSC
+    T5CONbits.CKPS = 0b00;      // 1:1
+    T5CONbits.RD16 = 1;
+    T5GCONbits.GE = 0;
+    TMR5H = 0;
+    TMR5L = 0;
+
+    CCPTMRS1bits.C4TSEL = 0b11; // CCP4 captures Timer5
+    CCP4CONbits.MODE = 0b0011;  // capture every edge
+    CCP4CONbits.EN = 1;
+
+    IPR5bits.TMR5IP = 0;
+    IPR6bits.CCP4IP = 0;
+    PIR5bits.TMR5IF = 0;
+    PIR6bits.CCP4IF = 0;
+    PIE5bits.TMR5IE = 1;
+    PIE6bits.CCP4IE = 1;
+    T5CONbits.ON = 1;
+}
+
+/* Minute marker: hand over the minute just finished if it is complete. */
+static void MSF_Marker(void) {
+    if (s_framing && s_seconds >= 58u && s_seconds <= 60u) {
+        s_frame_a_lo = s_a_lo;
+        s_frame_a_hi = s_a_hi;
+        s_frame_b = s_b;
+        s_frame_ready = true;
+        s_frames_seen++;
+    }
+    s_framing = true;
+    s_seconds = 0;
+}
+
+/* The next second has started: decode the one that just ended. */
+static void MSF_EndSecond(void) {
+    uint8_t a, b;
+
+    if (s_pulse1 > MSF_PULSE_300_MAX && s_pulse1 <= MSF_MARKER_MAX) {
+        return;                 // the marker, already handled
+    }
+    if (s_pulse1 < MSF_PULSE_MIN) {
+        s_framing = false;
+        return;
+    }
+    if (s_pulse1 <= MSF_PULSE_100_MAX) {
+        a = 0;
+        b = 0;
+        if (s_pulse2_start != 0) {
+            uint16_t width = s_pulse2_end - s_pulse2_start;
+            if (s_pulse2_end == 0 || width < MSF_PULSE_MIN || width > MSF_PULSE_100_MAX) {
+                s_framing = false;
+                return;
+            }
+            b = 1;
+        }
+    } else if (s_pulse1 <= MSF_PULSE_200_MAX) {
+        a = 1;
+        b = 0;
+    } else if (s_pulse1 <= MSF_PULSE_300_MAX) {
+        a = 1;
+        b = 1;
+    } else {
+        s_framing = false;
+        return;
+    }
+
+    s_a_hi = (uint16_t)((s_a_hi << 1) | (uint16_t)(s_a_lo >> 31));
+    s_a_lo = (s_a_lo << 1) | a;
+    s_b = (uint8_t)((s_b << 1) | b);
+    if (s_seconds < 0xFF) {
+        s_seconds++;
+    }
+}
+
+/* One receiver edge, elapsed counts since the previous one. */
+static void MSF_Edge(bool carrier_off, uint16_t elapsed) {
+    s_offset = (s_offset > 0xFFFFu - elapsed) ? 0xFFFFu : (uint16_t)(s_offset + elapsed);
+
+    if (carrier_off) {
+        if (s_in_sync && s_offset >= MSF_SECOND_MIN && s_offset <= MSF_SECOND_MAX) {
+            MSF_EndSecond();
+        } else if (s_in_sync && s_pulse1 >= MSF_PULSE_MIN && s_pulse1 <= MSF_PULSE_100_MAX &&
+                   s_pulse2_start == 0 &&
+                   s_offset >= MSF_B_START_MIN && s_offset <= MSF_B_START_MAX) {
+            s_pulse2_start = s_offset;
+            return;
+        } else {
+            /* Noise or a dropped second: start again from this edge. */
+            s_in_sync = true;
+            s_framing = false;
+        }
+        s_offset = 0;
+        s_pulse1 = 0;
+        s_pulse2_start = 0;
+        s_pulse2_end = 0;
+    } else if (s_in_sync) {
+        if (s_pulse1 == 0) {
+            s_pulse1 = s_offset ? s_offset : 1u;
+            if (s_pulse1 > MSF_PULSE_300_MAX && s_pulse1 <= MSF_MARKER_MAX) {
+                MSF_Marker();
+            }
+        } else if (s_pulse2_start != 0 && s_pulse2_end == 0) {
+            s_pulse2_end = s_offset;
+        } else {
+            s_framing = false;  // stray edge
+        }
+    }
+}
+
+void MSF_Isr(void) {
+    bool edge = PIE6bits.CCP4IE && PIR6bits.CCP4IF;
+    uint16_t capture = 0;
+
+    if (edge) {
+        capture = CCPR4L;
+        capture |= (uint16_t)CCPR4H << 8;
+    }
+    /* With both pending, the overflow came first unless the capture is
+     * still in the top half of the count. */
+    if (PIE5bits.TMR5IE && PIR5bits.TMR5IF && !(edge && capture >= 0x8000u)) {
+        PIR5bits.TMR5IF = 0;
+        if (++s_wraps >= 2u) {
+            s_wraps = 2;        // 2.1-4.2 s without an edge: signal lost
+            s_in_sync = false;
+            s_framing = false;
+        }
+    }
+    if (edge) {
+        uint32_t elapsed = ((uint32_t)s_wraps << 16) + capture - s_last_capture;
+
+        PIR6bits.CCP4IF = 0;
+        s_last_capture = capture;
+        s_wraps = 0;
+        MSF_Edge(MSF_PIN == MSF_CARRIER_OFF_LEVEL,
+                 (elapsed > 0xFFFFu) ? 0xFFFFu : (uint16_t)elapsed);
+    }
+}
+
+/* A bits of seconds first..first+count-1, first second most significant. */
+static uint8_t MSF_Bits(uint32_t lo, uint16_t hi, uint8_t first, uint8_t count) {
+    uint8_t value = 0;
+
+    for (uint8_t s = first; s < first + count; s++) {
+        uint8_t pos = (uint8_t)(59u - s);
+        uint8_t bit = (pos < 32u) ? (uint8_t)(lo >> pos) : (uint8_t)(hi >> (pos - 32u));
+        value = (uint8_t)((value << 1) | (bit & 1u));
+    }
+    return value;
+}
+
+static uint8_t MSF_Ones(uint8_t v) {
+    uint8_t n = 0;
+
+    while (v) {
+        n += v & 1u;
+        v >>= 1;
+    }
+    return n;
+}
+
+static bool MSF_IsBCD(uint8_t b, uint8_t min, uint8_t max) {
+    return (b & 0x0Fu) <= 9u && b >= min && b <= max;
+}
+
+/* Minute identifier, odd parity (field bits plus its B bit), ranges. */
+static bool MSF_Decode(uint32_t lo, uint16_t hi, uint8_t b, MsfTime *t) {
+    if (MSF_Bits(lo, hi, 52, 8) != 0x7E) {
+        return false;
+    }
+    t->year = MSF_Bits(lo, hi, 17, 8);
+    t->month = MSF_Bits(lo, hi, 25, 5);
+    t->day = MSF_Bits(lo, hi, 30, 6);
+    t->weekday = MSF_Bits(lo, hi, 36, 3);
+    t->hours = MSF_Bits(lo, hi, 39, 6);
+    t->minutes = MSF_Bits(lo, hi, 45, 7);
+    t->summer = (b >> 1) & 1u;                                  // 58B
+
+    if (((MSF_Ones(t->year) + ((b >> 5) & 1u)) & 1u) == 0 ||    // 54B
+        ((MSF_Ones(t->month) + MSF_Ones(t->day) + ((b >> 4) & 1u)) & 1u) == 0 ||
+        ((MSF_Ones(t->weekday) + ((b >> 3) & 1u)) & 1u) == 0 ||
+        ((MSF_Ones(t->hours) + MSF_Ones(t->minutes) + ((b >> 2) & 1u)) & 1u) == 0) {
+        return false;
+    }
+    return MSF_IsBCD(t->year, 0x00, 0x99) && MSF_IsBCD(t->month, 0x01, 0x12) &&
+           MSF_IsBCD(t->day, 0x01, 0x31) && t->weekday <= 6u &&
+           MSF_IsBCD(t->hours, 0x00, 0x23) && MSF_IsBCD(t->minutes, 0x00, 0x59);
+}
+
+bool MSF_GetTime(MsfTime *time) {
+    uint32_t lo;
+    uint16_t hi;
+    uint8_t b;
+    uint16_t minute;
+    bool confirmed;
+
+    if (!s_frame_ready) {
+        return false;
+    }
+    uint8_t giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    lo = s_frame_a_lo;
+    hi = s_frame_a_hi;
+    b = s_frame_b;
+    s_frame_ready = false;
+    INTCONbits.GIEL = giel_save;
+
+    if (!MSF_Decode(lo, hi, b, time)) {
+        s_have_prev = false;
+        return false;
+    }
+    s_frames_good++;
+
+    /* Parity is one bit per field: only trust two frames in sequence. */
+    minute = (uint16_t)BCD_ToBin(time->hours) * MINUTES_PER_HOUR + BCD_ToBin(time->minutes);
+    confirmed = s_have_prev &&
+                minute == (s_prev_minute + 1u) % MINUTES_PER_DAY &&
+                (minute == 0 || time->day == s_prev_day);
+    s_have_prev = true;
+    s_prev_minute = minute;
+    s_prev_day = time->day;
+    return confirmed;
+}
+
+uint16_t MSF_GetFramesSeen(void) {
+    return s_frames_seen;
+}
+
+uint16_t MSF_GetFramesGood(void) {
+    return s_frames_good;
+}
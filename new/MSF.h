@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * File:   MSF.h
+ * Purpose: MSF 60 kHz (Anthorn, UK) time-code decoder. The receiver's
+ *          digital output drives CCP4 in capture mode; pulse widths are
+ *          measured and decoded into A/B bits in the low-priority ISR, one
+ *          second at a time. The main loop collects each finished minute
+ *          frame with MSF_GetTime, which never waits.
+ ******************************************************************************/
+
+#ifndef MSF_H
+#define MSF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* One decoded frame: UK civil time at the minute marker that ended it. */
+typedef struct {
+    uint8_t year;       /* packed BCD 0x00-0x99 (20xx) */
+    uint8_t month;      /* packed BCD 0x01-0x12 */
+    uint8_t day;        /* packed BCD 0x01-0x31 */
+    uint8_t weekday;    /* 0=Sun..6=Sat */
+    uint8_t hours;      /* packed BCD 0x00-0x23 */
+    uint8_t minutes;    /* packed BCD 0x00-0x59 */
+    bool    summer;     /* BST in force */
+} MsfTime;
+
+/** Receiver input on RD3, Timer5 (LFINTOSC) timebase, CCP4 on both edges. */
+void MSF_Init(void);
+
+/**
+ * True once per newly confirmed minute: the frame passed the minute
+ * identifier, all four parity checks and range checks, and follows on by
+ * exactly one minute from the previous good frame. Does not block.
+ */
+bool MSF_GetTime(MsfTime *time);
+
+/** Frames that arrived complete, and those that then passed validation. */
+uint16_t MSF_GetFramesSeen(void);
+uint16_t MSF_GetFramesGood(void);
+
+/** Low-priority ISR hook: CCP4 capture edges and Timer5 overflow. */
+void MSF_Isr(void);
+
+#endif /* MSF_H */
@@ -6,49 +6,129 @@
 #include "Config.h"
 #include "Timer.h"
 #include "ADC.h"
+#include "Comparator.h"
+#include "Lux.h"
 #include "LEDS.h"
+#include "Light.h"
 #include "LCD.h"
 #include "Buttons.h"
 #include "Calendar.h"
+#include "DST.h"
+#include "Schedule.h"
+#include "Logger.h"
+#include "Journal.h"
+#include "UART.h"
+#include "Profile.h"
+#include "Latency.h"
+#include "Modbus.h"
+#include "BCD.h"
+#include "Persist.h"
+#include "Watchdog.h"
+#include "MSF.h"
+#include "GPS.h"
+#include "Discipline.h"
+#include "Dimmer.h"
+#include "CRC.h"
+#include "FlashCheck.h"
+#include "TimeSync.h"
+#include "Response.h"
 #include <stdbool.h>
 
 // PIC Configuration
 #pragma config FEXTOSC = HS
 #pragma config RSTOSC = EXTOSC_4PLL
-#pragma config WDTE = OFF
+#pragma config WDTE = SWDTEN        // Enabled by Watchdog_Start after start-up
+#pragma config WDTCPS = WDTCPS_12   // 1:131072 of LFINTOSC = 4 s
+#pragma config WDTCWS = WDTCWS_3    // Window open for the last 50%
+#pragma config WDTCCS = LFINTOSC
 
 #define _XTAL_FREQ 64000000
 #define BLINK_MS 300
 #define NUM_SAMPLES 32
+#define SECONDS_PER_DAY 86400UL
+
+/* Hot state, read or written on every main-loop pass. __near places it in
+ * the access bank, so none of these accesses needs a BSR switch (build with
+ * -maddrqual=require, see Config.h). Everything else is banked. */
+typedef struct {
+    uint8_t hours;          /* time of day, packed BCD 0x00-0x23 */
+    uint8_t minutes;        /* 0x00-0x59 */
+    uint8_t seconds;        /* 0x00-0x59 */
+    bool    is_dark;
+    bool    light_on;
+    int16_t threshold_clx;  /* dark/light midpoint, centi-log10 lux */
+    int16_t light_clx;      /* g_light as centi-log10 lux */
+} HotState;
+
+/* Main-loop copies of the counters, to see what has moved since the last pass. */
+typedef struct {
+    uint32_t last_second;   /* clock seconds */
+    uint32_t last_sensor;
+    uint32_t last_heartbeat;    /* ticks */
+    uint8_t  last_displayed_second;
+    uint8_t  last_level;
+} LoopState;
+
+static __near HotState g_hot = {0x00, 0x00, 0x00, false, false, 100, 100};
+static __near LoopState g_loop;
 
-static uint16_t g_threshold = 512;      /* midpoint between dark and light */
 static bool     g_dark_above = true;    /* true if dark ADC value > light ADC value */
 
-static uint8_t g_hours = 0;
-static uint8_t g_minutes = 0;
-static uint8_t g_seconds = 0;
+static uint16_t g_light = 512;          /* last averaged LDR reading */
+static uint32_t g_startup_us = 0;      /* reset to first lamp decision */
+static bool     g_log_dumping = false;  /* console 'g' dump in progress */
 
-static bool g_is_dark = false;
-static bool g_dst_active = false;
-static bool g_dst_fall_back_done = false;
+/* Every interrupt source but Timer0 and the 1PPS edge (Timer.c) is low
+ * priority and can be pre-empted by the tick. */
+void __interrupt(low_priority) LowISR(void) {
+    Modbus_Isr();
+    Light_Isr();
+    ADC_Isr();
+    Comparator_Isr();
+    Journal_Isr();
+    LCD_Isr();
+#ifdef MSF_ENABLED
+    MSF_Isr();
+#endif
+#ifdef GPS_ENABLED
+    GPS_Isr();
+#endif
+#ifdef PROFILE_ENABLED
+    if (PIR5bits.TMR1IF) {
+        PIR5bits.TMR1IF = 0;
+        Profile_Timer1Overflow();
+    }
+#endif
+}
 
 static void AdvanceTimeOneSecond(void) {
-    g_seconds++;
-    if (g_seconds >= SECONDS_PER_MINUTE) {
-        g_seconds = 0;
-        g_minutes++;
-        if (g_minutes >= MINUTES_PER_HOUR) {
-            g_minutes = 0;
-            g_hours++;
-            if (g_hours >= HOURS_PER_DAY) {
-                g_hours = 0;
+    g_hot.seconds = BCD_Inc(g_hot.seconds);
+    if (g_hot.seconds >= 0x60) {
+        g_hot.seconds = 0x00;
+        g_hot.minutes = BCD_Inc(g_hot.minutes);
+        if (g_hot.minutes >= 0x60) {
+            g_hot.minutes = 0x00;
+            g_hot.hours = BCD_Inc(g_hot.hours);
+            if (g_hot.hours >= 0x24) {
+                g_hot.hours = 0x00;
                 Calendar_AdvanceDay();
-                g_dst_fall_back_done = false;
+                DST_NewDay();
+                Schedule_Compile();
             }
         }
     }
 }
 
+/* Called at hh:00:00 of today's DST switch hour: shift the wall clock. */
+static void ApplyDST(void) {
+    int16_t minute = (int16_t)BCD_ToBin(g_hot.hours) * MINUTES_PER_HOUR + DST_Apply();
+
+    g_hot.hours = BCD_FromBin((uint8_t)(minute / MINUTES_PER_HOUR));
+    g_hot.minutes = BCD_FromBin((uint8_t)(minute % MINUTES_PER_HOUR));
+    g_hot.seconds = 0x00;
+    Journal_Write(JOURNAL_DST, DST_IsActive());
+}
+
 static uint16_t ReadLDR_Averaged(void) {
     uint32_t sum = 0;
     for (uint8_t i = 0; i < NUM_SAMPLES; i++) {
@@ -58,15 +138,177 @@ static uint16_t ReadLDR_Averaged(void) {
     return (uint16_t)(sum / NUM_SAMPLES);
 }
 
-void main(void) {
-    uint16_t dark_value, light_value;
+/* Dark at or below the threshold; light again only LUX_HYST_CLX above it. */
+static bool IsDark(int16_t light_clx) {
+    if (g_hot.is_dark) {
+        return light_clx < g_hot.threshold_clx + LUX_HYST_CLX;
+    }
+    return light_clx <= g_hot.threshold_clx;
+}
 
-    LEDs_Init();
-    ADC_Init();
-    Buttons_Init();
-    LCD_Init();
+static void SetThreshold(int16_t threshold_clx) {
+    g_hot.threshold_clx = threshold_clx;
+#ifdef DARK_DETECT_COMPARATOR
+    Comparator_SetThreshold(Lux_ToAdc(threshold_clx), Lux_ToAdc(threshold_clx + LUX_HYST_CLX));
+#endif
+}
+
+uint16_t Modbus_ReadRegister(uint8_t addr) {
+    switch (addr) {
+    case MB_REG_HOURS:      return BCD_ToBin(g_hot.hours);
+    case MB_REG_MINUTES:    return BCD_ToBin(g_hot.minutes);
+    case MB_REG_SECONDS:    return BCD_ToBin(g_hot.seconds);
+    case MB_REG_DAY:        return Calendar_GetDay();
+    case MB_REG_MONTH:      return Calendar_GetMonth();
+    case MB_REG_YEAR:       return Calendar_GetYear();
+    case MB_REG_DST:        return DST_IsActive();
+    case MB_REG_LDR:        return g_light;
+    case MB_REG_THRESHOLD:  return Lux_ToAdc(g_hot.threshold_clx);
+    case MB_REG_LAMP:       return g_hot.light_on;
+    case MB_REG_SAVE_START: return Schedule_GetRule(0)->start / MINUTES_PER_HOUR;
+    case MB_REG_SAVE_END:   return Schedule_GetRule(0)->end / MINUTES_PER_HOUR;
+    case MB_REG_TIME_SCALE: return Timer_GetTimeScale();
+    case MB_REG_DST_ZONE:   return DST_GetZone();
+    case MB_REG_LAMP_LEVEL: return Light_GetLevel();
+    case MB_REG_ENERGY_USED:  return Light_GetEnergyUsed();
+    case MB_REG_ENERGY_SAVED: return (uint16_t)Light_GetEnergySaved();
+    case MB_REG_LDR2:       return ADC_GetFiltered(ADC_CH_LDR2);
+    case MB_REG_SUPPLY_MV:  return ADC_GetSupply_mV();
+    case MB_REG_TEMP_RAW:   return ADC_GetFiltered(ADC_CH_TEMP);
+    case MB_REG_STARTUP_MS: /* cold starts include calibration: saturate */
+        return (g_startup_us >= 65535000UL) ? 0xFFFF : (uint16_t)(g_startup_us / 1000u);
+#ifdef MSF_ENABLED
+    case MB_REG_MSF_FRAMES: return MSF_GetFramesGood();
+#endif
+#ifdef GPS_ENABLED
+    case MB_REG_GPS_LAT:
+    case MB_REG_GPS_LON: {
+        int16_t lat, lon;
+        if (!GPS_GetPosition(&lat, &lon)) {
+            return 0;
+        }
+        return (uint16_t)((addr == MB_REG_GPS_LAT) ? lat : lon);
+    }
+#endif
+#ifdef PPS_DISCIPLINE
+    case MB_REG_CLOCK_TRIM: return (uint16_t)Discipline_GetTrim_dppm();
+    case MB_REG_PPS_STATE:  return Discipline_GetState();
+#endif
+#ifdef FLASH_CHECK
+    case MB_REG_FLASH_CHECK: return FlashCheck_GetState();
+#endif
+#ifdef TIME_SYNC
+    case MB_REG_SYNC_TIME_HI:
+    case MB_REG_SYNC_TIME_LO:
+    case MB_REG_SYNC_PHASE:
+    case MB_REG_SYNC_DST:
+    case MB_REG_SYNC_SCHEDULE: return TimeSync_GetField((uint8_t)(addr - MB_REG_SYNC_TIME_HI));
+    case MB_REG_SYNC_STATE:  return TimeSync_GetState();
+    case MB_REG_SYNC_OFFSET: return (uint16_t)TimeSync_GetOffset_ms();
+    case MB_REG_SYNC_MISMATCH: return TimeSync_GetMismatch();
+#endif
+    case MB_REG_SCHEDULE_VERSION: return Schedule_GetVersion();
+    case MB_REG_LUX:        return Lux_ToLux(g_hot.light_clx);
+    case MB_REG_LOG_LUX:    return (uint16_t)g_hot.light_clx;
+    case MB_REG_THRESHOLD_LUX: return Lux_ToLux(g_hot.threshold_clx);
+#ifdef DIMMING_ENABLED
+    case MB_REG_DIM_SETPOINT: return Dimmer_GetSetpoint();
+    case MB_REG_DIM_MEASURED: return Dimmer_GetMeasured();
+#endif
+    default:                return 0;
+    }
+}
+
+/* Value already passed Modbus_CheckRegister. */
+static bool WriteRegister(uint8_t addr, uint16_t value) {
+    switch (addr) {
+    case MB_REG_THRESHOLD:
+        SetThreshold(Lux_FromAdc(value));
+        return true;
+    case MB_REG_THRESHOLD_LUX:
+        SetThreshold(Lux_FromLux(value));
+        return true;
+#ifdef DIMMING_ENABLED
+    case MB_REG_DIM_SETPOINT:
+        Dimmer_SetSetpoint(value);
+        return true;
+#endif
+    case MB_REG_SAVE_START:
+    case MB_REG_SAVE_END: {
+        /* The hour registers edit the base (every-day) rule. */
+        ScheduleRule rule = *Schedule_GetRule(0);
+        if (addr == MB_REG_SAVE_START) {
+            rule.start = value * MINUTES_PER_HOUR;
+        } else {
+            rule.end = value * MINUTES_PER_HOUR;
+        }
+        return Schedule_SetRule(0, &rule);
+    }
+    case MB_REG_TIME_SCALE:
+        return Timer_SetTimeScale(value) != 0;
+    default:
+        return false;
+    }
+}
+
+bool Modbus_CheckRegister(uint8_t addr, uint16_t value) {
+    switch (addr) {
+    case MB_REG_THRESHOLD:      return value <= 1023u;
+    case MB_REG_THRESHOLD_LUX:  return value != 0u;
+#ifdef DIMMING_ENABLED
+    case MB_REG_DIM_SETPOINT:   return value != 0u;
+#endif
+    case MB_REG_SAVE_START:
+    case MB_REG_SAVE_END:       return value < HOURS_PER_DAY;
+    case MB_REG_TIME_SCALE:     return value != 0u && value <= TIME_SCALE_MAX;
+#ifdef TIME_SYNC
+    case MB_REG_SYNC_TIME_HI:
+    case MB_REG_SYNC_TIME_LO:
+    case MB_REG_SYNC_PHASE:
+    case MB_REG_SYNC_DST:
+    case MB_REG_SYNC_SCHEDULE:  return true;
+#endif
+    default:                    return false;
+    }
+}
+
+bool Modbus_WriteRegister(uint8_t addr, uint16_t value) {
+    if (!Modbus_CheckRegister(addr, value)) {
+        return false;
+    }
+#ifdef TIME_SYNC
+    if (addr >= MB_REG_SYNC_TIME_HI && addr <= MB_REG_SYNC_SCHEDULE) {
+        return TimeSync_Write((uint8_t)(addr - MB_REG_SYNC_TIME_HI), value);
+    }
+#endif
+    if (!WriteRegister(addr, value)) {
+        return false;
+    }
+    Journal_Write(JOURNAL_CONFIG, addr);
+    return true;
+}
+
+/* Snapshot for a warm restart after a WDT or brown-out reset. */
+static void SaveState(void) {
+    PersistState s;
+
+    s.hours = g_hot.hours;
+    s.minutes = g_hot.minutes;
+    s.seconds = g_hot.seconds;
+    s.day = Calendar_GetDay();
+    s.month = Calendar_GetMonth();
+    s.year = Calendar_GetYear();
+    s.threshold_clx = g_hot.threshold_clx;
+    s.dark_above = g_dark_above;
+    s.dst_zone = DST_GetZone();
+    s.dst_active = DST_IsActive();
+    Persist_Save(&s);
+}
+
+/* Two-step RF2 calibration: dark then light */
+static void Calibrate(void) {
+    uint16_t dark_value, light_value;
 
-    /* Two-step RF2 calibration: dark then light */
     while (1) {
         LEDs_SetMainLight(1);
         __delay_ms(BLINK_MS);
@@ -91,120 +333,395 @@ void main(void) {
     }
     __delay_ms(50);
 
-    g_threshold = (dark_value + light_value) / 2u;
     g_dark_above = (dark_value > light_value);
+    Lux_Init(g_dark_above);
+    /* Midpoint in log-lux: the geometric mean of the two light levels. */
+    g_hot.threshold_clx = (int16_t)((Lux_FromAdc(dark_value) + Lux_FromAdc(light_value)) / 2);
+    Journal_Write(JOURNAL_CALIBRATION, (uint16_t)g_hot.threshold_clx);
+}
 
-    Timer_Init();
-    Calendar_Init(START_YEAR, START_MONTH, START_DAY);
-    g_dst_active = Calendar_IsDST();
+/* Current local time as minutes since 00:00 1 Jan CALENDAR_EPOCH_YEAR. */
+static uint32_t EpochMinute(void) {
+    return (uint32_t)Calendar_DaysSinceEpoch() * (MINUTES_PER_HOUR * HOURS_PER_DAY) +
+           (uint16_t)BCD_ToBin(g_hot.hours) * MINUTES_PER_HOUR + BCD_ToBin(g_hot.minutes);
+}
 
-    {
-        uint16_t light = ADC_ReadLDR();
-        if (g_dark_above) {
-            g_is_dark = (light <= g_threshold);
+static uint32_t EpochSecond(void) {
+    return EpochMinute() * SECONDS_PER_MINUTE + BCD_ToBin(g_hot.seconds);
+}
+
+/* Set date, time and summer-time state together from a UTC time source.
+ * Runs between main-loop steps, so nothing ever sees a half-set clock.
+ * Sources repeat every minute or second: only a real step is logged. */
+static void SetClock(uint16_t year, uint8_t month, uint8_t day,
+                     int16_t utc_minute, uint8_t seconds, uint8_t source) {
+    uint32_t before = EpochSecond();
+    uint16_t before_day = Calendar_DaysSinceEpoch();
+    uint16_t local;
+    uint32_t after;
+
+    if (year < CALENDAR_EPOCH_YEAR || day == 0 || day > Calendar_DaysInMonth(year, month)) {
+        return;                 /* not a date: a bad frame never moves the clock */
+    }
+    Calendar_Init(year, month, day);
+    local = DST_FromUTC(DST_GetZone(), utc_minute);
+    g_hot.hours = BCD_FromBin((uint8_t)(local / MINUTES_PER_HOUR));
+    g_hot.minutes = BCD_FromBin((uint8_t)(local % MINUTES_PER_HOUR));
+    g_hot.seconds = seconds;
+
+    if (Calendar_DaysSinceEpoch() != before_day) {
+        Schedule_Compile();
+    }
+    after = EpochSecond();
+    if (after > before + 1u || before > after + 1u) {
+        Journal_SetMinute(EpochMinute());
+        Journal_Write(JOURNAL_CLOCK_SET, source);
+        SaveState();
+    }
+}
+
+/* As SetClock, from UTC seconds since 1 Jan CALENDAR_EPOCH_YEAR. */
+static void SetClockUtc(uint32_t utc, uint8_t source) {
+    uint32_t second_of_day = utc % SECONDS_PER_DAY;
+    uint16_t year;
+    uint8_t month, day;
+
+    Calendar_FromDays((uint16_t)(utc / SECONDS_PER_DAY), &year, &month, &day);
+    SetClock(year, month, day, (int16_t)(second_of_day / SECONDS_PER_MINUTE),
+             BCD_FromBin((uint8_t)(second_of_day % SECONDS_PER_MINUTE)), source);
+}
+
+/* Console 'g': the flash history, oldest first, a few records per pass so
+ * the loop and the watchdog keep running through a whole ring. A page that
+ * fills mid-dump may skip or repeat records around it. */
+static void LogDumpTask(void) {
+    LogRecord rec;
+
+    for (uint8_t i = 0; g_log_dumping && i < LOG_DUMP_PER_PASS; i++) {
+        if (!Logger_DumpNext(&rec)) {
+            g_log_dumping = false;
+            UART_WriteString("log end\r\n");
         } else {
-            g_is_dark = (light >= g_threshold);
+            UART_WriteUInt(rec.minute);
+            UART_WriteString(rec.type == LOG_REC_LAMP ? " lamp=" : " ldr=");
+            UART_WriteUInt(rec.value);
+            UART_WriteString("\r\n");
         }
-        if (g_is_dark) {
-            g_hours = 0;
-            g_minutes = 0;
+    }
+}
+
+void main(void) {
+    PersistState saved;
+    bool warm;
+
+    /* Start-up runs in parallel: the timebase starts first, the LCD
+     * power-on sequence then steps itself from Timer3 while the ADC
+     * settles and the persistent state is checked. */
+    Timer_Init();
+    LCD_Begin();
+    LEDs_Init();
+    Light_Init();
+    ADC_Init();
+    Buttons_Init();
+    UART_Init();
+    CRC_Init();
+    warm = Persist_Load(&saved);    /* before Journal_Init clears PCON0 */
+    Journal_Init();
+
+    if (warm) {
+        /* WDT or brown-out reset with valid RAM state: resume in a few ms,
+         * no calibration, no time guess. */
+        g_hot.threshold_clx = saved.threshold_clx;
+        g_dark_above = saved.dark_above;
+        Lux_Init(g_dark_above);
+    } else {
+        Calibrate();
+    }
+
+    Modbus_Init();
+    if (warm) {
+        Calendar_Init(saved.year, saved.month, saved.day);
+    } else {
+        Calendar_Init(START_YEAR, START_MONTH, START_DAY);
+    }
+    Schedule_Init();
+    Logger_Init();
+
+    {
+        g_light = ADC_ReadLDR();
+        g_hot.light_clx = Lux_FromAdc(g_light);
+        g_hot.is_dark = IsDark(g_hot.light_clx);
+        if (warm) {
+            g_hot.hours = saved.hours;
+            g_hot.minutes = saved.minutes;
+            g_hot.seconds = saved.seconds;
         } else {
-            g_hours = 12;
-            g_minutes = 0;
+            if (g_hot.is_dark) {
+                g_hot.hours = 0x00;
+                g_hot.minutes = 0x00;
+            } else {
+                g_hot.hours = 0x12;
+                g_hot.minutes = 0x00;
+            }
+            g_hot.seconds = 0x00;
         }
-        g_seconds = 0;
     }
+    if (warm) {
+        DST_Restore(saved.dst_zone, g_hot.hours, saved.dst_active);
+    } else {
+        DST_Init(DST_ZONE, g_hot.hours);
+    }
+    SaveState();
+    Journal_SetMinute(EpochMinute());
+#ifdef DIMMING_ENABLED
+    Dimmer_Init();
+#endif
+    ADC_StartScan();
+#ifdef DARK_DETECT_COMPARATOR
+    /* Same dark/light rule as the ADC compare above: g_dark_above means
+     * dark is the higher reading, so dark_when_low is its inverse. */
+    Comparator_Init(Lux_ToAdc(g_hot.threshold_clx), Lux_ToAdc(g_hot.threshold_clx + LUX_HYST_CLX),
+                    !g_dark_above);
+#endif
+#ifdef MSF_ENABLED
+    MSF_Init();
+#endif
+#ifdef GPS_ENABLED
+    GPS_Init();
+#endif
+#ifdef PPS_DISCIPLINE
+    Discipline_Init();
+#endif
+#ifdef FLASH_CHECK
+    FlashCheck_Init();
+#endif
+#ifdef TIME_SYNC
+    TimeSync_Init();
+#endif
 
-    uint32_t last_sensor = Timer_GetTicks();
-    uint32_t last_heartbeat = Timer_GetTicks();
-    uint32_t last_tick = Timer_GetTicks();
+    g_loop.last_sensor = Timer_GetClockSeconds();
+    g_loop.last_heartbeat = Timer_GetTicks();
+    g_loop.last_second = g_loop.last_sensor;
+    g_loop.last_displayed_second = 0xFF;
+    g_loop.last_level = LIGHT_LEVEL_OFF;
+
+    Profile_Init();
+    Watchdog_Start(Timer_GetTicks());
 
     while (1) {
+        Profile_Begin(PROF_LOOP);
+        Profile_Begin(PROF_TIMEKEEPING);
+
         uint32_t now = Timer_GetTicks();
-        bool time_advanced = false;
-
-#ifdef TEST_MODE
-        if (now - last_tick >= TICKS_PER_HOUR) {
-            last_tick += TICKS_PER_HOUR;
-            g_hours++;
-            if (g_hours >= HOURS_PER_DAY) {
-                g_hours = 0;
-                Calendar_AdvanceDay();
-                g_dst_fall_back_done = false;
+        uint32_t clock_now = Timer_GetClockSeconds();
+
+        /* Step the clock one second at a time, whatever the time scale, so
+         * accelerated runs execute the same minute-level logic. */
+        bool stepped = (g_loop.last_second != clock_now);
+        while (g_loop.last_second != clock_now) {
+            g_loop.last_second++;
+            AdvanceTimeOneSecond();
+            Light_AccountSecond(g_hot.is_dark,
+                                Schedule_IsSaving((uint16_t)BCD_ToBin(g_hot.hours) * MINUTES_PER_HOUR +
+                                                  BCD_ToBin(g_hot.minutes)));
+            if (g_hot.seconds == 0x00) {
+                Journal_SetMinute(EpochMinute());
+            }
+            if (g_hot.hours == 0x12 && g_hot.minutes == 0x00 && g_hot.seconds == 0x00) {
+                Light_EndNight();
+                Response_EndNight();
+            }
+            if (g_hot.minutes == 0x00 && g_hot.seconds == 0x00) {
+                Profile_Begin(PROF_DST);
+                if (g_hot.hours == DST_SwitchHour()) {
+                    ApplyDST();
+                }
+                Profile_End(PROF_DST);
             }
-            g_minutes = 0;
-            g_seconds = 0;
-            time_advanced = true;
         }
-#else
-        if (now - last_tick >= TICKS_PER_SECOND) {
-            last_tick += TICKS_PER_SECOND;
-            AdvanceTimeOneSecond();
-            time_advanced = (g_minutes == 0);
+        if (stepped) {
+            SaveState();
+        }
+        /* Time sources; demo time scales keep their own clock. */
+#ifdef MSF_ENABLED
+        {
+            /* MSF sends UK civil time: BST is UTC + 1 h. */
+            MsfTime msf;
+            if (MSF_GetTime(&msf) && Timer_GetTimeScale() == 1) {
+                int16_t utc = (int16_t)(BCD_ToBin(msf.hours) * MINUTES_PER_HOUR +
+                                        BCD_ToBin(msf.minutes)) - (msf.summer ? 60 : 0);
+                SetClock(CALENDAR_EPOCH_YEAR + BCD_ToBin(msf.year),
+                         BCD_ToBin(msf.month), BCD_ToBin(msf.day),
+                         utc, 0x00, JOURNAL_SRC_MSF);
+            }
         }
 #endif
-
-        if (time_advanced) {
-            if (g_hours == 1 && !g_dst_active &&
-                Calendar_GetMonth() == 3 && Calendar_GetDay() == Calendar_LastSundayOfMarch()) {
-                g_hours = 2;
-                g_minutes = 0;
-                g_seconds = 0;
-                g_dst_active = true;
+#ifdef GPS_ENABLED
+        {
+            /* The sentences set the clock on the first fix and then check
+             * it once a minute; the 1PPS discipline keeps the phase. */
+            static bool gps_set = false;
+            GpsTime gps;
+            if (GPS_GetTime(&gps) && Timer_GetTimeScale() == 1 &&
+                (!gps_set || gps.seconds == 0x00)) {
+                gps_set = true;
+                SetClock(CALENDAR_EPOCH_YEAR + BCD_ToBin(gps.year),
+                         BCD_ToBin(gps.month), BCD_ToBin(gps.day),
+                         (int16_t)(BCD_ToBin(gps.hours) * MINUTES_PER_HOUR + BCD_ToBin(gps.minutes)),
+                         gps.seconds, JOURNAL_SRC_GPS);
             }
-            if (g_hours == 2 && g_dst_active && !g_dst_fall_back_done &&
-                Calendar_GetMonth() == 10 && Calendar_GetDay() == Calendar_LastSundayOfOctober()) {
-                g_hours = 1;
-                g_minutes = 0;
-                g_seconds = 0;
-                g_dst_active = false;
-                g_dst_fall_back_done = true;
+        }
+#endif
+#ifdef TIME_SYNC
+        {
+            /* Bus time sync: the master sends, a follower slews to it and
+             * gets whole seconds back only when far out. */
+            uint32_t utc = EpochSecond() - (uint32_t)((int32_t)DST_UtcOffset() * SECONDS_PER_MINUTE);
+            int32_t step = TimeSync_Task(g_loop.last_second, utc);
+            if (step != 0) {
+                SetClockUtc(utc + (uint32_t)step, JOURNAL_SRC_SYNC);
             }
         }
+#endif
+        Profile_End(PROF_TIMEKEEPING);
 
-        LEDs_SetClockDisplay(g_hours);
+        uint8_t hours = BCD_ToBin(g_hot.hours);
 
-        static uint16_t light = 512;
+        Profile_Begin(PROF_CLOCK_LEDS);
+        LEDs_SetClockDisplay(hours);
+        Profile_End(PROF_CLOCK_LEDS);
 
-        if ((now - last_sensor) >= SENSOR_INTERVAL) {
-            last_sensor = now;
-            light = ReadLDR_Averaged();
-            if (g_dark_above) {
-                g_is_dark = (light <= g_threshold);
-            } else {
-                g_is_dark = (light >= g_threshold);
-            }
+        Profile_Begin(PROF_SENSOR);
+        if ((clock_now - g_loop.last_sensor) >= SENSOR_INTERVAL) {
+            g_loop.last_sensor = clock_now;
+            g_light = ADC_GetFiltered(ADC_CH_LDR);    /* background scan */
+            g_hot.light_clx = Lux_FromAdc(g_light);
+#ifndef DARK_DETECT_COMPARATOR
+            g_hot.is_dark = IsDark(g_hot.light_clx);
+#endif
+            Logger_LogLight(EpochMinute(), g_light);
         }
+#ifdef DARK_DETECT_COMPARATOR
+        g_hot.is_dark = Comparator_IsDark();    /* live C1OUT, edges retune the DAC */
+#endif
+        Profile_End(PROF_SENSOR);
 
-        static uint8_t last_displayed_second = 0xFF;
-        static uint8_t last_displayed_hour = 0xFF;
+        Profile_Begin(PROF_LCD);
+        if (g_hot.seconds != g_loop.last_displayed_second && LCD_IsReady()) {
+            LCD_UpdateDisplay(g_hot.hours, g_hot.minutes,
+                             Calendar_GetDayBCD(), Calendar_GetMonthBCD(), Calendar_GetYearBCD(),
+                             DST_ZoneName());
+            g_loop.last_displayed_second = g_hot.seconds;
+        }
+        Profile_End(PROF_LCD);
 
-#ifdef TEST_MODE
-        if (g_hours != last_displayed_hour) {
-            LCD_UpdateDisplay(g_hours, g_minutes,
-                             Calendar_GetDay(), Calendar_GetMonth(), Calendar_GetYear(),
-                             g_dst_active);
-            last_displayed_hour = g_hours;
+        /* Today's compiled schedule: one bit per minute of the day. */
+        bool in_save_window = Schedule_IsSaving((uint16_t)hours * MINUTES_PER_HOUR +
+                                                BCD_ToBin(g_hot.minutes));
+        uint8_t level = LIGHT_LEVEL_OFF;
+        if (g_hot.is_dark) {
+            level = in_save_window ? LIGHT_DIM_LEVEL : LIGHT_LEVEL_FULL;
         }
-#else
-        if (g_seconds != last_displayed_second) {
-            LCD_UpdateDisplay(g_hours, g_minutes,
-                             Calendar_GetDay(), Calendar_GetMonth(), Calendar_GetYear(),
-                             g_dst_active);
-            last_displayed_second = g_seconds;
+        if (level != g_loop.last_level) {
+            g_loop.last_level = level;
+            Journal_Write(JOURNAL_LAMP, level);
         }
+#ifdef DIMMING_ENABLED
+        Dimmer_SetCeiling(level);
+        Profile_Begin(PROF_DIMMER);
+        Dimmer_Task();              /* once per ADC scan round */
+        Profile_End(PROF_DIMMER);
+#else
+        Light_SetLevel(level);      /* ramps in the Timer4 ISR */
 #endif
+        if (g_startup_us == 0) {
+            /* Time to the first lamp decision, reported once. */
+            g_startup_us = Timer_GetUptime_us();
+            UART_WriteString(warm ? "warm start us=" : "cold start us=");
+            UART_WriteUInt(g_startup_us);
+            UART_WriteString("\r\n");
+        }
+        bool light_on = (level != LIGHT_LEVEL_OFF);
+        Response_Task(g_hot.is_dark, g_hot.threshold_clx, g_dark_above);
 
-        bool in_save_window = (g_hours >= ENERGY_SAVE_START_HOUR &&
-                               g_hours < ENERGY_SAVE_END_HOUR);
-        bool light_on = g_is_dark && !in_save_window;
-        LEDs_SetMainLight(light_on);
+        Profile_Begin(PROF_LOGGER);
+        if (light_on != g_hot.light_on) {
+            g_hot.light_on = light_on;
+            Logger_LogLamp(EpochMinute(), light_on);
+        }
+        /* Flash erases and writes stall the CPU: only on a quiet bus, so an
+         * open request never overruns the EUSART2 FIFO. One that starts
+         * mid-stall is still lost; the master's retry covers it. */
+        if (Modbus_IsIdle()) {
+            Logger_Task(now);
+            Journal_Task(now);
+        }
+#ifdef PPS_DISCIPLINE
+        Discipline_Task(now);
+#endif
+#ifdef FLASH_CHECK
+        FlashCheck_Task(now);       /* scans in spare cycles until the next pass */
+#endif
+        Profile_End(PROF_LOGGER);
 
-        if ((now - last_heartbeat) >= (TICKS_PER_SECOND * 2)) {
-            last_heartbeat = now;
+#ifdef HEARTBEAT_HARDWARE
+        LEDs_HeartbeatToken();      /* NCO1/CLC blink, only while the loop runs */
+#else
+        if ((now - g_loop.last_heartbeat) >= (TICKS_PER_SECOND * 2)) {
+            g_loop.last_heartbeat = now;
             LEDs_ToggleHeartbeat();
         }
+#endif
+
+        Modbus_Task();
+
+        /* Console: 'l' ISR latency report, 'p' profile report (debug),
+         * 'j' event journal, 'r' dusk response report, 'g' flash history,
+         * 't' cycle the time scale 1x / 60x / 3600x. */
+        uint8_t cmd;
+        if (UART_ReadByte(&cmd)) {
+            if (cmd == 't') {
+                uint16_t scale = Timer_GetTimeScale();
+                scale = (scale == 1) ? 60 : ((scale == 60) ? 3600 : 1);
+                Timer_SetTimeScale(scale);
+                UART_WriteString("scale=");
+                UART_WriteUInt(scale);
+                UART_WriteString("\r\n");
+            } else if (cmd == 'l') {
+                Latency_Dump();
+                Latency_Reset();
+            } else if (cmd == 'j') {
+                Journal_Dump();
+            } else if (cmd == 'r') {
+                Response_Dump();
+            } else if (cmd == 'p') {
+                Profile_Dump();
+                Profile_Reset();
+            } else if (cmd == 'g') {
+                Logger_DumpBegin();
+                g_log_dumping = true;
+            }
+        }
+        LogDumpTask();
 
+#ifdef PROFILE_ENABLED
+        /* Debug builds: RF2 press dumps the profile over the UART. */
+        static uint8_t last_button = 0;
+        uint8_t button = Button_RF2_Read();
+        if (button && !last_button) {
+            Profile_Dump();
+            Profile_Reset();
+            Latency_Dump();
+        }
+        last_button = button;
+#endif
+
+        Profile_Begin(PROF_DELAY);
         __delay_ms(10);
+        Profile_End(PROF_DELAY);
+
+        /* Liveness: a full pass ran and the tick is advancing. */
+        Watchdog_Feed(now);
+        Profile_End(PROF_LOOP);
     }
 }
@@ -0,0 +1,345 @@
+/*******************************************************************************
+ * File:   Modbus.c
+ * Purpose: Modbus-RTU slave on EUSART2 (see Modbus.h).
+ *          RX ISR: store byte, update CRC, restart Timer2. Timer2 expiry
+ *          (t3.5, fixed 1.75 ms above 19200 baud) closes the frame; a frame
+ *          is accepted when the running CRC over all bytes is zero. The main
+ *          loop decodes and writes the reply over the request, and the TX
+ *          ISR streams it out. Every ISR path is a handful of instructions
+ *          and runs at low priority, so Timer0 (high priority) is never held.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Modbus.h"
+#include "Config.h"
+#include "Timer.h"
+
+#define MB_ADU_MAX          256
+#define MB_MIN_FRAME        4       /* address, function, CRC */
+#define MB_MAX_READ         125
+#define MB_MAX_WRITE        123
+
+#define MB_FC_READ_HOLDING  0x03
+#define MB_FC_WRITE_SINGLE  0x06
+#define MB_FC_WRITE_MULTI   0x10
+
+#define MB_EX_FUNCTION      0x01
+#define MB_EX_ADDRESS       0x02
+#define MB_EX_VALUE         0x03
+
+#define MB_STATE_RX         0       /* receiving / idle */
+#define MB_STATE_READY      1       /* frame waiting for Modbus_Task */
+#define MB_STATE_TX         2       /* TX ISR streaming the reply */
+#define MB_STATE_DRAIN      3       /* last byte queued, wait t3.5 then release bus */
+
+/* Timer2: Fosc/4 / 128 = 8 us per count, 219 counts = 1.75 ms */
+#define MB_T35_COUNTS       219
+
+#define MB_DE               LATDbits.LATD2  // RS-485 driver enable
+
+/* CRC-16/MODBUS (poly 0xA001 reflected, init 0xFFFF), one entry per byte. */
+static const uint16_t CRC_TABLE[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+static uint8_t s_frame[MB_ADU_MAX];
+static volatile uint16_t s_len = 0;
+static volatile uint16_t s_crc = 0xFFFF;
+static volatile uint16_t s_tx_pos = 0;
+static volatile uint8_t s_state = MB_STATE_RX;
+static volatile bool s_overflow = false;
+static volatile bool s_heard = false;       /* bus activity since the last Modbus_Broadcast try */
+static uint32_t s_rx_second;                /* when the READY frame's gap timer expired */
+static uint16_t s_rx_counts;
+
+static void GapTimerRestart(void) {
+    T2TMR = 0;
+    T2CONbits.ON = 1;
+}
+
+static void RxReset(void) {
+    s_len = 0;
+    s_crc = 0xFFFF;
+    s_overflow = false;
+}
+
+void Modbus_Init(void) {
+    // EUSART2: TX on RD0, RX from RD1, driver enable on RD2
+    RD0PPS = 0x0E;
+    RX2PPS = 0x19;
+    ANSELDbits.ANSELD0 = 0;
+    ANSELDbits.ANSELD1 = 0;
+    ANSELDbits.ANSELD2 = 0;
+    TRISDbits.TRISD0 = 0;
+    TRISDbits.TRISD1 = 1;
+    TRISDbits.TRISD2 = 0;
+    MB_DE = 0;
+
+    // 64 MHz / (4 * (138 + 1)) = 115108 baud
+    BAUD2CONbits.BRG16 = 1;
+    TX2STAbits.BRGH = 1;
+    SP2BRGL = 138;
+    SP2BRGH = 0;
+    TX2STAbits.TXEN = 1;
+    RC2STAbits.CREN = 1;
+    RC2STAbits.SPEN = 1;
+
+    // Timer2: one-shot t3.5 gap timer, restarted by every received byte
+    T2CONbits.ON = 0;
+    T2CLKCON = 0b0001;          // Fosc/4
+    T2CONbits.CKPS = 0b111;     // 1:128
+    T2CONbits.OUTPS = 0;        // 1:1
+    T2HLT = 0;                  // Free-running, software gated
+    T2PR = MB_T35_COUNTS - 1;
+    T2TMR = 0;
+
+    RxReset();
+    s_state = MB_STATE_RX;
+
+    // Low priority: Timer0 (high priority) pre-empts all of this
+    IPR3bits.RC2IP = 0;
+    IPR3bits.TX2IP = 0;
+    IPR5bits.TMR2IP = 0;
+    PIR5bits.TMR2IF = 0;
+    PIE5bits.TMR2IE = 1;
+    PIE3bits.RC2IE = 1;
+}
+
+void Modbus_Isr(void) {
+    if (PIE3bits.RC2IE && PIR3bits.RC2IF) {
+        uint8_t framing = RC2STAbits.FERR;
+        uint8_t b = RC2REG;
+
+        if (RC2STAbits.OERR) {
+            RC2STAbits.CREN = 0;
+            RC2STAbits.CREN = 1;
+            s_overflow = true;
+        }
+        GapTimerRestart();
+        s_heard = true;
+        if (s_state == MB_STATE_RX) {
+            if (framing || s_len >= MB_ADU_MAX) {
+                s_overflow = true;
+            } else {
+                s_frame[s_len++] = b;
+                s_crc = (s_crc >> 8) ^ CRC_TABLE[(uint8_t)(s_crc ^ b)];
+            }
+        }
+    }
+
+    if (PIE3bits.TX2IE && PIR3bits.TX2IF) {
+        TX2REG = s_frame[s_tx_pos++];
+        if (s_tx_pos >= s_len) {
+            PIE3bits.TX2IE = 0;
+            s_state = MB_STATE_DRAIN;
+            GapTimerRestart();
+        }
+    }
+
+    if (PIR5bits.TMR2IF) {
+        PIR5bits.TMR2IF = 0;
+        T2CONbits.ON = 0;
+        if (s_state == MB_STATE_RX) {
+            /* Silence for t3.5: frame complete. Keep it only if it is ours. */
+            if (!s_overflow && s_len >= MB_MIN_FRAME && s_crc == 0 &&
+                (s_frame[0] == MODBUS_SLAVE_ADDRESS || s_frame[0] == 0)) {
+                Timer_GetStamp(&s_rx_second, &s_rx_counts);
+                s_state = MB_STATE_READY;
+            } else {
+                RxReset();
+            }
+        } else if (s_state == MB_STATE_DRAIN) {
+            /* Both TX buffers have long emptied; hand the bus back. */
+            MB_DE = 0;
+            RC2STAbits.CREN = 1;
+            RxReset();
+            s_state = MB_STATE_RX;
+        }
+    }
+}
+
+static uint16_t Get16(const uint8_t *p) {
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+static void Put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static uint8_t Exception(uint8_t code) {
+    s_frame[1] |= 0x80;
+    s_frame[2] = code;
+    return 3;
+}
+
+/* Decode the request in s_frame and overwrite it with the reply PDU.
+ * Returns the reply length without CRC. */
+static uint8_t Process(uint8_t len) {
+    uint16_t start = Get16(&s_frame[2]);
+    uint16_t qty;
+
+    switch (s_frame[1]) {
+    case MB_FC_READ_HOLDING:
+        if (len != 6) {
+            return Exception(MB_EX_VALUE);
+        }
+        qty = Get16(&s_frame[4]);
+        if (qty == 0 || qty > MB_MAX_READ) {
+            return Exception(MB_EX_VALUE);
+        }
+        if (start + qty > MB_REG_COUNT) {
+            return Exception(MB_EX_ADDRESS);
+        }
+        s_frame[2] = (uint8_t)(qty * 2u);
+        for (uint8_t i = 0; i < qty; i++) {
+            Put16(&s_frame[3 + 2 * i], Modbus_ReadRegister((uint8_t)(start + i)));
+        }
+        return (uint8_t)(3 + qty * 2u);
+
+    case MB_FC_WRITE_SINGLE:
+        if (len != 6) {
+            return Exception(MB_EX_VALUE);
+        }
+        if (start >= MB_REG_COUNT) {
+            return Exception(MB_EX_ADDRESS);
+        }
+        if (!Modbus_WriteRegister((uint8_t)start, Get16(&s_frame[4]))) {
+            return Exception(MB_EX_VALUE);
+        }
+        return 6;               /* echo of the request */
+
+    case MB_FC_WRITE_MULTI:
+        qty = Get16(&s_frame[4]);
+        if (len < 7 || qty == 0 || qty > MB_MAX_WRITE ||
+            s_frame[6] != qty * 2u || len != 7u + qty * 2u) {
+            return Exception(MB_EX_VALUE);
+        }
+        if (start + qty > MB_REG_COUNT) {
+            return Exception(MB_EX_ADDRESS);
+        }
+        /* All or nothing: one bad value and none is written. */
+        for (uint8_t i = 0; i < qty; i++) {
+            if (!Modbus_CheckRegister((uint8_t)(start + i), Get16(&s_frame[7 + 2 * i]))) {
+                return Exception(MB_EX_VALUE);
+            }
+        }
+        for (uint8_t i = 0; i < qty; i++) {
+            (void)Modbus_WriteRegister((uint8_t)(start + i), Get16(&s_frame[7 + 2 * i]));
+        }
+        return 6;               /* address, function, start, quantity */
+
+    default:
+        return Exception(MB_EX_FUNCTION);
+    }
+}
+
+/* Append the CRC to the len bytes in s_frame and start sending them. */
+static void Transmit(uint8_t len) {
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ CRC_TABLE[(uint8_t)(crc ^ s_frame[i])];
+    }
+    s_frame[len] = (uint8_t)crc;            /* CRC goes low byte first */
+    s_frame[len + 1] = (uint8_t)(crc >> 8);
+
+    /* Half duplex: receiver off while we drive the bus. */
+    RC2STAbits.CREN = 0;
+    MB_DE = 1;
+    s_len = (uint16_t)len + 2u;
+    s_tx_pos = 0;
+    s_state = MB_STATE_TX;
+    PIE3bits.TX2IE = 1;
+}
+
+void Modbus_Task(void) {
+    if (s_state != MB_STATE_READY) {
+        return;
+    }
+
+    bool broadcast = (s_frame[0] == 0);
+    uint8_t reply = Process((uint8_t)(s_len - 2u));
+
+    if (broadcast) {
+        RxReset();
+        s_state = MB_STATE_RX;
+        return;
+    }
+    Transmit(reply);
+}
+
+bool Modbus_IsIdle(void) {
+    bool idle;
+
+    uint8_t giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    idle = (s_state == MB_STATE_RX && s_len == 0 && !T2CONbits.ON);
+    INTCONbits.GIEL = giel_save;
+    return idle;
+}
+
+void Modbus_GetFrameTime(uint32_t *seconds, uint16_t *counts) {
+    *seconds = s_rx_second;
+    *counts = s_rx_counts;
+}
+
+bool Modbus_Broadcast(uint8_t start, uint8_t qty, const uint16_t *values) {
+    bool idle;
+
+    /* Claim the buffer only if nothing has been heard since the last try
+     * and no frame is open: a slave answering someone else's request
+     * starts well within one main-loop pass of the request. */
+    uint8_t giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    idle = (s_state == MB_STATE_RX && s_len == 0 && !T2CONbits.ON && !s_heard);
+    s_heard = false;
+    if (idle) {
+        s_state = MB_STATE_TX;          // RX ISR leaves the buffer alone
+    }
+    INTCONbits.GIEL = giel_save;
+    if (!idle) {
+        return false;
+    }
+
+    s_frame[0] = 0;
+    s_frame[1] = MB_FC_WRITE_MULTI;
+    Put16(&s_frame[2], start);
+    Put16(&s_frame[4], qty);
+    s_frame[6] = (uint8_t)(qty * 2u);
+    for (uint8_t i = 0; i < qty; i++) {
+        Put16(&s_frame[7 + 2 * i], values[i]);
+    }
+    Transmit((uint8_t)(7u + qty * 2u));
+    return true;
+}
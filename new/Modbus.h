@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * File:   Modbus.h
+ * Purpose: Modbus-RTU slave on EUSART2 (RS-485, 115200 8N1) for SCADA
+ *          polling. Bytes are received straight into the frame buffer by the
+ *          RX interrupt, the end of frame is found with Timer2 (t3.5 gap),
+ *          and the reply is built in place in the same buffer.
+ *          Supported functions: 03 read, 06 write single, 16 write multiple
+ *          holding registers. A time-sync master (TimeSync.c) also sends
+ *          broadcast 16s on the same bus.
+ ******************************************************************************/
+
+#ifndef MODBUS_H
+#define MODBUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Holding register map (addresses are 0-based on the wire). */
+#define MB_REG_HOURS        0   /* R  local time */
+#define MB_REG_MINUTES      1   /* R */
+#define MB_REG_SECONDS      2   /* R */
+#define MB_REG_DAY          3   /* R  date */
+#define MB_REG_MONTH        4   /* R */
+#define MB_REG_YEAR         5   /* R */
+#define MB_REG_DST          6   /* R  1 = summer time */
+#define MB_REG_LDR          7   /* R  last averaged LDR reading (0-1023) */
+#define MB_REG_THRESHOLD    8   /* RW dark/light threshold as an LDR reading (0-1023) */
+#define MB_REG_LAMP         9   /* R  1 = main light on */
+#define MB_REG_SAVE_START   10  /* RW base energy-save rule start hour (0-23) */
+#define MB_REG_SAVE_END     11  /* RW base energy-save rule end hour (0-23) */
+#define MB_REG_TIME_SCALE   12  /* RW clock seconds per real second (1-3600) */
+#define MB_REG_DST_ZONE     13  /* R  DST rule set (DST_ZONE_*) */
+#define MB_REG_LAMP_LEVEL   14  /* R  main light brightness (0-255) */
+#define MB_REG_ENERGY_USED  15  /* R  tonight, full-power minutes */
+#define MB_REG_ENERGY_SAVED 16  /* R  tonight vs the on/off policy with save-window cut, full-power minutes (int16) */
+#define MB_REG_LDR2         17  /* R  redundant LDR, filtered (0-1023) */
+#define MB_REG_SUPPLY_MV    18  /* R  VDD from the FVR channel */
+#define MB_REG_TEMP_RAW     19  /* R  temperature indicator, raw ADC */
+#define MB_REG_STARTUP_MS   20  /* R  reset to first lamp decision, ms */
+#define MB_REG_MSF_FRAMES   21  /* R  MSF minute frames that passed validation */
+#define MB_REG_GPS_LAT      22  /* R  GPS latitude, 0.01 degree, north positive (int16) */
+#define MB_REG_GPS_LON      23  /* R  GPS longitude, 0.01 degree, east positive (int16) */
+#define MB_REG_CLOCK_TRIM   24  /* R  timebase correction, 0.1 ppm, + = slowed (int16) */
+#define MB_REG_PPS_STATE    25  /* R  DISC_* (none, holdover, tracking, locked) */
+#define MB_REG_LUX          26  /* R  light level, lux (saturates at 65535) */
+#define MB_REG_LOG_LUX      27  /* R  light level, centi-log10 lux (int16, 0 = 1 lux) */
+#define MB_REG_THRESHOLD_LUX 28 /* RW dark/light threshold, lux (1-65535) */
+#define MB_REG_DIM_SETPOINT 29  /* RW constant-illuminance setpoint, lux (1-65535) */
+#define MB_REG_DIM_MEASURED 30  /* R  illuminance on the dimming sensor, lux */
+#define MB_REG_FLASH_CHECK  31  /* R  FLASH_CHECK_* (pending, good, bad, no stored CRC) */
+/* Time-sync block: one broadcast 16 of all five (TimeSync.h); reads give the last received */
+#define MB_REG_SYNC_TIME_HI 32  /* RW master UTC, seconds since 1 Jan 2000, high word */
+#define MB_REG_SYNC_TIME_LO 33  /* RW low word */
+#define MB_REG_SYNC_PHASE   34  /* RW 16 us counts into that second when sending began */
+#define MB_REG_SYNC_DST     35  /* RW 1 = summer time in force at the master */
+#define MB_REG_SYNC_SCHEDULE 36 /* RW master's schedule version */
+#define MB_REG_SYNC_STATE   37  /* R  TSYNC_* (none, slewing, locked, lost, master) */
+#define MB_REG_SYNC_OFFSET  38  /* R  last measured offset, ms, + = this clock was behind (int16) */
+#define MB_REG_SYNC_MISMATCH 39 /* R  TSYNC_MISMATCH_* bits: DST state, schedule version */
+#define MB_REG_SCHEDULE_VERSION 40 /* R  this controller's schedule version */
+#define MB_REG_COUNT        41
+
+/** Configure EUSART2, the RS-485 driver enable pin and the Timer2 gap timer. */
+void Modbus_Init(void);
+
+/** Low-priority ISR hook: services EUSART2 RX/TX and Timer2 flags. */
+void Modbus_Isr(void);
+
+/** Main loop: answer a completed request, if any. */
+void Modbus_Task(void);
+
+/**
+ * True with no request open or waiting, no reply going out and t3.5 of
+ * silence since the last byte. A program-flash erase or write stalls the
+ * CPU for about 2.5 ms, far longer than the 2-byte EUSART2 FIFO lasts at
+ * 115200 baud, so the main loop holds its flash work until this is true.
+ */
+bool Modbus_IsIdle(void);
+
+/**
+ * Timer_GetStamp taken when the request being handled was closed by the
+ * t3.5 gap, i.e. 1.75 ms after its last byte. Valid inside the
+ * Modbus_ReadRegister/WriteRegister calls.
+ */
+void Modbus_GetFrameTime(uint32_t *seconds, uint16_t *counts);
+
+/**
+ * Broadcast (address 0) a write-multiple of qty registers from start, as a
+ * bus master would; no slave replies. Sent only when the bus has been
+ * silent since the previous call, so call it again on false.
+ */
+bool Modbus_Broadcast(uint8_t start, uint8_t qty, const uint16_t *values);
+
+/* Implemented by the application (Main.c); called from Modbus_Task. */
+
+/** Value of holding register addr (addr < MB_REG_COUNT). */
+uint16_t Modbus_ReadRegister(uint8_t addr);
+
+/** Write holding register addr. Returns false if read-only or out of range. */
+bool Modbus_WriteRegister(uint8_t addr, uint16_t value);
+
+/**
+ * True if Modbus_WriteRegister would accept value at addr; writes nothing.
+ * A write-multiple checks every register before it writes any.
+ */
+bool Modbus_CheckRegister(uint8_t addr, uint16_t value);
+
+#endif /* MODBUS_H */
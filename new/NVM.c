@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * File:   NVM.c
+ * Purpose: Self-programming driver for the PIC18F66K40 program flash.
+ *          Reads go through the table pointer; erase and write use the
+ *          NVMCON2 0x55/0xAA unlock with interrupts off for the unlock only.
+ *          The journal's brown-out flush writes flash from the low-priority
+ *          ISR, so every sequence that sets TBLPTR, NVMADR or NVMCON1 and
+ *          then uses them runs with GIEL off: the flush waits for it to end
+ *          instead of changing them under it. The tick is never held.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "NVM.h"
+#include "Latency.h"
+
+static void NVM_SetTablePointer(uint32_t address) {
+    TBLPTRU = (uint8_t)(address >> 16);
+    TBLPTRH = (uint8_t)(address >> 8);
+    TBLPTRL = (uint8_t)address;
+}
+
+/* Unlock and start the operation selected in NVMCON1. CPU stalls until done. */
+static void NVM_Unlock(void) {
+    uint8_t gie_save = INTCONbits.GIE;
+    uint8_t tag = g_latency_tag;
+
+    Latency_Tag(LAT_TAG_NVM);
+    NVMCON1bits.WREN = 1;
+    INTCONbits.GIE = 0;
+    NVMCON2 = 0x55;
+    NVMCON2 = 0xAA;
+    NVMCON1bits.WR = 1;
+    INTCONbits.GIE = gie_save;
+    NVMCON1bits.WREN = 0;
+    Latency_Tag(tag);
+}
+
+uint8_t NVM_FlashReadByte(uint32_t address) {
+    uint8_t giel_save = INTCONbits.GIEL;
+    uint8_t value;
+
+    INTCONbits.GIEL = 0;
+    NVM_SetTablePointer(address);
+    asm("TBLRD");
+    value = TABLAT;
+    INTCONbits.GIEL = giel_save;
+    return value;
+}
+
+void NVM_FlashRead(uint32_t address, uint8_t *buf, uint8_t len) {
+    uint8_t giel_save = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    NVM_SetTablePointer(address);
+    for (uint8_t i = 0; i < len; i++) {
+        asm("TBLRDPOSTINC");
+        buf[i] = TABLAT;
+    }
+    INTCONbits.GIEL = giel_save;
+}
+
+/* A background EEPROM write must finish before NVMCON1 is reused. */
+static void NVM_WaitIdle(void) {
+    while (NVMCON1bits.WR) {
+    }
+}
+
+void NVM_FlashEraseRow(uint32_t address) {
+    uint8_t giel_save;
+
+    NVM_WaitIdle();
+    giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    NVM_SetTablePointer(address & ~(uint32_t)(NVM_FLASH_ROW_SIZE - 1u));
+    NVMCON1bits.NVMREG = 2;   // Program flash
+    NVMCON1bits.FREE = 1;     // Row erase
+    NVM_Unlock();
+    INTCONbits.GIEL = giel_save;
+}
+
+static void NVM_SetEEAddress(uint16_t address) {
+    NVMADRH = (uint8_t)(address >> 8);
+    NVMADRL = (uint8_t)address;
+    NVMCON1bits.NVMREG = 0;   // Data EEPROM
+}
+
+uint8_t NVM_EERead(uint16_t address) {
+    uint8_t giel_save;
+    uint8_t value;
+
+    NVM_WaitIdle();
+    giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    NVM_SetEEAddress(address);
+    NVMCON1bits.RD = 1;
+    value = NVMDAT;
+    INTCONbits.GIEL = giel_save;
+    return value;
+}
+
+void NVM_EEWrite(uint16_t address, uint8_t value) {
+    uint8_t giel_save;
+
+    NVM_WaitIdle();
+    giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    NVM_SetEEAddress(address);
+    NVMDAT = value;
+    NVMCON1bits.FREE = 0;
+    NVM_Unlock();             // No stall: WR clears when the write is done
+    INTCONbits.GIEL = giel_save;
+}
+
+bool NVM_EEBusy(void) {
+    return NVMCON1bits.WR != 0;
+}
+
+void NVM_FlashWriteRow(uint32_t address, const uint8_t *buf) {
+    uint8_t giel_save;
+
+    NVM_WaitIdle();
+    giel_save = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    NVM_SetTablePointer(address & ~(uint32_t)(NVM_FLASH_ROW_SIZE - 1u));
+
+    /* Fill the holding latches; last byte must not advance past the row. */
+    for (uint8_t i = 0; i < NVM_FLASH_ROW_SIZE; i++) {
+        TABLAT = buf[i];
+        if (i == (NVM_FLASH_ROW_SIZE - 1u)) {
+            asm("TBLWT");
+        } else {
+            asm("TBLWTPOSTINC");
+        }
+    }
+
+    NVMCON1bits.NVMREG = 2;   // Program flash
+    NVMCON1bits.FREE = 0;     // Write, not erase
+    NVM_Unlock();
+    INTCONbits.GIEL = giel_save;
+}
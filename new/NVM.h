@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * File:   NVM.h
+ * Purpose: Self-programming driver for the PIC18F66K40 program flash
+ *          (table read, row erase, row write through the NVMCON unlock)
+ *          and the 1 KB data EEPROM.
+ ******************************************************************************/
+
+#ifndef NVM_H
+#define NVM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Program flash erase/write row on the K40: 64 words = 128 bytes. */
+#define NVM_FLASH_ROW_SIZE  128u
+
+/** Read one byte of program flash at the given address. */
+uint8_t NVM_FlashReadByte(uint32_t address);
+
+/** Read len bytes of program flash starting at address into buf. */
+void NVM_FlashRead(uint32_t address, uint8_t *buf, uint8_t len);
+
+/**
+ * Erase the row containing address (all bytes read back as 0xFF).
+ * The CPU stalls for the erase time (~2-3 ms); interrupts are held off
+ * only for the unlock sequence (low-priority ones for the whole call), so
+ * call it just after a Timer0 tick.
+ */
+void NVM_FlashEraseRow(uint32_t address);
+
+/**
+ * Write one full row from buf to the (already erased) row at address.
+ * Same stall as NVM_FlashEraseRow.
+ */
+void NVM_FlashWriteRow(uint32_t address, const uint8_t *buf);
+
+/** Read one byte of data EEPROM (address 0-0x3FF). */
+uint8_t NVM_EERead(uint16_t address);
+
+/**
+ * Start writing one byte of data EEPROM. The write runs on in the
+ * background (~4 ms); poll NVM_EEBusy before starting the next one.
+ */
+void NVM_EEWrite(uint16_t address, uint8_t value);
+bool NVM_EEBusy(void);
+
+#endif /* NVM_H */
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * File:   Persist.c
+ * Purpose: Warm-restart state in a __persistent RAM block (not cleared by
+ *          the C start-up code), guarded by a CRC-16/CCITT from the
+ *          hardware CRC engine (CRC.c).
+ ******************************************************************************/
+
+#include <xc.h>
+#include <string.h>
+#include "Persist.h"
+#include "CRC.h"
+
+typedef struct {
+    PersistState state;
+    uint16_t crc;
+} PersistBlock;
+
+static __persistent PersistBlock s_block;
+
+static uint16_t Persist_Crc(const PersistState *state) {
+    return CRC_Block(state, sizeof(PersistState));
+}
+
+bool Persist_Load(PersistState *state) {
+    if (!PCON0bits.nPOR) {
+        return false;           // Power-on: RAM contents are random
+    }
+    if (Persist_Crc(&s_block.state) != s_block.crc) {
+        return false;
+    }
+    memcpy(state, &s_block.state, sizeof(PersistState));
+    return true;
+}
+
+void Persist_Save(const PersistState *state) {
+    s_block.state = *state;
+    s_block.crc = Persist_Crc(state);
+}
@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * File:   Persist.h
+ * Purpose: Clock and calibration state kept in non-initialised RAM with a
+ *          CRC, so a watchdog or brown-out reset resumes where it left off
+ *          instead of recalibrating and guessing the time.
+ ******************************************************************************/
+
+#ifndef PERSIST_H
+#define PERSIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint8_t  hours;         /* packed BCD */
+    uint8_t  minutes;
+    uint8_t  seconds;
+    uint8_t  day;           /* binary */
+    uint8_t  month;
+    uint16_t year;
+    int16_t  threshold_clx; /* centi-log10 lux */
+    uint8_t  dark_above;
+    uint8_t  dst_zone;
+    uint8_t  dst_active;
+} PersistState;
+
+/**
+ * Copy the preserved state into state. Returns true only after a reset
+ * that kept RAM (not power-on) and when the CRC matches. Call before
+ * anything clears the PCON0 reset flags (Journal_Init).
+ */
+bool Persist_Load(PersistState *state);
+
+/** Store state and its CRC (every clock second from the main loop). */
+void Persist_Save(const PersistState *state);
+
+#endif /* PERSIST_H */
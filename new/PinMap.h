@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * File:   PinMap.h
+ * Purpose: Board pin map. Multi-pin groups are X-macro tables; the drivers
+ *          derive per-port masks from them at compile time, so each update
+ *          is at most one masked write per physical port, and moving a pin
+ *          is a one-line change to its table entry.
+ *
+ *          A table is TABLE(X, v) and each entry X(v, bit index in the
+ *          value, port letter, pin number): v carries the value being
+ *          written through to the callbacks that need it.
+ ******************************************************************************/
+
+#ifndef PINMAP_H
+#define PINMAP_H
+
+#include <xc.h>
+#include <stdint.h>
+
+/* Binary clock: hour bit i -> LED. */
+#define CLOCK_PINS(X, v) \
+    X(v, 0, G, 0)   /* LED 1: RG0 */ \
+    X(v, 1, G, 1)   /* LED 2: RG1 */ \
+    X(v, 2, A, 2)   /* LED 3: RA2 */ \
+    X(v, 3, F, 6)   /* LED 4: RF6 */ \
+    X(v, 4, A, 4)   /* LED 5: RA4 */
+
+/* LCD 4-bit data bus: nibble bit i -> D4..D7. */
+#define LCD_DATA_PINS(X, v) \
+    X(v, 0, B, 3)   /* D4: RB3 */ \
+    X(v, 1, B, 2)   /* D5: RB2 */ \
+    X(v, 2, E, 3)   /* D6: RE3 */ \
+    X(v, 3, E, 1)   /* D7: RE1 */
+
+/* LCD control lines (single pins). */
+#define LCD_RS  LATCbits.LATC6    // Register Select: 0=command, 1=data
+#define LCD_E   LATCbits.LATC2    // Enable: pulse this to send data
+#define LCD_RS_TRIS TRISCbits.TRISC6
+#define LCD_E_TRIS  TRISCbits.TRISC2
+
+/* ---- Table machinery ------------------------------------------------------ */
+
+#define PORT_ID_A   0
+#define PORT_ID_B   1
+#define PORT_ID_C   2
+#define PORT_ID_D   3
+#define PORT_ID_E   4
+#define PORT_ID_F   5
+#define PORT_ID_G   6
+
+/* Mask of the table's pins on port P, and the bits to set there for
+ * value. Both fold to constants or bit tests; no loop and no per-pin
+ * read-modify-write. */
+#define PINMAP_MASK_TERM(P, port, bit) \
+    | ((PORT_ID_##port == PORT_ID_##P) ? (uint8_t)(1u << (bit)) : 0u)
+#define PINMAP_VALUE_TERM(P, value, i, port, bit) \
+    | (((PORT_ID_##port == PORT_ID_##P) && ((value) & (1u << (i)))) ? (uint8_t)(1u << (bit)) : 0u)
+
+#define PINMAP_MASK_A(v, i, port, bit)  PINMAP_MASK_TERM(A, port, bit)
+#define PINMAP_MASK_B(v, i, port, bit)  PINMAP_MASK_TERM(B, port, bit)
+#define PINMAP_MASK_C(v, i, port, bit)  PINMAP_MASK_TERM(C, port, bit)
+#define PINMAP_MASK_D(v, i, port, bit)  PINMAP_MASK_TERM(D, port, bit)
+#define PINMAP_MASK_E(v, i, port, bit)  PINMAP_MASK_TERM(E, port, bit)
+#define PINMAP_MASK_F(v, i, port, bit)  PINMAP_MASK_TERM(F, port, bit)
+#define PINMAP_MASK_G(v, i, port, bit)  PINMAP_MASK_TERM(G, port, bit)
+
+#define PINMAP_VALUE_A(v, i, port, bit) PINMAP_VALUE_TERM(A, v, i, port, bit)
+#define PINMAP_VALUE_B(v, i, port, bit) PINMAP_VALUE_TERM(B, v, i, port, bit)
+#define PINMAP_VALUE_C(v, i, port, bit) PINMAP_VALUE_TERM(C, v, i, port, bit)
+#define PINMAP_VALUE_D(v, i, port, bit) PINMAP_VALUE_TERM(D, v, i, port, bit)
+#define PINMAP_VALUE_E(v, i, port, bit) PINMAP_VALUE_TERM(E, v, i, port, bit)
+#define PINMAP_VALUE_F(v, i, port, bit) PINMAP_VALUE_TERM(F, v, i, port, bit)
+#define PINMAP_VALUE_G(v, i, port, bit) PINMAP_VALUE_TERM(G, v, i, port, bit)
+
+#define PINMAP_MASK(TABLE, P)           ((uint8_t)(0u TABLE(PINMAP_MASK_##P, 0u)))
+#define PINMAP_VALUE(TABLE, P, value)   ((uint8_t)(0u TABLE(PINMAP_VALUE_##P, value)))
+
+/* One masked write to LATP; compiled out when the table has no pin on P. */
+#define PINMAP_WRITE_PORT(TABLE, P, value) \
+    if (PINMAP_MASK(TABLE, P) != 0u) { \
+        LAT##P = (uint8_t)((LAT##P & (uint8_t)~PINMAP_MASK(TABLE, P)) | PINMAP_VALUE(TABLE, P, value)); \
+    }
+
+/* Drive every pin of TABLE from the bits of value. value is read once per
+ * pin, so pass a variable or a constant, not an expression with effects. */
+#define PINMAP_WRITE(TABLE, value) do { \
+    PINMAP_WRITE_PORT(TABLE, A, value) PINMAP_WRITE_PORT(TABLE, B, value) \
+    PINMAP_WRITE_PORT(TABLE, C, value) PINMAP_WRITE_PORT(TABLE, D, value) \
+    PINMAP_WRITE_PORT(TABLE, E, value) PINMAP_WRITE_PORT(TABLE, F, value) \
+    PINMAP_WRITE_PORT(TABLE, G, value) \
+} while (0)
+
+/* X callback: make the pin a digital output. Use as TABLE(PINMAP_INIT_OUTPUT, 0). */
+#define PINMAP_INIT_OUTPUT(v, i, port, bit) \
+    ANSEL##port##bits.ANSEL##port##bit = 0; \
+    TRIS##port##bits.TRIS##port##bit = 0;
+
+#endif /* PINMAP_H */
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * File:   Profile.c
+ * Purpose: Cycle-count profiler for named main-loop regions (see Profile.h).
+ *          Per region: call count, min, max, running average and a log2
+ *          histogram of durations. The cost of one Begin/End pair is
+ *          measured at init and subtracted from every sample.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Profile.h"
+#include "UART.h"
+
+#ifdef PROFILE_ENABLED
+
+#define HIST_BUCKETS    16
+#define HIST_MIN_LOG2   6       /* bucket 0: < 2^7 cycles, bucket 15: >= 2^21 */
+#define HIST_BAR_WIDTH  32
+
+typedef struct {
+    uint32_t start;
+    uint32_t calls;
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;               /* sum / sum_n is the average; both halve on overflow */
+    uint32_t sum_n;
+    uint16_t hist[HIST_BUCKETS];
+} ProfileRegion;
+
+static const char * const REGION_NAMES[PROF_REGION_COUNT] = {
+    "loop", "time", "dst", "clockled", "sensor", "lcd", "logger", "delay",
+    "dimmer"
+};
+
+static ProfileRegion s_regions[PROF_REGION_COUNT];
+static volatile uint16_t s_overflows = 0;
+static uint32_t s_overhead = 0;
+
+void Profile_Timer1Overflow(void) {
+    s_overflows++;
+}
+
+/* 32-bit cycle count: overflow counter in the high word, TMR1 in the low. */
+static uint32_t Profile_Now(void) {
+    uint16_t high;
+    uint16_t low;
+
+    do {
+        high = s_overflows;
+        low = TMR1L;                    // Reading TMR1L latches TMR1H (RD16)
+        low |= (uint16_t)TMR1H << 8;
+        /* Wrapped but the ISR has not run yet. */
+        if (PIR5bits.TMR1IF && low < 0x8000u) {
+            high++;
+        }
+    } while (high != s_overflows && !PIR5bits.TMR1IF);
+
+    return ((uint32_t)high << 16) | low;
+}
+
+static uint8_t HistBucket(uint32_t cycles) {
+    uint8_t log2 = 0;
+
+    while (cycles > 1u) {
+        cycles >>= 1;
+        log2++;
+    }
+    if (log2 <= HIST_MIN_LOG2) {
+        return 0;
+    }
+    log2 -= HIST_MIN_LOG2;
+    return (log2 >= HIST_BUCKETS) ? (HIST_BUCKETS - 1) : log2;
+}
+
+void Profile_Reset(void) {
+    for (uint8_t r = 0; r < PROF_REGION_COUNT; r++) {
+        ProfileRegion *p = &s_regions[r];
+        p->calls = 0;
+        p->min = 0xFFFFFFFFUL;
+        p->max = 0;
+        p->sum = 0;
+        p->sum_n = 0;
+        for (uint8_t b = 0; b < HIST_BUCKETS; b++) {
+            p->hist[b] = 0;
+        }
+    }
+}
+
+void Profile_Init(void) {
+    /* Timer1 already runs (Timer_Init); left as it is, since the Timer0
+     * ISR timestamps against it. */
+    PIR5bits.TMR1IF = 0;
+    IPR5bits.TMR1IP = 0;        // Low priority: never delays the Timer0 tick
+    PIE5bits.TMR1IE = 1;
+    INTCONbits.GIEL = 1;
+    T1CONbits.ON = 1;
+
+    Profile_Reset();
+
+    /* Cost of an empty Begin/End pair. */
+    Profile_Begin(PROF_LOOP);
+    s_overhead = Profile_Now() - s_regions[PROF_LOOP].start;
+}
+
+void Profile_Begin(uint8_t region) {
+    Latency_Tag(region);
+    s_regions[region].start = Profile_Now();
+}
+
+void Profile_End(uint8_t region) {
+    uint32_t cycles = Profile_Now();
+    ProfileRegion *p = &s_regions[region];
+
+    Latency_Tag(PROF_LOOP);
+    cycles -= p->start;
+    cycles = (cycles > s_overhead) ? (cycles - s_overhead) : 0;
+
+    p->calls++;
+    if (cycles < p->min) {
+        p->min = cycles;
+    }
+    if (cycles > p->max) {
+        p->max = cycles;
+    }
+    if (p->sum + cycles < p->sum) {
+        p->sum >>= 1;
+        p->sum_n >>= 1;
+    }
+    p->sum += cycles;
+    p->sum_n++;
+
+    uint8_t b = HistBucket(cycles);
+    if (p->hist[b] != 0xFFFFu) {
+        p->hist[b]++;
+    }
+}
+
+void Profile_Dump(void) {
+    UART_WriteString("\r\nPROFILE cycles @ Fosc/4 (16 per us)\r\n");
+
+    for (uint8_t r = 0; r < PROF_REGION_COUNT; r++) {
+        const ProfileRegion *p = &s_regions[r];
+        uint16_t peak = 0;
+
+        UART_WriteString(REGION_NAMES[r]);
+        UART_WriteString(" calls=");
+        UART_WriteUInt(p->calls);
+        if (p->calls == 0) {
+            UART_WriteString("\r\n");
+            continue;
+        }
+        UART_WriteString(" min=");
+        UART_WriteUInt(p->min);
+        UART_WriteString(" avg=");
+        UART_WriteUInt(p->sum / p->sum_n);
+        UART_WriteString(" max=");
+        UART_WriteUInt(p->max);
+        UART_WriteString("\r\n");
+
+        for (uint8_t b = 0; b < HIST_BUCKETS; b++) {
+            if (p->hist[b] > peak) {
+                peak = p->hist[b];
+            }
+        }
+        for (uint8_t b = 0; b < HIST_BUCKETS; b++) {
+            if (p->hist[b] == 0) {
+                continue;
+            }
+            UART_WriteString("  <2^");
+            UART_WriteUInt((uint32_t)b + HIST_MIN_LOG2 + 1u);
+            UART_WriteByte(' ');
+            UART_WriteUInt(p->hist[b]);
+            UART_WriteByte(' ');
+            uint8_t bar = (uint8_t)(((uint32_t)p->hist[b] * HIST_BAR_WIDTH + peak - 1u) / peak);
+            while (bar--) {
+                UART_WriteByte('#');
+            }
+            UART_WriteString("\r\n");
+        }
+    }
+}
+
+#endif /* PROFILE_ENABLED */
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * File:   Profile.h
+ * Purpose: Cycle-count profiler for named main-loop regions. Timer1 free-runs
+ *          at Fosc/4 (16 cycles per us) and is extended to 32 bits by its
+ *          (low-priority) overflow interrupt. Only built when PROFILE_ENABLED is defined
+ *          (debug builds, see Config.h); otherwise only the latency region
+ *          tag store of Profile_Begin/End remains.
+ ******************************************************************************/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include "Config.h"
+#include "Latency.h"
+
+/* Region ids, also used as Latency.h region tags. Keep REGION_NAMES in
+ * Profile.c and TAG_NAMES in Latency.c in the same order. */
+#define PROF_LOOP           0   /* one full main-loop pass */
+#define PROF_TIMEKEEPING    1
+#define PROF_DST            2
+#define PROF_CLOCK_LEDS     3
+#define PROF_SENSOR         4
+#define PROF_LCD            5
+#define PROF_LOGGER         6
+#define PROF_DELAY          7
+#define PROF_DIMMER         8   /* one illuminance control step */
+#define PROF_REGION_COUNT   9
+
+#ifdef PROFILE_ENABLED
+
+/** Count Timer1 (started by Timer_Init) overflows and clear all statistics. */
+void Profile_Init(void);
+
+/** Mark the start of a region (also publishes it as the latency tag). */
+void Profile_Begin(uint8_t region);
+
+/** Mark the end of a region and fold its cycle count into the statistics. */
+void Profile_End(uint8_t region);
+
+/** Called from the ISR on Timer1 overflow. */
+void Profile_Timer1Overflow(void);
+
+/** Print calls/min/avg/max and a log2 histogram per region over the UART. */
+void Profile_Dump(void);
+
+/** Clear all statistics. */
+void Profile_Reset(void);
+
+#else
+
+#define Profile_Init()          ((void)0)
+/* Release: no cycle counting, only the latency region tag is kept. */
+#define Profile_Begin(region)   Latency_Tag(region)
+#define Profile_End(region)     Latency_Tag(PROF_LOOP)
+#define Profile_Dump()          ((void)0)
+#define Profile_Reset()         ((void)0)
+
+#endif /* PROFILE_ENABLED */
+
+#endif /* PROFILE_H */
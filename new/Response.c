@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * File:   Response.c
+ * Purpose: Dusk response statistics (see Response.h). Both ends are
+ *          time-stamped in an ISR, so the main loop only has to collect
+ *          them; its own delay is part of what is measured, not of the
+ *          measurement. The start is only known to the ADC scan period: a
+ *          comparator that fires between scans can switch the lamp before
+ *          the crossing is sampled, which counts as 0 ms.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "Response.h"
+#include "Config.h"
+#include "ADC.h"
+#include "Light.h"
+#include "Lux.h"
+#include "Timer.h"
+#include "UART.h"
+
+#define RESP_IDLE           0   /* waiting for daylight with the lamp off */
+#define RESP_ARMED          1   /* watch set: waiting for the crossing and the lamp */
+
+#define RESP_COUNTS_PER_S   62500L  /* Timer0 counts, 16 us */
+#define RESP_MAX_SECONDS    30000   /* longer is not a dusk response */
+
+static uint8_t  s_state = RESP_IDLE;
+static int16_t  s_armed_clx;
+static bool     s_have_start;
+static bool     s_have_on;
+static uint32_t s_start_second;
+static uint16_t s_start_counts;
+static uint32_t s_on_second;
+static uint16_t s_on_counts;
+
+static uint16_t s_hist[RESP_HIST_BUCKETS];
+static uint16_t s_count = 0;
+static uint32_t s_min_ms = 0xFFFFFFFFUL;
+static uint32_t s_max_ms = 0;
+static uint32_t s_sum_ms = 0;
+
+static bool     s_was_dark = false;
+static uint8_t  s_night_dusks = 0;      /* dark decisions since noon */
+static uint16_t s_nights = 0;
+static uint16_t s_false_toggles = 0;
+static uint8_t  s_worst_night = 0;
+
+static void Response_Record(void) {
+    int32_t seconds = (int32_t)(s_on_second - s_start_second);
+    int32_t counts;
+    uint32_t ms = 0;
+    uint8_t b = 0;
+
+    if (seconds > RESP_MAX_SECONDS) {
+        return;
+    }
+    counts = seconds * RESP_COUNTS_PER_S + (int32_t)s_on_counts - (int32_t)s_start_counts;
+    if (counts > 0) {
+        ms = ((uint32_t)counts * 2u) / 125u;     // 16 us a count
+    }
+
+    while (b < RESP_HIST_BUCKETS - 1 && ms >= (16UL << b)) {
+        b++;
+    }
+    if (s_hist[b] != 0xFFFFu) {
+        s_hist[b]++;
+    }
+    s_count++;
+    s_sum_ms += ms;
+    if (ms < s_min_ms) {
+        s_min_ms = ms;
+    }
+    if (ms > s_max_ms) {
+        s_max_ms = ms;
+    }
+}
+
+/* Raw reading back on the light side of the dawn trip point. */
+static bool Response_ClearlyLight(bool dark_above) {
+    uint16_t x = ADC_GetLatest(ADC_CH_LDR);
+    uint16_t light_trip = Lux_ToAdc(s_armed_clx + LUX_HYST_CLX);
+
+    return dark_above ? (x <= light_trip) : (x >= light_trip);
+}
+
+void Response_Task(bool is_dark, int16_t threshold_clx, bool dark_above) {
+    uint32_t second;
+    uint16_t counts;
+
+    if (is_dark && !s_was_dark && s_night_dusks < 0xFFu) {
+        s_night_dusks++;
+    }
+    s_was_dark = is_dark;
+
+    if (Timer_GetTimeScale() != 1) {
+        s_state = RESP_IDLE;
+        return;
+    }
+
+    switch (s_state) {
+    case RESP_IDLE:
+        Light_GetSwitchOn(&second, &counts);    // drop anything older
+        if (!is_dark && Light_GetLevel() == LIGHT_LEVEL_OFF) {
+            ADC_Watch(ADC_CH_LDR, Lux_ToAdc(threshold_clx), dark_above);
+            s_armed_clx = threshold_clx;
+            s_have_start = false;
+            s_have_on = false;
+            s_state = RESP_ARMED;
+        }
+        break;
+
+    case RESP_ARMED:
+        if (threshold_clx != s_armed_clx) {
+            s_state = RESP_IDLE;                // re-armed at the new level
+            break;
+        }
+        if (!s_have_start && ADC_WatchFired(&s_start_second, &s_start_counts)) {
+            s_have_start = true;
+        }
+        if (!s_have_on && Light_GetSwitchOn(&s_on_second, &s_on_counts)) {
+            s_have_on = true;
+        }
+        if (s_have_start && s_have_on) {
+            Response_Record();
+            s_state = RESP_IDLE;
+        } else if (s_have_start && Response_ClearlyLight(dark_above)) {
+            /* A passing shadow, not dusk: wait for the next crossing. */
+            ADC_Watch(ADC_CH_LDR, Lux_ToAdc(threshold_clx), dark_above);
+            s_have_start = false;
+        } else if (s_have_on && Light_GetLevel() == LIGHT_LEVEL_OFF) {
+            s_state = RESP_IDLE;                // on and off again unseen
+        }
+        break;
+
+    default:
+        s_state = RESP_IDLE;
+        break;
+    }
+}
+
+void Response_EndNight(void) {
+    uint8_t extra = (s_night_dusks > 1u) ? (uint8_t)(s_night_dusks - 1u) : 0u;
+
+    s_nights++;
+    s_false_toggles += extra;
+    if (extra > s_worst_night) {
+        s_worst_night = extra;
+    }
+    s_night_dusks = 0;
+}
+
+static void Response_Pair(const char *key, uint32_t value) {
+    UART_WriteString(key);
+    UART_WriteUInt(value);
+}
+
+void Response_Dump(void) {
+    UART_WriteString("\r\nDUSK RESPONSE (raw LDR past threshold to RB1 on) n=");
+    UART_WriteUInt(s_count);
+    UART_WriteString("\r\n");
+    for (uint8_t b = 0; b < RESP_HIST_BUCKETS; b++) {
+        if (s_hist[b] == 0) {
+            continue;
+        }
+        if (b == RESP_HIST_BUCKETS - 1) {
+            UART_WriteString(" >=");
+            UART_WriteUInt(16UL << (b - 1));
+        } else {
+            UART_WriteString("  <");
+            UART_WriteUInt(16UL << b);
+        }
+        UART_WriteString("ms ");
+        UART_WriteUInt(s_hist[b]);
+        UART_WriteString("\r\n");
+    }
+
+    UART_WriteString("dusk_response");
+    Response_Pair(" n=", s_count);
+    Response_Pair(" min_ms=", s_count ? s_min_ms : 0);
+    Response_Pair(" mean_ms=", s_count ? s_sum_ms / s_count : 0);
+    Response_Pair(" max_ms=", s_max_ms);
+    Response_Pair(" nights=", s_nights);
+    Response_Pair(" false_toggles=", s_false_toggles);
+    Response_Pair(" worst_night=", s_worst_night);
+    Response_Pair(" scan_ms=", ADC_SCAN_PERIOD_MS);
+    Response_Pair(" sensor_s=", SENSOR_INTERVAL);
+#ifdef DARK_DETECT_COMPARATOR
+    Response_Pair(" comparator=", 1);
+#else
+    Response_Pair(" comparator=", 0);
+#endif
+    UART_WriteString(" hist=");
+    for (uint8_t b = 0; b < RESP_HIST_BUCKETS; b++) {
+        if (b != 0) {
+            UART_WriteByte('/');
+        }
+        UART_WriteUInt(s_hist[b]);
+    }
+    UART_WriteString("\r\n");
+}
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * File:   Response.h
+ * Purpose: Dusk response statistics, measured on the running controller.
+ *          The start of a dusk is the first raw LDR burst (ADC scan, every
+ *          ADC_SCAN_PERIOD_MS) at or past the threshold, stamped in the ADC
+ *          ISR; the end is the PWM duty on RB1 leaving zero, stamped in the
+ *          Light ramp. Everything between (detection path, filtering,
+ *          SENSOR_INTERVAL, main-loop and LCD delays) is in the figure. A
+ *          reading that goes clearly light again first (LUX_HYST_CLX above
+ *          the threshold) restarts the measurement. Also counts darkness
+ *          decisions per night: more than one is a false toggle.
+ ******************************************************************************/
+
+#ifndef RESPONSE_H
+#define RESPONSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RESP_HIST_BUCKETS   13      /* under 16 << b ms; last = 32.768 s and over */
+
+/**
+ * Main loop, after the lamp decision: this pass's darkness decision, the
+ * threshold in force and which way the LDR reading goes in the dark.
+ * Latency is only measured at the 1x time scale; toggles at any.
+ */
+void Response_Task(bool is_dark, int16_t threshold_clx, bool dark_above);
+
+/** Close the night's toggle count (called at noon, with Light_EndNight). */
+void Response_EndNight(void);
+
+/**
+ * Print the histogram and a one-line summary over the UART. The summary
+ * line starts "dusk_response" and is key=value pairs, for
+ * tools/duskreport.py.
+ */
+void Response_Dump(void);
+
+#endif /* RESPONSE_H */
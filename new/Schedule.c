@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * File:   Schedule.c
+ * Purpose: Energy-save schedule compiled to a per-day minute bitmap.
+ *          A window that runs past midnight is owned by the day it starts
+ *          on, so today's map is yesterday's spill-over plus today's rules.
+ ******************************************************************************/
+
+#include <string.h>
+#include "Schedule.h"
+#include "Calendar.h"
+#include "CRC.h"
+#include "Config.h"
+
+/* Default rules: the fixed Config.h window, every day, all year. Add rows
+ * here (or over Modbus) for e.g. a later switch-off on Fri/Sat nights:
+ * {(1u << 5) | (1u << 6), 1, 12, 2 * 60, 5 * 60}. */
+static const ScheduleRule DEFAULT_RULES[] = {
+    {SCHEDULE_EVERY_DAY, 1, 12,
+     ENERGY_SAVE_START_HOUR * MINUTES_PER_HOUR, ENERGY_SAVE_END_HOUR * MINUTES_PER_HOUR},
+};
+
+static ScheduleRule s_rules[SCHEDULE_MAX_RULES];
+static uint8_t s_map[SCHEDULE_MINUTES / 8u];
+static uint16_t s_version;
+
+/* Set bits [from, to) of the map: partial bytes at the ends, whole bytes between. */
+static void Schedule_Fill(uint16_t from, uint16_t to) {
+    while (from < to && (from & 7u) != 0) {
+        s_map[from >> 3] |= (uint8_t)(1u << (from & 7u));
+        from++;
+    }
+    if (from < to) {
+        uint16_t whole = (uint16_t)(to - from) & ~7u;
+        memset(&s_map[from >> 3], 0xFF, whole >> 3);
+        from += whole;
+    }
+    while (from < to) {
+        s_map[from >> 3] |= (uint8_t)(1u << (from & 7u));
+        from++;
+    }
+}
+
+static bool Schedule_Applies(const ScheduleRule *r, uint8_t month, uint8_t weekday) {
+    if ((r->weekdays & (1u << weekday)) == 0) {
+        return false;
+    }
+    if (r->first_month <= r->last_month) {
+        return month >= r->first_month && month <= r->last_month;
+    }
+    return month >= r->first_month || month <= r->last_month;
+}
+
+void Schedule_Init(void) {
+    memset(s_rules, 0, sizeof(s_rules));
+    memcpy(s_rules, DEFAULT_RULES, sizeof(DEFAULT_RULES));
+    s_version = CRC_Block(s_rules, sizeof(s_rules));
+    Schedule_Compile();
+}
+
+void Schedule_Compile(void) {
+    uint8_t month = Calendar_GetMonth();
+    uint8_t weekday = Calendar_DayOfWeek();
+    uint8_t y_month = month;
+    uint8_t y_weekday = (uint8_t)((weekday + 6u) % 7u);
+
+    if (Calendar_GetDay() == 1) {
+        y_month = (month == 1) ? 12 : (uint8_t)(month - 1u);
+    }
+
+    memset(s_map, 0, sizeof(s_map));
+    for (uint8_t i = 0; i < SCHEDULE_MAX_RULES; i++) {
+        const ScheduleRule *r = &s_rules[i];
+
+        if (r->start <= r->end) {
+            if (Schedule_Applies(r, month, weekday)) {
+                Schedule_Fill(r->start, r->end);
+            }
+        } else {
+            /* Wraps midnight: tail from yesterday's start, head of today's. */
+            if (Schedule_Applies(r, y_month, y_weekday)) {
+                Schedule_Fill(0, r->end);
+            }
+            if (Schedule_Applies(r, month, weekday)) {
+                Schedule_Fill(r->start, SCHEDULE_MINUTES);
+            }
+        }
+    }
+}
+
+bool Schedule_SetRule(uint8_t index, const ScheduleRule *rule) {
+    if (index >= SCHEDULE_MAX_RULES ||
+        rule->start >= SCHEDULE_MINUTES || rule->end >= SCHEDULE_MINUTES ||
+        rule->weekdays > SCHEDULE_EVERY_DAY ||
+        rule->first_month < 1 || rule->first_month > 12 ||
+        rule->last_month < 1 || rule->last_month > 12) {
+        return false;
+    }
+    s_rules[index] = *rule;
+    s_version = CRC_Block(s_rules, sizeof(s_rules));
+    Schedule_Compile();
+    return true;
+}
+
+const ScheduleRule *Schedule_GetRule(uint8_t index) {
+    return &s_rules[index < SCHEDULE_MAX_RULES ? index : 0];
+}
+
+uint16_t Schedule_GetVersion(void) {
+    return s_version;
+}
+
+bool Schedule_IsSaving(uint16_t minute) {
+    return (s_map[minute >> 3] & (uint8_t)(1u << (minute & 7u))) != 0;
+}
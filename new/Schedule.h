@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * File:   Schedule.h
+ * Purpose: Energy-save schedule. Rules give a weekday set, a season (month
+ *          range) and a minute-of-day window with the main light held off.
+ *          They are compiled once a day into a 1440-bit map for the current
+ *          date, so the main loop decision is a single bit lookup.
+ *          At run time only rule 0 can be changed, and only in whole hours,
+ *          through MB_REG_SAVE_START/END (Main.c). The other rules come
+ *          from DEFAULT_RULES in Schedule.c at build time.
+ ******************************************************************************/
+
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHEDULE_MAX_RULES      8
+#define SCHEDULE_MINUTES        1440u
+#define SCHEDULE_EVERY_DAY      0x7F    /* weekday bits, bit 0 = Sunday */
+
+typedef struct {
+    uint8_t  weekdays;      /* day the window starts on; 0 = rule unused */
+    uint8_t  first_month;   /* season 1-12, inclusive; 11..2 wraps the year */
+    uint8_t  last_month;
+    uint16_t start;         /* minute of day the light goes off */
+    uint16_t end;           /* minute it comes back on; < start ends next day */
+} ScheduleRule;
+
+/** Load the default rules and compile today's map (after Calendar_Init). */
+void Schedule_Init(void);
+
+/** Rebuild the map for the calendar's current date. Call at midnight. */
+void Schedule_Compile(void);
+
+/** Replace rule index and recompile. Returns false if out of range. */
+bool Schedule_SetRule(uint8_t index, const ScheduleRule *rule);
+
+const ScheduleRule *Schedule_GetRule(uint8_t index);
+
+/**
+ * CRC-16 of the rule table: controllers with the same rules report the
+ * same version, however the rules got there.
+ */
+uint16_t Schedule_GetVersion(void);
+
+/** True if the light is held off at this minute of the day (0-1439). */
+bool Schedule_IsSaving(uint16_t minute);
+
+#endif /* SCHEDULE_H */
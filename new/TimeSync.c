@@ -0,0 +1,261 @@
+/*******************************************************************************
+ * File:   TimeSync.c
+ * Purpose: Bus time sync (see TimeSync.h). The master stamps a frame with
+ *          its clock second and the Timer0 count into it just before the
+ *          first byte goes out; the follower's Modbus ISR stamps the frame
+ *          when the t3.5 gap closes it. The difference between the two, less
+ *          the frame's time on the wire and the gap, is the offset. Up to
+ *          1% of each second (10 ms) of it is taken out per tick, and once a
+ *          slew has finished the offset at the next frame is drift alone:
+ *          half of it is trimmed out of the tick length, as Discipline.c does
+ *          from a 1PPS edge. A controller disciplined by its own 1PPS ignores
+ *          the frames.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "TimeSync.h"
+#include "Config.h"
+#include "Timer.h"
+#include "Modbus.h"
+#include "DST.h"
+#include "Schedule.h"
+#include "Discipline.h"
+
+#define TSYNC_SECOND        62500L  // Timer0 counts (16 us) per second
+#define TSYNC_STEP_SECONDS  4       // slewing this much would take 400 s
+#define TSYNC_SLEW_MAX      625     // counts per tick: 1%
+#define TSYNC_LOCK_COUNTS   63      // ~1 ms
+#define TSYNC_DRIFT_LIMIT   13      // counts per second: 200 ppm
+#define TSYNC_JITTER        8       // counts: ISR latency at both ends
+#define TSYNC_TRIM_LIMIT    3200    // 1/256 counts = 200 ppm
+#define TSYNC_LOST_SECONDS  (4u * TIMESYNC_PERIOD)
+
+/* Sending starts at the master's stamp; the follower's stamp is taken when
+ * the t3.5 timer (219 x 8 us) expires after the last byte. Each byte is 10
+ * bits at 115108 baud. Propagation, 5 ns per metre, is below one count. */
+#define TSYNC_FRAME_BYTES   (7u + 2u * TSYNC_FIELDS + 2u)
+#define TSYNC_DELAY         ((int32_t)((TSYNC_FRAME_BYTES * 86875UL / 1000u + 1752u + 8u) / 16u))
+
+#define TSYNC_ALL_FIELDS    ((1u << TSYNC_FIELDS) - 1u)
+
+static uint16_t s_field[TSYNC_FIELDS];
+static uint8_t  s_state = TSYNC_NONE;
+static uint8_t  s_mismatch = 0;
+static int16_t  s_offset_ms = 0;
+
+#ifdef TIMESYNC_MASTER
+static uint32_t s_last_sent = 0u - TIMESYNC_PERIOD;     // first frame at once
+#else
+static uint8_t  s_have = 0;         // fields received from the current frame
+static uint32_t s_frame_second;     // its Modbus_GetFrameTime stamp
+static uint16_t s_frame_counts;
+static bool     s_pending = false;
+static int32_t  s_slew = 0;         // counts still to take out, + = behind
+static uint32_t s_last_second = 0;
+static uint32_t s_last_frame;       // stamp second of the last frame used
+static bool     s_have_ref = false; // ... and it can start a drift measurement
+#endif
+
+void TimeSync_Init(void) {
+#ifdef TIMESYNC_MASTER
+    s_state = TSYNC_MASTER;
+#else
+    s_state = TSYNC_NONE;
+#endif
+}
+
+bool TimeSync_Write(uint8_t field, uint16_t value) {
+    if (field >= TSYNC_FIELDS) {
+        return false;
+    }
+    s_field[field] = value;
+#ifndef TIMESYNC_MASTER
+    uint32_t second;
+    uint16_t counts;
+
+    /* Registers are written in address order: the first one opens the frame,
+     * the rest must come from the same request. */
+    Modbus_GetFrameTime(&second, &counts);
+    if (field == 0) {
+        s_have = 0;
+        s_frame_second = second;
+        s_frame_counts = counts;
+    } else if (second != s_frame_second || counts != s_frame_counts) {
+        s_have = 0;
+    }
+    s_have |= (uint8_t)(1u << field);
+    if (s_have == TSYNC_ALL_FIELDS) {
+        s_have = 0;
+        s_pending = true;
+    }
+#endif
+    return true;
+}
+
+#ifdef TIMESYNC_MASTER
+
+static void TimeSync_Send(uint32_t clock_second, uint32_t utc_second) {
+    uint32_t second, utc;
+    uint16_t counts;
+
+    if ((clock_second - s_last_sent) < TIMESYNC_PERIOD) {
+        return;
+    }
+    /* A tick may have gone by since the main loop read the clock. */
+    Timer_GetStamp(&second, &counts);
+    utc = utc_second + (second - clock_second);
+
+    s_field[0] = (uint16_t)(utc >> 16);
+    s_field[1] = (uint16_t)utc;
+    s_field[2] = counts;
+    s_field[3] = DST_IsActive();
+    s_field[4] = Schedule_GetVersion();
+    if (Modbus_Broadcast(MB_REG_SYNC_TIME_HI, TSYNC_FIELDS, s_field)) {
+        s_last_sent = clock_second;
+    }
+}
+
+#else
+
+static int32_t TimeSync_Abs(int32_t v) {
+    return (v < 0) ? -v : v;
+}
+
+static int16_t TimeSync_Saturate(int32_t v) {
+    if (v > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (v < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)v;
+}
+
+/* Offset of the frame just received; returns whole seconds to step. */
+static int32_t TimeSync_Measure(uint32_t clock_second, uint32_t utc_second) {
+    uint32_t master = ((uint32_t)s_field[0] << 16) | s_field[1];
+    uint32_t own = utc_second - (clock_second - s_frame_second);   // ours at the stamp
+    int32_t seconds = (int32_t)(master - own);
+    int32_t counts = (int32_t)s_field[2] + TSYNC_DELAY - (int32_t)s_frame_counts;
+    int32_t elapsed = (int32_t)(s_frame_second - s_last_frame);
+    int32_t offset;
+    int16_t trim;
+
+    s_mismatch = 0;
+    if ((s_field[3] != 0) != DST_IsActive()) {
+        s_mismatch |= TSYNC_MISMATCH_DST;
+    }
+    if (s_field[4] != Schedule_GetVersion()) {
+        s_mismatch |= TSYNC_MISMATCH_SCHEDULE;
+    }
+
+    /* Whole seconds plus a fraction within half a second either way. */
+    while (counts > TSYNC_SECOND / 2) {
+        counts -= TSYNC_SECOND;
+        seconds++;
+    }
+    while (counts < -TSYNC_SECOND / 2) {
+        counts += TSYNC_SECOND;
+        seconds--;
+    }
+
+    s_last_frame = s_frame_second;
+    if (seconds >= TSYNC_STEP_SECONDS || seconds <= -TSYNC_STEP_SECONDS) {
+        /* First frame after power-up, or the master was reset: step the
+         * seconds and slew the fraction. */
+        s_offset_ms = TimeSync_Saturate(seconds * 1000);
+        s_slew = counts;
+        s_have_ref = false;
+        s_state = TSYNC_SLEWING;
+        return seconds;
+    }
+
+    offset = seconds * TSYNC_SECOND + counts;
+    s_offset_ms = (int16_t)((offset * 16) / 1000);
+
+    if (s_have_ref && s_slew == 0 && elapsed > 0 &&
+        TimeSync_Abs(offset) <= elapsed * TSYNC_DRIFT_LIMIT + TSYNC_JITTER) {
+        /* Behind = ticks too long: shorten them by half the error. */
+        trim = (int16_t)(Timer_GetTrim() - (int16_t)((offset * 128) / elapsed));
+        if (trim > TSYNC_TRIM_LIMIT) {
+            trim = TSYNC_TRIM_LIMIT;
+        } else if (trim < -TSYNC_TRIM_LIMIT) {
+            trim = -TSYNC_TRIM_LIMIT;
+        }
+        Timer_SetTrim(trim);
+    }
+    s_have_ref = true;
+    s_slew = offset;
+    s_state = (TimeSync_Abs(offset) <= TSYNC_LOCK_COUNTS) ? TSYNC_LOCKED : TSYNC_SLEWING;
+    return 0;
+}
+
+/* Once per tick: the next tick comes up to TSYNC_SLEW_MAX counts early
+ * (behind) or late (ahead). */
+static void TimeSync_SlewStep(void) {
+    int32_t step = s_slew;
+
+    if (step > TSYNC_SLEW_MAX) {
+        step = TSYNC_SLEW_MAX;
+    } else if (step < -TSYNC_SLEW_MAX) {
+        step = -TSYNC_SLEW_MAX;
+    }
+    if (step != 0) {
+        Timer_StepPhase((int16_t)-step);
+        s_slew -= step;
+    }
+}
+
+#endif /* TIMESYNC_MASTER */
+
+int32_t TimeSync_Task(uint32_t clock_second, uint32_t utc_second) {
+    int32_t step = 0;
+
+    if (Timer_GetTimeScale() != 1) {
+#ifndef TIMESYNC_MASTER
+        /* Clock seconds are not real seconds: stamps are meaningless. */
+        s_pending = false;
+        s_slew = 0;
+        s_have_ref = false;
+#endif
+        return 0;
+    }
+#ifdef TIMESYNC_MASTER
+    TimeSync_Send(clock_second, utc_second);
+#else
+    if (s_pending) {
+        s_pending = false;
+#ifdef PPS_DISCIPLINE
+        if (Discipline_GetState() < DISC_TRACKING)
+#endif
+        {
+            step = TimeSync_Measure(clock_second, utc_second);
+        }
+    }
+    if (clock_second != s_last_second) {
+        s_last_second = clock_second;
+        TimeSync_SlewStep();
+        if (s_state != TSYNC_NONE && (clock_second - s_last_frame) > TSYNC_LOST_SECONDS) {
+            s_state = TSYNC_LOST;
+            s_have_ref = false;
+        }
+    }
+#endif
+    return step;
+}
+
+uint16_t TimeSync_GetField(uint8_t field) {
+    return (field < TSYNC_FIELDS) ? s_field[field] : 0;
+}
+
+uint8_t TimeSync_GetState(void) {
+    return s_state;
+}
+
+int16_t TimeSync_GetOffset_ms(void) {
+    return s_offset_ms;
+}
+
+uint8_t TimeSync_GetMismatch(void) {
+    return s_mismatch;
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * File:   TimeSync.h
+ * Purpose: Keeps the clocks of the controllers on one RS-485 bus together.
+ *          A master (TIMESYNC_MASTER) broadcasts its UTC time, the phase in
+ *          the second at which it started sending, its DST state and its
+ *          schedule version as one Modbus write-multiple to address 0
+ *          (MB_REG_SYNC_*), every TIMESYNC_PERIOD seconds. Broadcasts are
+ *          never answered, so any number of followers share the bus with no
+ *          collisions, and a SCADA master can send the same frame instead.
+ *          Followers add the link delay, then slew the tick phase and trim
+ *          its frequency; only an error of TSYNC_STEP_SECONDS or more steps
+ *          the clock.
+ ******************************************************************************/
+
+#ifndef TIMESYNC_H
+#define TIMESYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TSYNC_FIELDS            5   /* registers in the broadcast, from MB_REG_SYNC_TIME_HI */
+
+#define TSYNC_NONE              0   /* no sync frame yet */
+#define TSYNC_SLEWING           1   /* last offset over 1 ms, being slewed out */
+#define TSYNC_LOCKED            2   /* last offset within 1 ms */
+#define TSYNC_LOST              3   /* no frame for 4 periods: trim held */
+#define TSYNC_MASTER            4   /* this controller sends the frames */
+
+#define TSYNC_MISMATCH_DST      0x01    /* master's summer-time state differs */
+#define TSYNC_MISMATCH_SCHEDULE 0x02    /* master's schedule version differs */
+
+void TimeSync_Init(void);
+
+/**
+ * Modbus write of sync register field (0..TSYNC_FIELDS-1). A frame counts
+ * only when all fields arrive in one write-multiple. Not journalled: it
+ * repeats every period.
+ */
+bool TimeSync_Write(uint8_t field, uint16_t value);
+
+/** Last value written to field (the master's own: last sent). */
+uint16_t TimeSync_GetField(uint8_t field);
+
+/**
+ * Main loop, after the clock is up to date: utc_second is the clock's UTC
+ * at clock second clock_second. Master: sends a frame when due. Follower:
+ * measures a new frame and slews one step per second. Returns the whole
+ * seconds to step the clock by, 0 almost always. Idle at demo time scales.
+ */
+int32_t TimeSync_Task(uint32_t clock_second, uint32_t utc_second);
+
+/** TSYNC_* state. */
+uint8_t TimeSync_GetState(void);
+
+/** Offset measured from the last frame, ms; + = this clock was behind. */
+int16_t TimeSync_GetOffset_ms(void);
+
+/** TSYNC_MISMATCH_* bits from the last frame. */
+uint8_t TimeSync_GetMismatch(void);
+
+#endif /* TIMESYNC_H */
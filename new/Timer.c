@@ -1,28 +1,120 @@
 /*******************************************************************************
  * File:   Timer.c
  * Purpose: System tick timer; generates periodic interrupts. Tick period
- *          and TICKS_PER_SECOND are defined in Config.h (TEST_MODE vs production).
+ *          and TICKS_PER_SECOND are defined in Config.h. Each tick also
+ *          advances the clock-seconds count by the time scale, so demo runs
+ *          (e.g. 3600x) go through exactly the production timekeeping.
+ *          Timer0 and the 1PPS edge snapshot are the only high-priority
+ *          interrupts; every other source runs in the low-priority ISR
+ *          (Main.c) and can be pre-empted by the tick.
+ *          Each tick's length is the nominal period plus a trim in 1/256
+ *          counts, carried in a fractional accumulator, plus any one-off
+ *          phase step; Discipline.c sets both from a 1PPS reference.
+ *          Timer1 free-runs at Fosc/4 for the ISR entry timestamp (and the
+ *          profiler, Profile.c).
  ******************************************************************************/
 
 #include <xc.h>
 #include "Timer.h"
 #include "Config.h"
+#include "Latency.h"
+
+#define TMR0_RELOAD     (((uint16_t)TMR0_RELOAD_HIGH << 8) | TMR0_RELOAD_LOW)
+
+/* Longest a step can make one tick: the reload must stay at or above 0
+ * with any trim (+/-13 counts at the 200 ppm limit). The rest of a longer
+ * step goes on the following ticks. */
+#define TMR0_STEP_MAX   ((int16_t)TMR0_RELOAD - 16)
 
 static volatile uint32_t s_tick_count = 0;
-void __interrupt() ISR(void) {
+static volatile uint32_t s_clock_seconds = 0;
+static volatile uint16_t s_time_scale = TIME_SCALE_DEFAULT;
+
+static volatile int16_t s_trim = 0;         /* 1/256 counts added to each tick */
+static volatile int16_t s_step = 0;         /* counts still to add to the next tick(s) */
+static uint8_t s_frac = 0;                  /* fractional count carried over */
+static volatile uint16_t s_reload = TMR0_RELOAD;    /* start of the current tick */
+
+/* TMR1 when Timer0 next overflows: each reload write also clears the
+ * Timer0 prescaler, so the overflow falls (0x10000 - reload) * 256 Fosc/4
+ * cycles after it, kept modulo 2^16 like TMR1. */
+static uint16_t s_due = 0;
+static bool s_due_valid = false;
+
+static volatile int16_t s_pps_phase = 0;
+static volatile uint32_t s_pps_tick = 0;
+static volatile uint8_t s_pps_seq = 0;
+
+void __interrupt(high_priority) ISR(void) {
+    /* Entry timestamp first, before anything else runs. */
+    uint16_t entry = TMR1L;             // Reading TMR1L latches TMR1H (RD16)
+    entry |= (uint16_t)TMR1H << 8;
+
+    if (PIE0bits.INT1IE && PIR0bits.INT1IF) {
+        /* 1PPS edge: where it fell relative to the nearest tick. Only a
+         * snapshot here; Discipline_Task does the rest. */
+        uint16_t counts = TMR0L;        // Reading TMR0L latches TMR0H
+        counts |= (uint16_t)TMR0H << 8;
+        uint16_t period = (uint16_t)(0u - s_reload);
+        uint16_t pos = PIR0bits.TMR0IF ? (uint16_t)(period + counts) : (uint16_t)(counts - s_reload);
+
+        PIR0bits.INT1IF = 0;
+        if (pos < period / 2u) {
+            s_pps_phase = (int16_t)pos;
+            s_pps_tick = s_tick_count;
+        } else {
+            s_pps_phase = (int16_t)(pos - period);
+            s_pps_tick = s_tick_count + 1u;     // tick just ahead (or pending)
+        }
+        s_pps_seq++;
+    }
     if (PIR0bits.TMR0IF) {
+        /* Entry latency in Fosc/4 cycles. TMR0 restarted from 0 at
+         * overflow: past 255 of its 16 us counts the 16-bit cycle count
+         * has wrapped, so it saturates. */
+        uint16_t latency = (uint16_t)(entry - s_due);
+        uint16_t counts = TMR0L;        // Reading TMR0L latches TMR0H
+        counts |= (uint16_t)TMR0H << 8;
+        if (counts >= 0xFFu) {
+            latency = 0xFFFFu;
+        }
+
         PIR0bits.TMR0IF = 0;  // Clear interrupt flag so we don't re-enter 
 
-        /* Reload for next period (values from Config.h). */
-        TMR0H = TMR0_RELOAD_HIGH;
-        TMR0L = TMR0_RELOAD_LOW;
+        /* Reload for next period: nominal (Config.h) less trim and step. */
+        int16_t acc = (int16_t)s_frac + s_trim;
+        int16_t step = s_step;
+        if (step > TMR0_STEP_MAX) {
+            step = TMR0_STEP_MAX;
+        }
+        s_step = (int16_t)(s_step - step);
+        s_frac = (uint8_t)acc;
+        s_reload = (uint16_t)(TMR0_RELOAD - (uint16_t)(acc >> 8) - (uint16_t)step);
+        TMR0H = (uint8_t)(s_reload >> 8);
+        TMR0L = (uint8_t)s_reload;
+        uint16_t written = TMR1L;
+        written |= (uint16_t)TMR1H << 8;
+        s_due = (uint16_t)(written + (uint16_t)((uint16_t)(0u - s_reload) << 8));
 
         // One tick elapsed
         s_tick_count++;
+        s_clock_seconds += s_time_scale;
+        if (s_due_valid) {
+            Latency_Record(latency, s_tick_count);
+        }
+        s_due_valid = true;         // from the first reload on
     }
 }
 
 void Timer_Init(void) {
+    // Timer1: free-running Fosc/4 timestamp, no interrupt of its own.
+    T1CONbits.ON = 0;
+    T1CLK = 0b0001;             // Fosc/4
+    T1CONbits.CKPS = 0b00;      // 1:1
+    T1CONbits.RD16 = 1;         // 16-bit buffered read
+    T1GCONbits.GE = 0;          // Free-running, no gate
+    T1CONbits.ON = 1;
+
     // Disable timer while configuring. 
     T0CON0bits.T0EN = 0;
 
@@ -36,11 +128,13 @@ void Timer_Init(void) {
     TMR0H = TMR0_RELOAD_HIGH;
     TMR0L = TMR0_RELOAD_LOW;
 
-    // Enable Timer0 interrupt and global interrupt. 
+    // Enable Timer0 interrupt (high priority) and global interrupts. 
+    INTCONbits.IPEN = 1;   // Two priority levels
     PIR0bits.TMR0IF = 0;
+    IPR0bits.TMR0IP = 1;
     PIE0bits.TMR0IE = 1;
-    INTCONbits.PEIE = 1;   // Peripheral interrupt enabled
-    INTCONbits.GIE = 1;    // Global interrupt enabled
+    INTCONbits.GIEL = 1;   // Low-priority interrupts enabled
+    INTCONbits.GIEH = 1;   // High-priority (and global) interrupts enabled
 
     // Timer started
     T0CON0bits.T0EN = 1;
@@ -49,10 +143,126 @@ void Timer_Init(void) {
 uint32_t Timer_GetTicks(void) {
     uint32_t ticks;
     uint8_t gie_save;
+    uint8_t tag = g_latency_tag;
 
+    /* A tick held off by this window is charged to LAT_TAG_GETTICKS:
+     * the ISR runs as soon as GIE is restored, before the tag is. */
+    Latency_Tag(LAT_TAG_GETTICKS);
     gie_save = INTCONbits.GIE;
     INTCONbits.GIE = 0;   /* Disable interrupts for atomic read */
     ticks = s_tick_count;
     INTCONbits.GIE = gie_save;
+    Latency_Tag(tag);
     return ticks;
 }
+
+void Timer_GetStamp(uint32_t *seconds, uint16_t *counts) {
+    uint32_t s;
+    uint16_t c;
+    uint8_t gie_save;
+
+    gie_save = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    c = TMR0L;                      // Reading TMR0L latches TMR0H
+    c |= (uint16_t)TMR0H << 8;
+    s = s_clock_seconds;
+    if (PIR0bits.TMR0IF) {
+        s += s_time_scale;          // tick due but not yet counted
+    } else {
+        c -= s_reload;
+    }
+    INTCONbits.GIE = gie_save;
+    *seconds = s;
+    *counts = c;
+}
+
+uint32_t Timer_GetUptime_us(void) {
+    uint32_t ticks;
+    uint16_t counts;
+    uint8_t gie_save;
+
+    gie_save = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    counts = TMR0L;                 // Reading TMR0L latches TMR0H
+    counts |= (uint16_t)TMR0H << 8;
+    ticks = s_tick_count;
+    if (PIR0bits.TMR0IF) {
+        /* Overflowed but not yet reloaded: counting up from 0. */
+        ticks++;
+    } else {
+        counts -= s_reload;
+    }
+    INTCONbits.GIE = gie_save;
+
+    /* Fosc/4 / 256 = 16 us per count */
+    return ticks * 1000000UL + (uint32_t)counts * 16u;
+}
+
+void Timer_SetTrim(int16_t trim) {
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    s_trim = trim;
+    INTCONbits.GIE = gie_save;
+}
+
+int16_t Timer_GetTrim(void) {
+    int16_t trim;
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    trim = s_trim;
+    INTCONbits.GIE = gie_save;
+    return trim;
+}
+
+void Timer_StepPhase(int16_t counts) {
+    uint8_t gie_save = INTCONbits.GIE;
+
+    INTCONbits.GIE = 0;
+    s_step = counts;
+    INTCONbits.GIE = gie_save;
+}
+
+bool Timer_GetPps(int16_t *phase, uint32_t *tick) {
+    static uint8_t seen = 0;
+    uint8_t gie_save;
+    bool fresh;
+
+    gie_save = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    fresh = (s_pps_seq != seen);
+    seen = s_pps_seq;
+    *phase = s_pps_phase;
+    *tick = s_pps_tick;
+    INTCONbits.GIE = gie_save;
+    return fresh;
+}
+
+uint32_t Timer_GetClockSeconds(void) {
+    uint32_t seconds;
+    uint8_t gie_save;
+
+    gie_save = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    seconds = s_clock_seconds;
+    INTCONbits.GIE = gie_save;
+    return seconds;
+}
+
+uint8_t Timer_SetTimeScale(uint16_t scale) {
+    uint8_t gie_save;
+
+    if (scale == 0 || scale > TIME_SCALE_MAX) {
+        return 0;
+    }
+    gie_save = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    s_time_scale = scale;
+    INTCONbits.GIE = gie_save;
+    return 1;
+}
+
+uint16_t Timer_GetTimeScale(void) {
+    return s_time_scale;
+}
@@ -12,6 +12,7 @@
 #define TIMER_H
 
 #include <stdint.h> // for uint32_t 
+#include <stdbool.h>
 
 
 
@@ -19,4 +20,22 @@ void Timer_Init(void); // initialise timer where it sets up Timer0 and interrupt
 
 uint32_t Timer_GetTicks(void); // get current tick count by measuring elapsed time
 
+uint32_t Timer_GetClockSeconds(void); // clock seconds elapsed: ticks scaled by the time scale
+
+uint32_t Timer_GetUptime_us(void); // since Timer_Init, 16 us resolution (wraps after ~71 min)
+
+void Timer_GetStamp(uint32_t *seconds, uint16_t *counts); // clock seconds and Timer0 counts (16 us) into the current tick, read together
+
+/* Tick length trim for a disciplined timebase (Discipline.c). One Timer0
+ * count is 16 us = 16 ppm of a tick; trim is in 1/256 counts (0.0625 ppm),
+ * positive = longer ticks = slower clock. */
+void Timer_SetTrim(int16_t trim);
+int16_t Timer_GetTrim(void);
+void Timer_StepPhase(int16_t counts); // next tick later (+) or earlier (-); more than ~3000 counts later is spread over several ticks. Replaces any step not yet made
+bool Timer_GetPps(int16_t *phase, uint32_t *tick); // new 1PPS edge? counts after (+) or before (-) the nearest tick, and that tick's number
+
+uint8_t Timer_SetTimeScale(uint16_t scale); // 1..TIME_SCALE_MAX clock seconds per tick; 0 if rejected
+
+uint16_t Timer_GetTimeScale(void);
+
 #endif 
@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * File:   UART.c
+ * Purpose: EUSART4 serial console (TX RC0, RX RC1, 115200 8N1).
+ *          Transmit is polled; this is for diagnostics, not the hot path.
+ ******************************************************************************/
+
+#include <xc.h>
+#include "UART.h"
+#include "Config.h"
+
+void UART_Init(void) {
+    RC0PPS = 0x12;              // EUSART4 TX on RC0
+    RX4PPS = 0x11;              // EUSART4 RX from RC1
+    TRISCbits.TRISC0 = 0;
+    TRISCbits.TRISC1 = 1;
+    ANSELCbits.ANSELC1 = 0;
+
+    // 64 MHz / (4 * (138 + 1)) = 115108 baud (-0.08 %)
+    BAUD4CONbits.BRG16 = 1;
+    TX4STAbits.BRGH = 1;
+    SP4BRGL = 138;
+    SP4BRGH = 0;
+
+    RC4STAbits.CREN = 1;        // Continuous receive
+    TX4STAbits.TXEN = 1;        // Transmitter on
+    RC4STAbits.SPEN = 1;        // Serial port on
+}
+
+void UART_WriteByte(uint8_t c) {
+    while (!TX4STAbits.TRMT) {
+    }
+    TX4REG = c;
+}
+
+bool UART_ReadByte(uint8_t *c) {
+    if (RC4STAbits.OERR) {
+        RC4STAbits.CREN = 0;    // Clear overrun by restarting the receiver
+        RC4STAbits.CREN = 1;
+    }
+    if (!PIR4bits.RC4IF) {
+        return false;
+    }
+    *c = RC4REG;
+    return true;
+}
+
+void UART_WriteString(const char *s) {
+    while (*s) {
+        UART_WriteByte((uint8_t)*s++);
+    }
+}
+
+void UART_WriteUInt(uint32_t n) {
+    char digits[10];
+    uint8_t i = 0;
+
+    do {
+        digits[i++] = (char)('0' + (n % 10u));
+        n /= 10u;
+    } while (n != 0);
+    while (i != 0) {
+        UART_WriteByte((uint8_t)digits[--i]);
+    }
+}
@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * File:   UART.h
+ * Purpose: EUSART4 serial console (TX RC0, RX RC1, 115200 8N1) used for
+ *          debug and diagnostic dumps.
+ ******************************************************************************/
+
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Map EUSART4 onto RC0/RC1 and enable the transmitter and receiver. */
+void UART_Init(void);
+
+/** Send one byte, waiting for the transmit shift register to empty. */
+void UART_WriteByte(uint8_t c);
+
+/** Non-blocking receive. Returns true and stores the byte if one is waiting. */
+bool UART_ReadByte(uint8_t *c);
+
+/** Send a NUL-terminated string. */
+void UART_WriteString(const char *s);
+
+/** Send an unsigned number in decimal, no padding. */
+void UART_WriteUInt(uint32_t n);
+
+#endif /* UART_H */
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * File:   Watchdog.c
+ * Purpose: Windowed watchdog feeding (see Watchdog.h). Clearing before the
+ *          window opens (< 2 s) resets the device just like not clearing.
+ *          Enabling and every clear happen on the first main-loop pass after
+ *          a tick, so clears are WDT_FEED_TICKS apart give or take the
+ *          variation in main-loop latency, never a fraction of a tick.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdbool.h>
+#include "Watchdog.h"
+#include "Config.h"
+
+static uint32_t s_last_feed = 0;
+static bool s_running = false;
+
+void Watchdog_Start(uint32_t now) {
+    s_last_feed = now;
+    s_running = false;
+}
+
+void Watchdog_Feed(uint32_t now) {
+    if (!s_running) {
+        if (now != s_last_feed) {
+            /* First pass after a tick edge: the WDT period starts here. */
+            CLRWDT();
+            WDTCON0bits.SEN = 1;
+            s_last_feed = now;
+            s_running = true;
+        }
+        return;
+    }
+    if ((now - s_last_feed) >= WDT_FEED_TICKS) {
+        s_last_feed = now;
+        CLRWDT();
+    }
+}
@@ -0,0 +1,27 @@
+/*******************************************************************************
+ * File:   Watchdog.h
+ * Purpose: Windowed watchdog (config: 4 s period, window open for the last
+ *          50%) fed from the main loop's liveness check, at most once per
+ *          WDT_FEED_TICKS Timer0 ticks so every clear lands in the window.
+ ******************************************************************************/
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <stdint.h>
+
+/**
+ * Arm the WDT (software-enabled mode). It is enabled by the first
+ * Watchdog_Feed after the next tick, i.e. at the same point in a tick as
+ * every later clear, so the first window is no shorter than the rest.
+ */
+void Watchdog_Start(uint32_t now);
+
+/**
+ * Called once per main-loop pass after every task has run. Clears the WDT
+ * when WDT_FEED_TICKS ticks have passed, so a stuck loop or a stopped
+ * Timer0 both end in a reset.
+ */
+void Watchdog_Feed(uint32_t now);
+
+#endif /* WATCHDOG_H */
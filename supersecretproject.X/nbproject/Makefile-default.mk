@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../new/ADC.c ../new/LEDS.c ../new/Main.c ../new/Timer.c
+SOURCEFILES_QUOTED_IF_SPACED=../new/ADC.c ../new/BCD.c ../new/Buttons.c ../new/Calendar.c ../new/Comparator.c ../new/CRC.c ../new/Dimmer.c ../new/Discipline.c ../new/DST.c ../new/FlashCheck.c ../new/GPS.c ../new/Journal.c ../new/Latency.c ../new/LCD.c ../new/LEDS.c ../new/Light.c ../new/Logger.c ../new/Lux.c ../new/Main.c ../new/Modbus.c ../new/MSF.c ../new/NVM.c ../new/Persist.c ../new/Profile.c ../new/Response.c ../new/Schedule.c ../new/Timer.c ../new/TimeSync.c ../new/UART.c ../new/Watchdog.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1360932049/ADC.p1 ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ${OBJECTDIR}/_ext/1360932049/Main.p1 ${OBJECTDIR}/_ext/1360932049/Timer.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1360932049/ADC.p1.d ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d ${OBJECTDIR}/_ext/1360932049/Main.p1.d ${OBJECTDIR}/_ext/1360932049/Timer.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1360932049/ADC.p1 ${OBJECTDIR}/_ext/1360932049/BCD.p1 ${OBJECTDIR}/_ext/1360932049/Buttons.p1 ${OBJECTDIR}/_ext/1360932049/Calendar.p1 ${OBJECTDIR}/_ext/1360932049/Comparator.p1 ${OBJECTDIR}/_ext/1360932049/CRC.p1 ${OBJECTDIR}/_ext/1360932049/Dimmer.p1 ${OBJECTDIR}/_ext/1360932049/Discipline.p1 ${OBJECTDIR}/_ext/1360932049/DST.p1 ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1 ${OBJECTDIR}/_ext/1360932049/GPS.p1 ${OBJECTDIR}/_ext/1360932049/Journal.p1 ${OBJECTDIR}/_ext/1360932049/Latency.p1 ${OBJECTDIR}/_ext/1360932049/LCD.p1 ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ${OBJECTDIR}/_ext/1360932049/Light.p1 ${OBJECTDIR}/_ext/1360932049/Logger.p1 ${OBJECTDIR}/_ext/1360932049/Lux.p1 ${OBJECTDIR}/_ext/1360932049/Main.p1 ${OBJECTDIR}/_ext/1360932049/Modbus.p1 ${OBJECTDIR}/_ext/1360932049/MSF.p1 ${OBJECTDIR}/_ext/1360932049/NVM.p1 ${OBJECTDIR}/_ext/1360932049/Persist.p1 ${OBJECTDIR}/_ext/1360932049/Profile.p1 ${OBJECTDIR}/_ext/1360932049/Response.p1 ${OBJECTDIR}/_ext/1360932049/Schedule.p1 ${OBJECTDIR}/_ext/1360932049/Timer.p1 ${OBJECTDIR}/_ext/1360932049/TimeSync.p1 ${OBJECTDIR}/_ext/1360932049/UART.p1 ${OBJECTDIR}/_ext/1360932049/Watchdog.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1360932049/ADC.p1.d ${OBJECTDIR}/_ext/1360932049/BCD.p1.d ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d ${OBJECTDIR}/_ext/1360932049/CRC.p1.d ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d ${OBJECTDIR}/_ext/1360932049/DST.p1.d ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d ${OBJECTDIR}/_ext/1360932049/GPS.p1.d ${OBJECTDIR}/_ext/1360932049/Journal.p1.d ${OBJECTDIR}/_ext/1360932049/Latency.p1.d ${OBJECTDIR}/_ext/1360932049/LCD.p1.d ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d ${OBJECTDIR}/_ext/1360932049/Light.p1.d ${OBJECTDIR}/_ext/1360932049/Logger.p1.d ${OBJECTDIR}/_ext/1360932049/Lux.p1.d ${OBJECTDIR}/_ext/1360932049/Main.p1.d ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d ${OBJECTDIR}/_ext/1360932049/MSF.p1.d ${OBJECTDIR}/_ext/1360932049/NVM.p1.d ${OBJECTDIR}/_ext/1360932049/Persist.p1.d ${OBJECTDIR}/_ext/1360932049/Profile.p1.d ${OBJECTDIR}/_ext/1360932049/Response.p1.d ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d ${OBJECTDIR}/_ext/1360932049/Timer.p1.d ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d ${OBJECTDIR}/_ext/1360932049/UART.p1.d ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1360932049/ADC.p1 ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ${OBJECTDIR}/_ext/1360932049/Main.p1 ${OBJECTDIR}/_ext/1360932049/Timer.p1
+OBJECTFILES=${OBJECTDIR}/_ext/1360932049/ADC.p1 ${OBJECTDIR}/_ext/1360932049/BCD.p1 ${OBJECTDIR}/_ext/1360932049/Buttons.p1 ${OBJECTDIR}/_ext/1360932049/Calendar.p1 ${OBJECTDIR}/_ext/1360932049/Comparator.p1 ${OBJECTDIR}/_ext/1360932049/CRC.p1 ${OBJECTDIR}/_ext/1360932049/Dimmer.p1 ${OBJECTDIR}/_ext/1360932049/Discipline.p1 ${OBJECTDIR}/_ext/1360932049/DST.p1 ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1 ${OBJECTDIR}/_ext/1360932049/GPS.p1 ${OBJECTDIR}/_ext/1360932049/Journal.p1 ${OBJECTDIR}/_ext/1360932049/Latency.p1 ${OBJECTDIR}/_ext/1360932049/LCD.p1 ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ${OBJECTDIR}/_ext/1360932049/Light.p1 ${OBJECTDIR}/_ext/1360932049/Logger.p1 ${OBJECTDIR}/_ext/1360932049/Lux.p1 ${OBJECTDIR}/_ext/1360932049/Main.p1 ${OBJECTDIR}/_ext/1360932049/Modbus.p1 ${OBJECTDIR}/_ext/1360932049/MSF.p1 ${OBJECTDIR}/_ext/1360932049/NVM.p1 ${OBJECTDIR}/_ext/1360932049/Persist.p1 ${OBJECTDIR}/_ext/1360932049/Profile.p1 ${OBJECTDIR}/_ext/1360932049/Response.p1 ${OBJECTDIR}/_ext/1360932049/Schedule.p1 ${OBJECTDIR}/_ext/1360932049/Timer.p1 ${OBJECTDIR}/_ext/1360932049/TimeSync.p1 ${OBJECTDIR}/_ext/1360932049/UART.p1 ${OBJECTDIR}/_ext/1360932049/Watchdog.p1
 
 # Source Files
-SOURCEFILES=../new/ADC.c ../new/LEDS.c ../new/Main.c ../new/Timer.c
+SOURCEFILES=../new/ADC.c ../new/BCD.c ../new/Buttons.c ../new/Calendar.c ../new/Comparator.c ../new/CRC.c ../new/Dimmer.c ../new/Discipline.c ../new/DST.c ../new/FlashCheck.c ../new/GPS.c ../new/Journal.c ../new/Latency.c ../new/LCD.c ../new/LEDS.c ../new/Light.c ../new/Logger.c ../new/Lux.c ../new/Main.c ../new/Modbus.c ../new/MSF.c ../new/NVM.c ../new/Persist.c ../new/Profile.c ../new/Response.c ../new/Schedule.c ../new/Timer.c ../new/TimeSync.c ../new/UART.c ../new/Watchdog.c
 
 
 
@@ -92,67 +92,483 @@ ${OBJECTDIR}/_ext/1360932049/ADC.p1: ../new/ADC.c  nbproject/Makefile-${CND_CONF
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/ADC.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/ADC.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/ADC.p1 ../new/ADC.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/ADC.p1 ../new/ADC.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/ADC.d ${OBJECTDIR}/_ext/1360932049/ADC.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/ADC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/BCD.p1: ../new/BCD.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/BCD.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/BCD.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/BCD.p1 ../new/BCD.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/BCD.d ${OBJECTDIR}/_ext/1360932049/BCD.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/BCD.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Buttons.p1: ../new/Buttons.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Buttons.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Buttons.p1 ../new/Buttons.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Buttons.d ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Calendar.p1: ../new/Calendar.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Calendar.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Calendar.p1 ../new/Calendar.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Calendar.d ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Comparator.p1: ../new/Comparator.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Comparator.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Comparator.p1 ../new/Comparator.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Comparator.d ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/CRC.p1: ../new/CRC.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/CRC.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/CRC.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/CRC.p1 ../new/CRC.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/CRC.d ${OBJECTDIR}/_ext/1360932049/CRC.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/CRC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Dimmer.p1: ../new/Dimmer.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Dimmer.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Dimmer.p1 ../new/Dimmer.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Dimmer.d ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Discipline.p1: ../new/Discipline.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Discipline.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Discipline.p1 ../new/Discipline.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Discipline.d ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/DST.p1: ../new/DST.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/DST.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/DST.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/DST.p1 ../new/DST.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/DST.d ${OBJECTDIR}/_ext/1360932049/DST.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/DST.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/FlashCheck.p1: ../new/FlashCheck.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1 ../new/FlashCheck.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/FlashCheck.d ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/GPS.p1: ../new/GPS.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/GPS.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/GPS.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/GPS.p1 ../new/GPS.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/GPS.d ${OBJECTDIR}/_ext/1360932049/GPS.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/GPS.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Journal.p1: ../new/Journal.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Journal.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Journal.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Journal.p1 ../new/Journal.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Journal.d ${OBJECTDIR}/_ext/1360932049/Journal.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Journal.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Latency.p1: ../new/Latency.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Latency.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Latency.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Latency.p1 ../new/Latency.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Latency.d ${OBJECTDIR}/_ext/1360932049/Latency.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Latency.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/LCD.p1: ../new/LCD.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/LCD.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/LCD.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/LCD.p1 ../new/LCD.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/LCD.d ${OBJECTDIR}/_ext/1360932049/LCD.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/LCD.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1360932049/LEDS.p1: ../new/LEDS.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/LEDS.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ../new/LEDS.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ../new/LEDS.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/LEDS.d ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/Light.p1: ../new/Light.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Light.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Light.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Light.p1 ../new/Light.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Light.d ${OBJECTDIR}/_ext/1360932049/Light.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Light.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Logger.p1: ../new/Logger.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Logger.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Logger.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Logger.p1 ../new/Logger.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Logger.d ${OBJECTDIR}/_ext/1360932049/Logger.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Logger.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Lux.p1: ../new/Lux.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Lux.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Lux.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Lux.p1 ../new/Lux.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Lux.d ${OBJECTDIR}/_ext/1360932049/Lux.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Lux.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1360932049/Main.p1: ../new/Main.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Main.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Main.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Main.p1 ../new/Main.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Main.p1 ../new/Main.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/Main.d ${OBJECTDIR}/_ext/1360932049/Main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/Modbus.p1: ../new/Modbus.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Modbus.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Modbus.p1 ../new/Modbus.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Modbus.d ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/MSF.p1: ../new/MSF.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/MSF.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/MSF.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/MSF.p1 ../new/MSF.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/MSF.d ${OBJECTDIR}/_ext/1360932049/MSF.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/MSF.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/NVM.p1: ../new/NVM.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/NVM.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/NVM.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/NVM.p1 ../new/NVM.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/NVM.d ${OBJECTDIR}/_ext/1360932049/NVM.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/NVM.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Persist.p1: ../new/Persist.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Persist.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Persist.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Persist.p1 ../new/Persist.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Persist.d ${OBJECTDIR}/_ext/1360932049/Persist.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Persist.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Profile.p1: ../new/Profile.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Profile.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Profile.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Profile.p1 ../new/Profile.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Profile.d ${OBJECTDIR}/_ext/1360932049/Profile.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Profile.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Response.p1: ../new/Response.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Response.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Response.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Response.p1 ../new/Response.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Response.d ${OBJECTDIR}/_ext/1360932049/Response.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Response.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Schedule.p1: ../new/Schedule.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Schedule.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Schedule.p1 ../new/Schedule.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Schedule.d ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1360932049/Timer.p1: ../new/Timer.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Timer.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Timer.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Timer.p1 ../new/Timer.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Timer.p1 ../new/Timer.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/Timer.d ${OBJECTDIR}/_ext/1360932049/Timer.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Timer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/TimeSync.p1: ../new/TimeSync.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/TimeSync.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/TimeSync.p1 ../new/TimeSync.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/TimeSync.d ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/UART.p1: ../new/UART.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/UART.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/UART.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/UART.p1 ../new/UART.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/UART.d ${OBJECTDIR}/_ext/1360932049/UART.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/UART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Watchdog.p1: ../new/Watchdog.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Watchdog.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=pickit4   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Watchdog.p1 ../new/Watchdog.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Watchdog.d ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 else
 ${OBJECTDIR}/_ext/1360932049/ADC.p1: ../new/ADC.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/ADC.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/ADC.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/ADC.p1 ../new/ADC.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/ADC.p1 ../new/ADC.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/ADC.d ${OBJECTDIR}/_ext/1360932049/ADC.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/ADC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/BCD.p1: ../new/BCD.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/BCD.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/BCD.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/BCD.p1 ../new/BCD.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/BCD.d ${OBJECTDIR}/_ext/1360932049/BCD.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/BCD.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Buttons.p1: ../new/Buttons.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Buttons.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Buttons.p1 ../new/Buttons.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Buttons.d ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Buttons.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Calendar.p1: ../new/Calendar.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Calendar.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Calendar.p1 ../new/Calendar.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Calendar.d ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Calendar.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Comparator.p1: ../new/Comparator.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Comparator.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Comparator.p1 ../new/Comparator.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Comparator.d ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Comparator.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/CRC.p1: ../new/CRC.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/CRC.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/CRC.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/CRC.p1 ../new/CRC.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/CRC.d ${OBJECTDIR}/_ext/1360932049/CRC.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/CRC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Dimmer.p1: ../new/Dimmer.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Dimmer.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Dimmer.p1 ../new/Dimmer.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Dimmer.d ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Dimmer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Discipline.p1: ../new/Discipline.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Discipline.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Discipline.p1 ../new/Discipline.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Discipline.d ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Discipline.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/DST.p1: ../new/DST.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/DST.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/DST.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/DST.p1 ../new/DST.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/DST.d ${OBJECTDIR}/_ext/1360932049/DST.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/DST.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/FlashCheck.p1: ../new/FlashCheck.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1 ../new/FlashCheck.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/FlashCheck.d ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/FlashCheck.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/GPS.p1: ../new/GPS.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/GPS.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/GPS.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/GPS.p1 ../new/GPS.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/GPS.d ${OBJECTDIR}/_ext/1360932049/GPS.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/GPS.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Journal.p1: ../new/Journal.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Journal.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Journal.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Journal.p1 ../new/Journal.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Journal.d ${OBJECTDIR}/_ext/1360932049/Journal.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Journal.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Latency.p1: ../new/Latency.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Latency.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Latency.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Latency.p1 ../new/Latency.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Latency.d ${OBJECTDIR}/_ext/1360932049/Latency.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Latency.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/LCD.p1: ../new/LCD.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/LCD.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/LCD.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/LCD.p1 ../new/LCD.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/LCD.d ${OBJECTDIR}/_ext/1360932049/LCD.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/LCD.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1360932049/LEDS.p1: ../new/LEDS.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/LEDS.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ../new/LEDS.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/LEDS.p1 ../new/LEDS.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/LEDS.d ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/LEDS.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/Light.p1: ../new/Light.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Light.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Light.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Light.p1 ../new/Light.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Light.d ${OBJECTDIR}/_ext/1360932049/Light.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Light.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Logger.p1: ../new/Logger.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Logger.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Logger.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Logger.p1 ../new/Logger.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Logger.d ${OBJECTDIR}/_ext/1360932049/Logger.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Logger.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Lux.p1: ../new/Lux.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Lux.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Lux.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Lux.p1 ../new/Lux.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Lux.d ${OBJECTDIR}/_ext/1360932049/Lux.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Lux.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1360932049/Main.p1: ../new/Main.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Main.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Main.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Main.p1 ../new/Main.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Main.p1 ../new/Main.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/Main.d ${OBJECTDIR}/_ext/1360932049/Main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/Modbus.p1: ../new/Modbus.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Modbus.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Modbus.p1 ../new/Modbus.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Modbus.d ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Modbus.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/MSF.p1: ../new/MSF.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/MSF.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/MSF.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/MSF.p1 ../new/MSF.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/MSF.d ${OBJECTDIR}/_ext/1360932049/MSF.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/MSF.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/NVM.p1: ../new/NVM.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/NVM.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/NVM.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/NVM.p1 ../new/NVM.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/NVM.d ${OBJECTDIR}/_ext/1360932049/NVM.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/NVM.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Persist.p1: ../new/Persist.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Persist.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Persist.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Persist.p1 ../new/Persist.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Persist.d ${OBJECTDIR}/_ext/1360932049/Persist.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Persist.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Profile.p1: ../new/Profile.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Profile.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Profile.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Profile.p1 ../new/Profile.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Profile.d ${OBJECTDIR}/_ext/1360932049/Profile.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Profile.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Response.p1: ../new/Response.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Response.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Response.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Response.p1 ../new/Response.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Response.d ${OBJECTDIR}/_ext/1360932049/Response.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Response.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Schedule.p1: ../new/Schedule.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Schedule.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Schedule.p1 ../new/Schedule.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Schedule.d ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Schedule.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1360932049/Timer.p1: ../new/Timer.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Timer.p1.d 
 	@${RM} ${OBJECTDIR}/_ext/1360932049/Timer.p1 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Timer.p1 ../new/Timer.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Timer.p1 ../new/Timer.c 
 	@-${MV} ${OBJECTDIR}/_ext/1360932049/Timer.d ${OBJECTDIR}/_ext/1360932049/Timer.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Timer.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360932049/TimeSync.p1: ../new/TimeSync.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/TimeSync.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/TimeSync.p1 ../new/TimeSync.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/TimeSync.d ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/TimeSync.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/UART.p1: ../new/UART.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/UART.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/UART.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/UART.p1 ../new/UART.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/UART.d ${OBJECTDIR}/_ext/1360932049/UART.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/UART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360932049/Watchdog.p1: ../new/Watchdog.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/_ext/1360932049" 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360932049/Watchdog.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1360932049/Watchdog.p1 ../new/Watchdog.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360932049/Watchdog.d ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360932049/Watchdog.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -172,14 +588,14 @@ endif
 ifeq ($(TYPE_IMAGE), DEBUG_RUN)
 ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk    
 	@${MKDIR} ${DISTDIR} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.map  -D__DEBUG=1  -mdebugger=pickit4  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto        $(COMPARISON_BUILD) -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
+	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.map  -D__DEBUG=1  -mdebugger=pickit4  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto        $(COMPARISON_BUILD) -mreserve=rom@0x8000:0xFFFF -mreserve=rom@0x7FFE:0x7FFF -mchecksum=0-7FFD@7FFE,width=-2,algorithm=5,offset=FFFF,polynomial=1021,revword=2 -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
 	@${RM} ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.hex 
 	
 	
 else
 ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk   
 	@${MKDIR} ${DISTDIR} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.map  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     $(COMPARISON_BUILD) -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
+	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.map  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"  -memi=wordwrite -O0 -fasmfile -maddrqual=require -xassembler-with-cpp -mwarn=-3 -Wa,-a -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-download -mno-default-config-bits -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     $(COMPARISON_BUILD) -mreserve=rom@0x8000:0xFFFF -mreserve=rom@0x7FFE:0x7FFF -mchecksum=0-7FFD@7FFE,width=-2,algorithm=5,offset=FFFF,polynomial=1021,revword=2 -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/supersecretproject.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
 	
 	
 endif
@@ -0,0 +1,495 @@
+/*******************************************************************************
+ * File:   bench_dusk.c
+ * Purpose: Host benchmark - end-to-end dusk response of the dark/light
+ *          decision path: the ADC scan (ADC.c, 32-conversion bursts and the
+ *          EMA), SENSOR_INTERVAL and the threshold/hysteresis rule of the
+ *          main loop, the Light.c ramp and RB1 (PWM6 duty leaving zero). With
+ *          -DDARK_DETECT_COMPARATOR the loop takes C1OUT instead (Comparator.c),
+ *          as Main.c does. Each profile runs BENCH_DAYS noon-to-noon days:
+ *
+ *              step        1000 lux to 0.1 lux at once
+ *              ramp        log-linear, 4 decades an hour
+ *              noisy_ramp  the ramp, clouds in twilight (0.1 decade rms,
+ *                          periods 15-600 s)
+ *
+ *          The loop passes every LOOP_S: the 10 ms delay and the rest of a
+ *          pass (LCD writes go out in LCD_Isr and no longer stretch it).
+ *          Latency runs from the light at the sensor first crossing the
+ *          threshold to RB1 switching on (negative if the lamp beat it: the
+ *          Lux.c table is good to +/-4 clx); a second switch-on the same night
+ *          is a false toggle. CPU time is host time per simulated day for the
+ *          firmware and the loop driving it, so it only compares runs on one
+ *          machine; the loop pass and interrupt counts compare anywhere.
+ *
+ *              make -C test/host bench     build/bench_dusk.json and
+ *                                          build/bench_dusk_comparator.json
+ *
+ *          The JSON uses the keys of tools/duskreport.py, per profile, so
+ *          python3 tools/duskreport.py --compare a.json b.json compares two
+ *          builds (percentiles here are exact, not histogram bucket edges).
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../../new/ADC.h"
+#include "../../new/Comparator.h"
+#include "../../new/Light.h"
+#include "../../new/Lux.h"
+#include "../../new/Response.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+#define BENCH_DAYS      30
+#define DAY_S           86400.0
+#define NOON_S          43200.0
+#define DUSK_S          (18.0 * 3600.0)     /* +/- DUSK_SPREAD_S, day to day */
+#define DUSK_SPREAD_S   1800.0
+#define NIGHT_S         (12.0 * 3600.0)
+#define RAMP_S          3600.0              /* 4 decades */
+#define DAY_LUX         1000.0
+#define NIGHT_LUX       0.1
+
+#define THRESHOLD_CLX   100                 /* 10 lux */
+#define DARK_ABOVE      true                /* LDR on the ground side */
+
+#define LOOP_S          0.0105  /* __delay_ms(10) and the rest of a pass */
+#define T4_S            (16.0 * 256.0 * 16.0 / 16e6)    /* ramp interrupt */
+#define ADC_NOISE_LSB   1.2     /* per conversion, rms */
+#define CLOUD_WAVES     6
+#define TWO_PI          6.283185307179586
+
+#define SHAPE_STEP      0
+#define SHAPE_RAMP      1
+
+typedef struct {
+    const char *name;
+    uint8_t shape;
+    double cloud;               /* decades rms */
+} BenchProfile;
+
+static const BenchProfile PROFILES[] = {
+    {"step",        SHAPE_STEP, 0.0},
+    {"ramp",        SHAPE_RAMP, 0.0},
+    {"noisy_ramp",  SHAPE_RAMP, 0.1},
+};
+#define PROFILE_COUNT   (sizeof(PROFILES) / sizeof(PROFILES[0]))
+
+/* --- Stand-ins: the clock ------------------------------------------------ */
+
+static double s_t;                  /* true seconds since midnight, day 0 */
+
+void Timer_GetStamp(uint32_t *seconds, uint16_t *counts) {
+    double whole = floor(s_t);
+
+    *seconds = (uint32_t)whole;
+    *counts = (uint16_t)((s_t - whole) * 62500.0);
+}
+
+/* --- Sky and sensor ------------------------------------------------------ */
+
+static const BenchProfile *s_profile;
+static double s_dusk[BENCH_DAYS];   /* absolute, one per noon-to-noon day */
+static double s_wave_w[CLOUD_WAVES], s_wave_phase[CLOUD_WAVES];
+
+static uint32_t s_seed;
+
+/* xorshift32: cheap next to the firmware under test, same on every host. */
+static double Uniform(void) {
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 17;
+    s_seed ^= s_seed << 5;
+    return s_seed / 4294967296.0;
+}
+
+/* Roughly normal, unit rms (sum of four uniforms). */
+static double Gauss(void) {
+    return (Uniform() + Uniform() + Uniform() + Uniform() - 2.0) * sqrt(3.0);
+}
+
+static double Sky(double t) {
+    int day = (int)floor((t - NOON_S) / DAY_S);
+    double dusk = s_dusk[day < 0 ? 0 : day >= BENCH_DAYS ? BENCH_DAYS - 1 : day];
+    double into = fmin(t - dusk, dusk + NIGHT_S - t);   /* < 0 by day */
+    double decades;
+
+    if (s_profile->shape == SHAPE_STEP) {
+        return into >= 0.0 ? NIGHT_LUX : DAY_LUX;
+    }
+    decades = (into <= 0.0) ? 0.0 : fmin(4.0 * into / RAMP_S, 4.0);
+    if (decades == 0.0 || decades == 4.0) {
+        return DAY_LUX * pow(10.0, -decades);   /* clouds only matter in twilight */
+    }
+    for (int i = 0; i < CLOUD_WAVES && s_profile->cloud > 0.0; i++) {
+        decades += s_profile->cloud * sqrt(2.0 / CLOUD_WAVES) * sin(s_wave_w[i] * t + s_wave_phase[i]);
+    }
+    return DAY_LUX * pow(10.0, -decades);
+}
+
+/* GL5528-class LDR (10 kohm at 10 lux, gamma 0.7) on the ground side of a
+ * 10 kohm divider: ADC counts, unrounded. */
+static double SensorCounts(double lux) {
+    double r = 10e3 * pow(lux / 10.0, -0.7);
+
+    return 1023.0 * r / (r + 10e3);
+}
+
+/* The sky at the last scan round and at the next: the model is evaluated
+ * once a round, so its cost stays small beside the firmware's. */
+static double s_scan_t[2], s_scan_lux[2], s_scan_counts[2];
+
+static void SkyAhead(double next) {
+    s_scan_t[0] = s_scan_t[1];
+    s_scan_lux[0] = s_scan_lux[1];
+    s_scan_counts[0] = s_scan_counts[1];
+    s_scan_t[1] = next;
+    s_scan_lux[1] = Sky(next);
+    s_scan_counts[1] = SensorCounts(s_scan_lux[1]);
+}
+
+/* ADFLTR: the mean of one burst of 2^5 conversions. */
+static uint16_t Burst(double counts) {
+    double mean = counts + Gauss() * ADC_NOISE_LSB / sqrt(32.0);
+    long adc = lround(mean);
+
+    return (uint16_t)(adc < 0 ? 0 : adc > 1023 ? 1023 : adc);
+}
+
+/* --- Interrupts ---------------------------------------------------------- */
+
+static unsigned long s_isrs;
+
+/* One Timer6 scan round, each burst done in turn (ADTIF). */
+static void ScanRound(void) {
+    uint16_t ldr = Burst(s_scan_counts[1]);
+
+    PIR5bits.TMR6IF = 1;
+    ADCON0bits.ADGO = 0;
+    ADC_Isr();
+    s_isrs++;
+    while (ADCON0bits.ADGO) {
+        uint16_t x = (ADPCH == ADC_LDR_CHANNEL) ? ldr : 512u;
+
+        ADCON0bits.ADGO = 0;
+        ADFLTRH = (uint8_t)(x >> 8);
+        ADFLTRL = (uint8_t)x;
+        PIR1bits.ADTIF = 1;
+        ADC_Isr();
+        s_isrs++;
+    }
+}
+
+#ifdef DARK_DETECT_COMPARATOR
+/* C1 against the raw divider (no burst averaging), DAC1 at DAC1R/32 VDD.
+ * Between scan rounds the divider is interpolated, or the sky evaluated
+ * when the round spans the trip point; noise only matters near it. */
+static void ComparatorSample(void) {
+    double trip = DAC1CON1bits.DAC1R * 32.0;
+    double ldr = s_scan_counts[0] + (s_scan_counts[1] - s_scan_counts[0]) *
+                 (s_t - s_scan_t[0]) / (s_scan_t[1] - s_scan_t[0]);
+
+    if (fmin(s_scan_counts[0], s_scan_counts[1]) < trip + 64.0 &&
+        fmax(s_scan_counts[0], s_scan_counts[1]) > trip - 64.0) {
+        ldr = SensorCounts(Sky(s_t));
+    }
+    if (fabs(ldr - trip) < 8.0 * ADC_NOISE_LSB) {
+        ldr += Gauss() * ADC_NOISE_LSB;
+    }
+    uint8_t out = (uint8_t)((trip > ldr) ^ (CM1CON0bits.POL != 0));
+
+    if (out != CM1CON0bits.OUT) {
+        CM1CON0bits.OUT = out;
+        PIR2bits.C1IF = 1;
+        Comparator_Isr();
+        s_isrs++;
+    }
+}
+#endif
+
+/* --- Results ------------------------------------------------------------- */
+
+typedef struct {
+    double latency_ms[BENCH_DAYS];
+    unsigned n;
+    unsigned nights;
+    unsigned missed;            /* nights the lamp never came on */
+    unsigned early;             /* on before the light crossed: latency < 0 */
+    unsigned false_toggles;
+    unsigned worst_night;
+    unsigned long passes;
+    unsigned long isrs;
+    double cpu_s;
+} BenchResult;
+
+static BenchResult s_results[PROFILE_COUNT];
+static BenchResult *s_r;
+
+static const double THRESHOLD_LUX = 10.0;  /* THRESHOLD_CLX in lux */
+static double s_cross;              /* first threshold crossing tonight, < 0 none */
+static double s_on;                 /* first switch-on tonight */
+static unsigned s_night_ons;
+
+static void SwitchedOn(void) {
+    if (s_night_ons++ == 0u) {
+        s_on = s_t;
+    }
+}
+
+/* Noon. The table is only good to +/-4 clx, so on a slow dusk the lamp can
+ * beat the true crossing: the latency is taken here, signed. */
+static void EndNight(void) {
+    unsigned extra = (s_night_ons > 1u) ? s_night_ons - 1u : 0u;
+
+    if (s_night_ons != 0u && s_cross >= 0.0) {
+        s_r->latency_ms[s_r->n++] = (s_on - s_cross) * 1000.0;
+        s_r->early += (s_on < s_cross);
+    }
+    s_r->nights++;
+    s_r->missed += (s_night_ons == 0u);
+    s_r->false_toggles += extra;
+    if (extra > s_r->worst_night) {
+        s_r->worst_night = extra;
+    }
+    s_night_ons = 0;
+    s_cross = -1.0;
+}
+
+/* Sky went from lux_a at a to lux_b at b: the first downward crossing
+ * tonight, bisected on the sky itself. */
+static void WatchCrossing(double a, double lux_a, double b, double lux_b) {
+    if (s_cross >= 0.0 || lux_b > THRESHOLD_LUX || lux_a <= THRESHOLD_LUX) {
+        return;
+    }
+    for (int i = 0; i < 40; i++) {
+        double m = 0.5 * (a + b);
+
+        if (Sky(m) <= THRESHOLD_LUX) {
+            b = m;
+        } else {
+            a = m;
+        }
+    }
+    s_cross = b;
+}
+
+/* --- Main loop: the sensor and lamp part of Main.c ----------------------- */
+
+static bool     s_is_dark;
+static uint32_t s_last_sensor;
+static uint32_t s_last_second;
+
+#ifndef DARK_DETECT_COMPARATOR
+static bool IsDark(int16_t light_clx) {
+    if (s_is_dark) {
+        return light_clx < THRESHOLD_CLX + LUX_HYST_CLX;
+    }
+    return light_clx <= THRESHOLD_CLX;
+}
+#endif
+
+static void LoopPass(void) {
+    uint32_t clock_now = (uint32_t)s_t;
+
+    while (s_last_second != clock_now) {
+        s_last_second++;
+        if (s_last_second % (uint32_t)DAY_S == (uint32_t)NOON_S) {
+            EndNight();
+        }
+    }
+    if ((clock_now - s_last_sensor) >= SENSOR_INTERVAL) {
+        s_last_sensor = clock_now;
+        int16_t light_clx = Lux_FromAdc(ADC_GetFiltered(ADC_CH_LDR));
+#ifndef DARK_DETECT_COMPARATOR
+        s_is_dark = IsDark(light_clx);
+#else
+        (void)light_clx;
+#endif
+    }
+#ifdef DARK_DETECT_COMPARATOR
+    s_is_dark = Comparator_IsDark();
+#endif
+    Light_SetLevel(s_is_dark ? LIGHT_LEVEL_FULL : LIGHT_LEVEL_OFF);
+    s_r->passes++;
+}
+
+/* --- Run ----------------------------------------------------------------- */
+
+static void RunProfile(unsigned p) {
+    double scan_s, t_loop, t_scan, t_ramp = INFINITY;
+    double end = NOON_S + BENCH_DAYS * DAY_S + 1.0;
+    uint8_t duty = 0;
+    clock_t cpu;
+
+    s_profile = &PROFILES[p];
+    s_r = &s_results[p];
+    s_seed = 50u + p;
+    for (int d = 0; d < BENCH_DAYS; d++) {
+        s_dusk[d] = d * DAY_S + DUSK_S + (2.0 * Uniform() - 1.0) * DUSK_SPREAD_S;
+    }
+    for (int i = 0; i < CLOUD_WAVES; i++) {
+        /* periods 15 s to 600 s, log-spaced */
+        s_wave_w[i] = TWO_PI / (15.0 * pow(40.0, (double)i / (CLOUD_WAVES - 1)));
+        s_wave_phase[i] = TWO_PI * Uniform();
+    }
+
+    /* Power-up at noon, as Main.c: light, the lamp off, scan running. */
+    s_t = NOON_S;
+    Lux_Init(DARK_ABOVE);
+    Light_Init();
+    Light_SetLevelNow(LIGHT_LEVEL_OFF);
+    ADC_Init();
+    ADC_StartScan();
+#ifdef DARK_DETECT_COMPARATOR
+    CM1CON0bits.OUT = 0;
+    Comparator_Init(Lux_ToAdc(THRESHOLD_CLX), Lux_ToAdc(THRESHOLD_CLX + LUX_HYST_CLX), !DARK_ABOVE);
+#endif
+    scan_s = (T6PR + 1u) * 128.0 / 31000.0;
+    s_is_dark = false;
+    s_last_sensor = s_last_second = (uint32_t)s_t;
+    s_cross = -1.0;
+    s_night_ons = 0;
+    s_isrs = 0;
+    t_loop = s_t;
+    t_scan = s_t;
+    SkyAhead(s_t);
+    SkyAhead(s_t);
+
+    cpu = clock();
+    while (s_t < end) {
+        if (t_ramp <= t_loop && t_ramp <= t_scan) {
+            s_t = t_ramp;
+            PIR5bits.TMR4IF = 1;
+            Light_Isr();
+            s_isrs++;
+            if (PWM6DCH != 0 && duty == 0) {
+                SwitchedOn();
+            }
+            duty = PWM6DCH;
+            t_ramp = PIE5bits.TMR4IE ? t_ramp + T4_S : INFINITY;
+        } else if (t_scan <= t_loop) {
+            s_t = t_scan;
+            ScanRound();
+            WatchCrossing(s_scan_t[0], s_scan_lux[0], s_t, s_scan_lux[1]);
+            t_scan += scan_s;
+            SkyAhead(t_scan);
+        } else {
+            s_t = t_loop;
+#ifdef DARK_DETECT_COMPARATOR
+            ComparatorSample();
+#endif
+            LoopPass();
+            if (PIE5bits.TMR4IE && t_ramp == INFINITY) {
+                t_ramp = ceil(s_t / T4_S) * T4_S;   /* Timer4 free-runs */
+            }
+            t_loop += LOOP_S;
+        }
+    }
+    s_r->cpu_s = (double)(clock() - cpu) / CLOCKS_PER_SEC;
+    s_r->isrs = s_isrs;
+}
+
+/* --- Report -------------------------------------------------------------- */
+
+static int CompareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Nearest rank. */
+static long Percentile(const BenchResult *r, unsigned p) {
+    unsigned rank = (p * r->n + 99u) / 100u;
+
+    return r->n ? lround(r->latency_ms[rank ? rank - 1u : 0u]) : 0;
+}
+
+static void WriteProfile(FILE *f, unsigned p, bool last) {
+    BenchResult *r = &s_results[p];
+    double sum = 0.0;
+    unsigned hist[RESP_HIST_BUCKETS] = {0};
+
+    qsort(r->latency_ms, r->n, sizeof(r->latency_ms[0]), CompareDouble);
+    for (unsigned i = 0; i < r->n; i++) {
+        uint8_t b = 0;
+
+        while (b < RESP_HIST_BUCKETS - 1 && r->latency_ms[i] >= (16UL << b)) {
+            b++;
+        }
+        hist[b]++;
+        sum += r->latency_ms[i];
+    }
+
+    fprintf(f, "  \"%s\": {\n", PROFILES[p].name);
+    fprintf(f, "    \"n\": %u,\n", r->n);
+    fprintf(f, "    \"min_ms\": %ld,\n", r->n ? lround(r->latency_ms[0]) : 0L);
+    fprintf(f, "    \"mean_ms\": %ld,\n", r->n ? lround(sum / r->n) : 0L);
+    fprintf(f, "    \"p50_ms\": %ld,\n", Percentile(r, 50));
+    fprintf(f, "    \"p90_ms\": %ld,\n", Percentile(r, 90));
+    fprintf(f, "    \"p99_ms\": %ld,\n", Percentile(r, 99));
+    fprintf(f, "    \"max_ms\": %ld,\n", r->n ? lround(r->latency_ms[r->n - 1u]) : 0L);
+    fprintf(f, "    \"nights\": %u,\n", r->nights);
+    fprintf(f, "    \"missed\": %u,\n", r->missed);
+    fprintf(f, "    \"early\": %u,\n", r->early);
+    fprintf(f, "    \"false_toggles\": %u,\n", r->false_toggles);
+    fprintf(f, "    \"worst_night\": %u,\n", r->worst_night);
+    fprintf(f, "    \"scan_ms\": %u,\n", ADC_SCAN_PERIOD_MS);
+    fprintf(f, "    \"sensor_s\": %u,\n", SENSOR_INTERVAL);
+#ifdef DARK_DETECT_COMPARATOR
+    fprintf(f, "    \"comparator\": 1,\n");
+#else
+    fprintf(f, "    \"comparator\": 0,\n");
+#endif
+    fprintf(f, "    \"loop_passes_per_day\": %lu,\n", r->passes / BENCH_DAYS);
+    fprintf(f, "    \"isr_per_day\": %lu,\n", r->isrs / BENCH_DAYS);
+    fprintf(f, "    \"cpu_ms_per_day\": %.1f,\n", r->cpu_s * 1000.0 / BENCH_DAYS);
+    fprintf(f, "    \"hist\": [");
+    for (unsigned b = 0; b < RESP_HIST_BUCKETS; b++) {
+        fprintf(f, "%s%u", b ? ", " : "", hist[b]);
+    }
+    fprintf(f, "]\n  }%s\n", last ? "" : ",");
+
+    printf("%-10s  n %2u  latency %6ld / %6ld / %6ld ms (p50/p90/max)  "
+           "false toggles %u  %.0f ms CPU a day\n",
+           PROFILES[p].name, r->n, Percentile(r, 50), Percentile(r, 90),
+           r->n ? lround(r->latency_ms[r->n - 1u]) : 0L,
+           r->false_toggles, r->cpu_s * 1000.0 / BENCH_DAYS);
+}
+
+int main(int argc, char **argv) {
+    FILE *f = stdout;
+
+    if (argc > 1 && (f = fopen(argv[1], "w")) == NULL) {
+        perror(argv[1]);
+        return 2;
+    }
+    for (unsigned p = 0; p < PROFILE_COUNT; p++) {
+        RunProfile(p);
+    }
+
+    fprintf(f, "{\n");
+    for (unsigned p = 0; p < PROFILE_COUNT; p++) {
+        WriteProfile(f, p, p + 1u == PROFILE_COUNT);
+    }
+    fprintf(f, "}\n");
+    if (f != stdout) {
+        fclose(f);
+    }
+
+    /* Sanity only: every dusk seen, clean profiles switch once a night, and
+     * a step within one SENSOR_INTERVAL (plus the EMA and ramp). */
+    for (unsigned p = 0; p < PROFILE_COUNT; p++) {
+        BenchResult *r = &s_results[p];
+
+        CHECK(r->nights == BENCH_DAYS && r->missed == 0u && r->n == BENCH_DAYS);
+        if (PROFILES[p].cloud == 0.0) {
+            CHECK(r->false_toggles == 0u);
+        }
+        if (PROFILES[p].shape == SHAPE_STEP) {
+            CHECK(r->early == 0u);
+            CHECK(r->latency_ms[r->n - 1u] <= SENSOR_INTERVAL * 1000.0 + 2000.0);
+        }
+    }
+    return CHECK_DONE("bench_dusk");
+}
@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * File:   check.h
+ * Purpose: Minimal assertions for the host tests: CHECK reports the failing
+ *          line and carries on; CHECK_DONE prints the tally and gives the
+ *          exit status.
+ ******************************************************************************/
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+static unsigned check_run, check_failed;
+
+#define CHECK(cond) do { \
+        check_run++; \
+        if (!(cond)) { \
+            check_failed++; \
+            printf("%s:%d: FAIL %s\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+static int CHECK_DONE(const char *name) {
+    printf("%s: %u checks, %u failed\n", name, check_run, check_failed);
+    return check_failed ? 1 : 0;
+}
+
+#endif /* CHECK_H */
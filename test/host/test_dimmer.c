@@ -0,0 +1,247 @@
+/*******************************************************************************
+ * File:   test_dimmer.c
+ * Purpose: Host test - constant-illuminance PI loop (Dimmer.c with Lux.c)
+ *          over a simulated dusk. Daylight falls from 1000 to 0.01 lux in
+ *          an hour; the lamp adds a fixed number of lux per level at the
+ *          lit-area sensor and follows the Light.c ramp (64 levels/s). The
+ *          sensor is a GL5528-class LDR in its own divider, read once per
+ *          100 ms scan round with ADC noise. Checks the light held at the
+ *          setpoint across lamp gains, with the dark/light LDR calibrated
+ *          either way round, a headlight passing, the save-window ceiling
+ *          and saturation.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../new/Dimmer.h"
+#include "../../new/ADC.h"
+#include "../../new/Light.h"
+#include "../../new/Lux.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+#define STEP_S          (ADC_SCAN_PERIOD_MS / 1000.0)
+#define RAMP_PER_S      (255.0 / LIGHT_RAMP_SECONDS)
+#define DUSK_S          3600.0
+#define SETPOINT        ((double)DIM_SETPOINT_LUX)
+
+/* --- Stand-ins: the scan and the lamp ------------------------------------ */
+
+static uint16_t s_adc[ADC_CH_COUNT];
+static uint16_t s_scans;
+static uint8_t  s_target;           /* Light_SetLevel */
+static double   s_level;            /* output, ramping towards it */
+
+uint16_t ADC_GetLatest(uint8_t ch) {
+    return s_adc[ch];
+}
+
+uint16_t ADC_GetScanCount(void) {
+    return s_scans;
+}
+
+void Light_SetLevel(uint8_t level) {
+    s_target = level;
+}
+
+/* --- Sensor and scene ---------------------------------------------------- */
+
+static double s_lamp_gain;          /* lux at the sensor at full power */
+static int    s_noise;              /* +/- ADC counts */
+
+/* GL5528-class LDR: 10 kohm at 10 lux, gamma 0.7, 10 kohm divider wired
+ * as Config.h says. */
+static uint16_t SensorAdc(double lux) {
+    double r = 10e3 * pow((lux < 0.01 ? 0.01 : lux) / 10.0, -0.7);
+    double v = DIM_SENSOR_DARK_ABOVE ? r / (r + 10e3) : 10e3 / (r + 10e3);
+    int adc = (int)lround(1023.0 * v);
+
+    if (s_noise) {
+        adc += rand() % (2 * s_noise + 1) - s_noise;
+    }
+    return (uint16_t)(adc < 0 ? 0 : adc > 1023 ? 1023 : adc);
+}
+
+static double Lamp(void) {
+    return s_lamp_gain * s_level / 255.0;
+}
+
+/* 1000 lux at t = 0 down to 0.01 lux at the end of the dusk, log-linear. */
+static double Daylight(double t) {
+    double f = t / DUSK_S;
+
+    return 1000.0 * pow(10.0, -5.0 * (f > 1.0 ? 1.0 : f));
+}
+
+static double s_t;
+static double s_extra;              /* headlights etc. */
+
+static double Total(void) {
+    return Daylight(s_t) + Lamp() + s_extra;
+}
+
+/* One scan round: the lamp ramps for a round, the sensor is read, then
+ * the main loop runs the task (twice: only one step per round). */
+static void Round(void) {
+    double max = RAMP_PER_S * STEP_S;
+
+    s_t += STEP_S;
+    if (s_level < s_target) {
+        s_level = fmin(s_level + max, s_target);
+    } else {
+        s_level = fmax(s_level - max, s_target);
+    }
+    s_adc[ADC_CH_DIM] = SensorAdc(Total());
+    s_adc[ADC_CH_LDR] = 0;          /* the dark/light LDR: unused here */
+    s_scans++;
+    Dimmer_Task();
+    Dimmer_Task();
+}
+
+static void Begin(double gain) {
+    s_lamp_gain = gain;
+    s_t = 0.0;
+    s_extra = 0.0;
+    s_level = 0.0;
+    s_target = 0;
+    Dimmer_Init();
+    Dimmer_SetCeiling(LIGHT_LEVEL_FULL);
+}
+
+/* Within the sensor's resolution at the setpoint (one LUX_TABLE step
+ * spans ~8 clx here, 2 %) plus a level of lamp and the noise. */
+static double Tolerance(void) {
+    return 0.03 * SETPOINT + 1.5 * s_lamp_gain / 255.0 + 0.5;
+}
+
+/* --- Tests --------------------------------------------------------------- */
+
+static void TestDusk(double gain) {
+    double worst = 0.0, bright_level = 0.0;
+    unsigned bright = 0, held = 0;
+
+    Begin(gain);
+    while (s_t < DUSK_S + 600.0) {
+        Round();
+        if (Daylight(s_t) > 1.5 * SETPOINT) {
+            /* Daylight alone is enough: the lamp stays (nearly) off. */
+            bright_level = fmax(bright_level, s_level);
+            bright++;
+        } else if (Daylight(s_t) < 0.8 * SETPOINT &&
+                   Daylight(s_t) > SETPOINT - gain + 1.0) {
+            worst = fmax(worst, fabs(Total() - SETPOINT));
+            held++;
+        }
+    }
+    printf("lamp %4.0f lux: level %3.0f at night, %.0f while bright, "
+           "worst %.2f lux off the setpoint over %u rounds (tolerance %.2f)\n",
+           gain, s_level, bright_level, worst, held, Tolerance());
+    CHECK(bright > 0 && bright_level <= 2.0);
+    CHECK(held > 1000u && worst <= Tolerance());
+    CHECK(fabs(Total() - SETPOINT) <= Tolerance());
+    CHECK(fabs(Dimmer_GetMeasured() - SETPOINT) <= Tolerance() + 1.0);
+}
+
+/* A car's headlights add 50 lux for 5 s: the lamp backs off at the rate
+ * limit, then comes back without overshooting the setpoint. */
+static void TestHeadlights(void) {
+    double low = 1e9, high = 0.0;
+
+    Begin(100.0);
+    while (s_t < DUSK_S) {
+        Round();
+    }
+    double level = s_level;
+    s_extra = 50.0;
+    for (int i = 0; i < 50; i++) {
+        Round();
+    }
+    CHECK(s_level < level / 2.0);
+    s_extra = 0.0;
+    for (int i = 0; i < 300; i++) {
+        Round();
+        low = fmin(low, Total());
+        if (i >= 20) {
+            high = fmax(high, Total());
+        }
+    }
+    printf("headlights: light dips to %.1f lux after, peaks %.1f lux once back\n", low, high);
+    CHECK(low < SETPOINT);
+    CHECK(high <= SETPOINT + Tolerance());
+    CHECK(fabs(s_level - level) <= 2.0);
+}
+
+/* Ceiling lowered (a save window at the dim level) then raised again. */
+static void TestCeiling(void) {
+    Begin(60.0);
+    while (s_t < DUSK_S) {
+        Round();
+    }
+    CHECK(s_level > 77.0);          /* 20 of 60 lux: level ~85 */
+    Dimmer_SetCeiling(77);
+    for (int i = 0; i < 30; i++) {
+        Round();
+    }
+    CHECK(s_target == 77 && fabs(s_level - 77.0) < 1e-9);
+    Dimmer_SetCeiling(LIGHT_LEVEL_FULL);
+    for (int i = 0; i < 200; i++) {
+        Round();
+    }
+    CHECK(fabs(Total() - SETPOINT) <= Tolerance());
+
+    /* Ceiling off (daytime) resets the loop: the lamp goes straight off. */
+    Dimmer_SetCeiling(LIGHT_LEVEL_OFF);
+    Round();
+    CHECK(s_target == LIGHT_LEVEL_OFF);
+}
+
+/* A lamp too weak for the setpoint saturates at the ceiling; once help
+ * arrives (headlights) the loop leaves the ceiling at once, no windup. */
+static void TestSaturation(void) {
+    Begin(10.0);
+    while (s_t < DUSK_S + 600.0) {
+        Round();
+    }
+    CHECK(s_target == LIGHT_LEVEL_FULL);
+    s_extra = 30.0;
+    for (int i = 0; i < 20; i++) {
+        Round();
+    }
+    CHECK(s_target < LIGHT_LEVEL_FULL - 60);
+}
+
+/* Only one control step per scan round, however often the task runs. */
+static void TestOncePerRound(void) {
+    Begin(300.0);
+    s_t = DUSK_S;
+    s_adc[ADC_CH_DIM] = SensorAdc(Total());
+    s_scans++;
+    Dimmer_Task();
+    uint8_t first = s_target;
+    for (int i = 0; i < 10; i++) {
+        Dimmer_Task();
+    }
+    CHECK(first > 0 && first <= DIM_RATE_STEP && s_target == first);
+}
+
+int main(void) {
+    srand(46);
+    s_noise = 2;
+
+    /* The dark/light LDR calibrated either way round: the dimming sensor
+     * keeps its own orientation. */
+    for (int o = 0; o < 2; o++) {
+        Lux_Init(o ? DIM_SENSOR_DARK_ABOVE : !DIM_SENSOR_DARK_ABOVE);
+        TestDusk(40.0);
+        TestDusk(100.0);
+        TestDusk(300.0);
+        TestDusk(600.0);
+    }
+    TestHeadlights();
+    TestCeiling();
+    TestSaturation();
+    TestOncePerRound();
+    return CHECK_DONE("test_dimmer");
+}
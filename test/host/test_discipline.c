@@ -0,0 +1,348 @@
+/*******************************************************************************
+ * File:   test_discipline.c
+ * Purpose: Host test - Timer0 tick, 1PPS snapshot and the frequency-locked
+ *          loop (Timer.c, Discipline.c). Timer0 is modelled as a counter
+ *          running at 62.5 kHz off by a chosen crystal error; each overflow
+ *          calls the high-priority ISR, which reloads it, and each 1PPS edge
+ *          (true seconds plus jitter) snapshots it through the same ISR.
+ *          The main loop is Discipline_Task after every interrupt. Checks
+ *          the phase sign and step logic, that large steps never wrap the
+ *          reload, and that the loop locks, holds over and saves its trim.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../new/Timer.h"
+#include "../../new/Discipline.h"
+#include "../../new/Latency.h"
+#include "../../new/NVM.h"
+#include "../../new/CRC.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+#define COUNT_HZ        62500.0     /* Fosc/4 / 256 */
+#define NOMINAL         62501.0     /* counts per tick at TMR0_RELOAD */
+
+void ISR(void);                     /* Timer.c, high priority */
+
+/* --- Stand-ins ----------------------------------------------------------- */
+
+volatile uint8_t g_latency_tag;
+static uint16_t s_latency;          /* last ISR entry latency, cycles */
+static unsigned s_latencies;
+
+void Latency_Record(uint16_t cycles, uint32_t tick) {
+    (void)tick;
+    s_latency = cycles;
+    s_latencies++;
+}
+
+static uint8_t s_ee[256];
+static unsigned s_ee_writes;
+
+uint8_t NVM_EERead(uint16_t address) {
+    return s_ee[address & 0xFFu];
+}
+
+void NVM_EEWrite(uint16_t address, uint8_t value) {
+    s_ee[address & 0xFFu] = value;
+    s_ee_writes++;
+}
+
+bool NVM_EEBusy(void) {
+    return false;
+}
+
+uint16_t CRC_Block(const void *data, uint8_t len) {
+    const uint8_t *p = data;
+    uint16_t crc = CRC_SEED;
+
+    while (len--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* --- Timer0 and the reference -------------------------------------------- */
+
+static double   s_rate;             /* counts per true second */
+static double   s_tick_start;       /* true time the current tick began */
+static uint16_t s_tick_reload;      /* ... from this count */
+static double   s_shortest, s_longest;  /* tick lengths seen, counts */
+
+static double Overflow(void) {
+    return s_tick_start + (65536.0 - s_tick_reload) / s_rate;
+}
+
+static void SetTmr0(uint16_t v) {
+    TMR0L = (uint8_t)v;
+    TMR0H = (uint8_t)(v >> 8);
+}
+
+/* Timer1 at true time t: Fosc/4, off the same crystal as Timer0. */
+static void SetTmr1(double t) {
+    uint16_t v = (uint16_t)llround(t * s_rate * 256.0);
+
+    TMR1L = (uint8_t)v;
+    TMR1H = (uint8_t)(v >> 8);
+}
+
+static void TickIsr(double at, uint16_t latency) {
+    double length = 65536.0 - s_tick_reload;
+
+    if (length < s_shortest) {
+        s_shortest = length;
+    }
+    if (length > s_longest) {
+        s_longest = length;
+    }
+    SetTmr0(latency);
+    SetTmr1(at);
+    PIR0bits.TMR0IF = 1;
+    ISR();
+    s_tick_start = at;
+    s_tick_reload = (uint16_t)(((uint16_t)TMR0H << 8) | TMR0L);
+}
+
+static void Tick(void) {
+    TickIsr(Overflow(), 0);
+    Discipline_Task(Timer_GetTicks());
+}
+
+/* 1PPS edge at true time t, with every earlier overflow already run. An
+ * edge just after an overflow finds the tick interrupt still pending. */
+static void EdgeIsr(double t) {
+    double over = Overflow();
+
+    PIR0bits.INT1IF = 1;
+    SetTmr1(t);
+    if (t >= over) {
+        SetTmr0((uint16_t)((t - over) * s_rate));
+        PIR0bits.TMR0IF = 1;
+        ISR();                      /* INT1 then the tick, in one entry */
+        s_tick_start = t;           /* the reload is written at entry */
+        s_tick_reload = (uint16_t)(((uint16_t)TMR0H << 8) | TMR0L);
+    } else {
+        SetTmr0((uint16_t)(s_tick_reload + (t - s_tick_start) * s_rate));
+        ISR();
+    }
+}
+
+static double s_now;                /* true seconds */
+static double s_jitter;             /* edge jitter, +/- seconds */
+static double s_pps_offset;         /* reference second vs true second */
+
+static double Jitter(void) {
+    return s_jitter * (2.0 * rand() / RAND_MAX - 1.0);
+}
+
+/* Run for n seconds; with_pps false = reference lost. */
+static void Run(unsigned n, bool with_pps) {
+    for (unsigned i = 0; i < n; i++) {
+        double edge = floor(s_now) + 1.0 + s_pps_offset + Jitter();
+
+        while (Overflow() < edge - 2.0 / s_rate) {
+            Tick();
+        }
+        if (with_pps) {
+            EdgeIsr(edge);
+            Discipline_Task(Timer_GetTicks());
+        }
+        s_now = floor(s_now) + 1.0;
+    }
+    while (Overflow() < s_now + s_pps_offset) {
+        Tick();
+    }
+}
+
+/* Phase of the next edge against the tick, in counts, without feeding it
+ * to the loop. */
+static double TickError(void) {
+    double edge = floor(s_now) + 1.0 + s_pps_offset;
+    double over = Overflow();
+    double period = 65536.0 - (double)(uint16_t)(TMR0_RELOAD_HIGH << 8 | TMR0_RELOAD_LOW);
+    double e = (edge - over) * s_rate;
+
+    while (e > period / 2) {
+        e -= period;
+    }
+    while (e < -period / 2) {
+        e += period;
+    }
+    return e;
+}
+
+/* True fractional frequency error of the tick with the current trim, ppm. */
+static double TickPpm(void) {
+    double counts = NOMINAL + Timer_GetTrim() / 256.0;
+    return (counts / s_rate - 1.0) * 1e6;
+}
+
+static void Start(double ppm, double pps_offset) {
+    s_rate = COUNT_HZ * (1.0 + ppm * 1e-6);
+    s_now = 0.0;
+    s_pps_offset = pps_offset;
+    s_tick_start = 0.0;
+    s_tick_reload = (uint16_t)(TMR0_RELOAD_HIGH << 8 | TMR0_RELOAD_LOW);
+    s_shortest = 1e9;
+    s_longest = 0.0;
+    Timer_Init();
+    Timer_SetTrim(0);
+    Timer_StepPhase(0);
+    Run(5, false);                  /* power-up before the reference */
+    s_now = 0.0;
+}
+
+/* --- Tests --------------------------------------------------------------- */
+
+/* Timer alone: the snapshot's sign and a step later than a tick can hold. */
+static void TestPhaseAndStep(void) {
+    int16_t phase;
+    uint32_t tick;
+
+    Start(0.0, 0.0);
+    Tick();
+    /* 1000 counts after the tick, then 1000 before the next */
+    EdgeIsr(s_tick_start + 1000.5 / s_rate);
+    CHECK(Timer_GetPps(&phase, &tick) && phase == 1000 && tick == Timer_GetTicks());
+    EdgeIsr(Overflow() - 999.5 / s_rate);
+    CHECK(Timer_GetPps(&phase, &tick) && phase == -1000 && tick == Timer_GetTicks() + 1u);
+    CHECK(!Timer_GetPps(&phase, &tick));
+    /* Just after the overflow, the tick's interrupt still pending */
+    EdgeIsr(Overflow() + 3.5 / s_rate);
+    CHECK(Timer_GetPps(&phase, &tick) && phase == 3 && tick == Timer_GetTicks());
+
+    /* 25000 counts later: nearly half a tick, far more than one reload
+     * can add. It must come out as longer ticks adding up to the step. */
+    double before = Overflow();
+    uint32_t ticks = Timer_GetTicks();
+    Timer_StepPhase(25000);
+    s_shortest = 1e9;
+    s_longest = 0.0;
+    for (int i = 0; i < 12; i++) {
+        TickIsr(Overflow(), 0);
+    }
+    CHECK(s_shortest >= NOMINAL);
+    CHECK(s_longest <= 65536.0);
+    CHECK(fabs((Overflow() - before) * s_rate - (12.0 * NOMINAL + 25000.0)) < 1.0);
+    CHECK(Timer_GetTicks() == ticks + 12u);
+
+    /* Earlier: one short tick */
+    before = Overflow();
+    Timer_StepPhase(-25000);
+    TickIsr(Overflow(), 0);
+    TickIsr(Overflow(), 0);
+    CHECK(fabs((Overflow() - before) * s_rate - (2.0 * NOMINAL - 25000.0)) < 1.0);
+}
+
+/* ISR entry latency: Timer1 read at entry against the overflow the last
+ * reload set up, to the cycle; over 4 ms (255 Timer0 counts) it saturates. */
+static void TestLatency(void) {
+    static const uint16_t LATE[] = {0, 7, 64, 1000, 60000, 5, 0};
+
+    Start(+30.0, 0.0);
+    CHECK(s_latencies > 0u);        /* every tick after the first reload */
+    for (unsigned i = 0; i < sizeof(LATE) / sizeof(LATE[0]); i++) {
+        double at = Overflow() + LATE[i] / (s_rate * 256.0);
+
+        TickIsr(at, (uint16_t)(LATE[i] / 256u));
+        CHECK(abs((int16_t)(s_latency - LATE[i])) <= 1);
+    }
+    TickIsr(Overflow() + 300.0 / s_rate, 300);
+    CHECK(s_latency == 0xFFFFu);
+    Timer_StepPhase(-20000);        /* a stepped reload is followed too */
+    Tick();
+    TickIsr(Overflow() + 20.0 / (s_rate * 256.0), 0);
+    CHECK(abs((int16_t)(s_latency - 20u)) <= 1);
+}
+
+/* From power-up: crystal off by ppm, reference second pps_offset away.
+ * Jitter beyond about one count (16 us) keeps the 64 s drift above the
+ * settled limit now and then, so only LOCKED itself waits on a quiet edge. */
+static void Lock(double ppm, double pps_offset, double jitter_us, unsigned seconds) {
+    s_jitter = jitter_us * 1e-6;
+    Start(ppm, pps_offset);
+    Run(seconds, true);
+    printf("%+7.1f ppm, ref %+.3f s, jitter %3.0f us: state %u, trim %+5d, "
+           "residual %+.2f ppm, phase %+.1f counts, ticks %.0f..%.0f\n",
+           ppm, pps_offset, jitter_us, Discipline_GetState(), Timer_GetTrim(),
+           TickPpm(), TickError(), s_shortest, s_longest);
+    CHECK(Discipline_GetState() == DISC_LOCKED || jitter_us > 16.0);
+    CHECK(Discipline_GetState() >= DISC_TRACKING);
+    CHECK(fabs(TickPpm()) < 0.5);
+    CHECK(fabs(TickError()) <= 63.0 + 4.0);     /* DISC_PHASE_LIMIT + jitter */
+    CHECK(s_longest <= 65536.0 && s_shortest >= 65536.0 - 3035.0 - 31251.0);
+}
+
+static void TestLock(void) {
+    Lock(0.0, 0.0, 0.0, 600);
+    Lock(+50.0, +0.40, 8.0, 900);
+    Lock(-120.0, -0.30, 16.0, 900);
+    Lock(+180.0, +0.05, 16.0, 1200);    /* near the 200 ppm trim limit */
+    Lock(-37.5, +0.499, 8.0, 900);      /* the reference half a tick later */
+    Lock(+90.0, -0.45, 50.0, 900);      /* a poor reference still tracks */
+}
+
+static void TestHoldoverAndSave(void) {
+    int16_t trim, saved;
+
+    s_ee_writes = 0;
+    Lock(+75.0, 0.2, 8.0, 900);
+    trim = Timer_GetTrim();
+    Run(1, true);                       /* last EEPROM byte goes out */
+    CHECK(s_ee_writes >= 4u);
+    saved = (int16_t)(s_ee[DISC_EE_ADDRESS] | (s_ee[DISC_EE_ADDRESS + 1] << 8));
+    CHECK(CRC_Block(&s_ee[DISC_EE_ADDRESS], 2) ==
+          (uint16_t)(s_ee[DISC_EE_ADDRESS + 2] | (s_ee[DISC_EE_ADDRESS + 3] << 8)));
+    CHECK(abs(saved - trim) < 16);
+
+    /* Reference gone: the trim is held and the clock keeps its rate. */
+    Run(30, false);
+    CHECK(Discipline_GetState() == DISC_HOLDOVER);
+    CHECK(Timer_GetTrim() == trim);
+    CHECK(fabs(TickPpm()) < 0.5);
+
+    /* Back: locks again without losing the trim on the way. */
+    Run(600, true);
+    CHECK(Discipline_GetState() == DISC_LOCKED);
+    CHECK(fabs(TickPpm()) < 0.5);
+}
+
+/* Outliers (a missed second, an edge 5 ms out) restart the measurement
+ * but never pull the trim. */
+static void TestOutliers(void) {
+    Lock(-20.0, 0.1, 8.0, 900);
+    for (int i = 0; i < 10; i++) {
+        int16_t trim = Timer_GetTrim();
+        double save = s_pps_offset;
+
+        Run(20, true);
+        s_pps_offset = save + 0.005;
+        Run(1, true);
+        s_pps_offset = save;
+        Run(1, false);
+        CHECK(abs(Timer_GetTrim() - trim) < 16);
+    }
+    Run(600, true);
+    CHECK(Discipline_GetState() == DISC_LOCKED);
+    CHECK(fabs(TickPpm()) < 0.5);
+}
+
+int main(void) {
+    srand(44);
+    Discipline_Init();                  /* blank EEPROM: no saved trim */
+    CHECK(Discipline_GetState() == DISC_NO_REFERENCE);
+    CHECK(PIE0bits.INT1IE == 1 && IPR0bits.INT1IP == 1);
+
+    TestPhaseAndStep();
+    TestLatency();
+    TestLock();
+    TestHoldoverAndSave();
+    TestOutliers();
+    return CHECK_DONE("test_discipline");
+}
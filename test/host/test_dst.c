@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * File:   test_dst.c
+ * Purpose: Host test - DST_FromUTC (DST.c with Calendar.c). Every half hour
+ *          of 2026-2027 in every zone is converted and compared with a
+ *          reference worked out here from the legal rules: local date and
+ *          minute, summer-time state, UTC offset and the switch hour armed
+ *          for the day. The same instant is also given as a negative minute
+ *          against the next day's calendar.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include "../../new/DST.h"
+#include "../../new/Calendar.h"
+#include "check.h"
+
+#define MIN_PER_DAY     1440L
+#define LAST            5
+
+typedef struct {
+    uint8_t month, week, hour;      /* Sunday rule; hour on the clock in force */
+} Rule;
+
+typedef struct {
+    int16_t std;                    /* standard time minus UTC, minutes */
+    int16_t shift;
+    Rule    start, end;             /* month 0: no summer time */
+} Zone;
+
+static const Zone ZONE[DST_ZONE_COUNT] = {
+    [DST_ZONE_NONE] = {    0,  0, { 0, 0, 0}, { 0, 0, 0} },
+    [DST_ZONE_UK]   = {    0, 60, { 3, LAST, 1}, {10, LAST, 2} },  /* 01:00 UTC both */
+    [DST_ZONE_EU]   = {   60, 60, { 3, LAST, 2}, {10, LAST, 3} },
+    [DST_ZONE_US]   = { -300, 60, { 3, 2, 2}, {11, 1, 2} },
+    [DST_ZONE_AU]   = {  600, 60, {10, 1, 2}, { 4, 1, 3} },
+};
+
+/* Days since 1 Jan 1970 (proleptic Gregorian) and back. */
+static long DaysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void CivilFromDays(long z, int *y, int *m, int *d) {
+    z += 719468;
+    long era = (z >= 0 ? z : z - 146096) / 146097;
+    long doe = z - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    *d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *y = (int)(yoe + era * 400 + (*m <= 2));
+}
+
+/* Day (since 1970) of the rule's Sunday in year y. */
+static long RuleDay(int y, const Rule *r) {
+    if (r->week == LAST) {
+        long last = DaysFromCivil(r->month == 12 ? y + 1 : y, r->month % 12 + 1, 1) - 1;
+        return last - (last + 4) % 7;           /* 1 Jan 1970 was a Thursday */
+    }
+    long first = DaysFromCivil(y, r->month, 1);
+    return first + (7 - (first + 4) % 7) % 7 + 7L * (r->week - 1);
+}
+
+/* UTC minute (since 1970) of the change, its hour read on the clock in
+ * force before it. */
+static long StartUtc(const Zone *z, int y) {
+    return RuleDay(y, &z->start) * MIN_PER_DAY + z->start.hour * 60L - z->std;
+}
+
+static long EndUtc(const Zone *z, int y) {
+    return RuleDay(y, &z->end) * MIN_PER_DAY + z->end.hour * 60L - z->std - z->shift;
+}
+
+static bool RefSummer(const Zone *z, long utc) {
+    int y, m, d;
+
+    if (z->start.month == 0) {
+        return false;
+    }
+    /* The local year decides which rules apply (same for both offsets
+     * except in the hours around the new year, far from any change). */
+    CivilFromDays((utc + z->std) / MIN_PER_DAY, &y, &m, &d);
+    long start = StartUtc(z, y), end = EndUtc(z, y);
+    if (start < end) {
+        return utc >= start && utc < end;
+    }
+    return utc >= start || utc < end;
+}
+
+/* Local switch hour armed today: the next change falls on today's local date. */
+static uint8_t RefSwitchHour(const Zone *z, long utc, bool summer) {
+    long offset = z->std + (summer ? z->shift : 0);
+    long today = (utc + offset) / MIN_PER_DAY;
+    int y, m, d;
+
+    if (z->start.month == 0) {
+        return DST_NO_SWITCH;
+    }
+    CivilFromDays(today, &y, &m, &d);
+    long change = summer ? EndUtc(z, y) : StartUtc(z, y);
+    if (change > utc && (change + offset) / MIN_PER_DAY == today) {
+        uint8_t hour = summer ? z->end.hour : z->start.hour;
+        return (uint8_t)(((hour / 10) << 4) | (hour % 10));
+    }
+    return DST_NO_SWITCH;
+}
+
+static unsigned s_failures;
+
+static void CheckInstant(uint8_t zone, long utc, int day_ahead) {
+    const Zone *z = &ZONE[zone];
+    bool summer = RefSummer(z, utc);
+    long local = utc + z->std + (summer ? z->shift : 0);
+    int y, m, d, ly, lm, ld;
+    uint16_t minute;
+    bool ok;
+
+    CivilFromDays(utc / MIN_PER_DAY + day_ahead, &y, &m, &d);
+    Calendar_Init((uint16_t)y, (uint8_t)m, (uint8_t)d);
+    minute = DST_FromUTC(zone, (int16_t)(utc % MIN_PER_DAY - day_ahead * MIN_PER_DAY));
+
+    CivilFromDays(local / MIN_PER_DAY, &ly, &lm, &ld);
+    ok = minute == local % MIN_PER_DAY &&
+         Calendar_GetYear() == ly && Calendar_GetMonth() == lm && Calendar_GetDay() == ld &&
+         DST_IsActive() == summer &&
+         DST_UtcOffset() == z->std + (summer ? z->shift : 0) &&
+         DST_GetZone() == zone &&
+         DST_SwitchHour() == RefSwitchHour(z, utc, summer);
+    if (!ok && s_failures++ < 10) {
+        CivilFromDays(utc / MIN_PER_DAY, &y, &m, &d);
+        printf("zone %u, %04d-%02d-%02d %02ld:%02ld UTC (day %+d): got %u min %04u-%02u-%02u "
+               "%s sw %02X, want %ld min %04d-%02d-%02d %s sw %02X\n",
+               zone, y, m, d, utc % MIN_PER_DAY / 60, utc % 60, day_ahead,
+               minute, Calendar_GetYear(), Calendar_GetMonth(), Calendar_GetDay(),
+               DST_IsActive() ? "summer" : "std", DST_SwitchHour(),
+               local % MIN_PER_DAY, ly, lm, ld, summer ? "summer" : "std",
+               RefSwitchHour(z, utc, summer));
+    }
+}
+
+static void TestAllYear(void) {
+    long from = DaysFromCivil(2026, 1, 1) * MIN_PER_DAY;
+    long to = DaysFromCivil(2028, 1, 1) * MIN_PER_DAY;
+
+    for (uint8_t zone = 0; zone < DST_ZONE_COUNT; zone++) {
+        for (long utc = from; utc < to; utc += 30) {
+            CheckInstant(zone, utc, 0);
+            if (utc % MIN_PER_DAY != 0) {
+                CheckInstant(zone, utc, 1);     /* utc_minute -1439..-1 */
+            }
+        }
+    }
+    CHECK(s_failures == 0);
+}
+
+/* The hours either side of each 2026 change, spelled out. */
+static void TestChanges(void) {
+    Calendar_Init(2026, 3, 29);
+    CHECK(DST_FromUTC(DST_ZONE_UK, 59) == 59 && !DST_IsActive());
+    CHECK(DST_SwitchHour() == 0x01);
+    CHECK(DST_FromUTC(DST_ZONE_UK, 60) == 120 && DST_IsActive());
+    CHECK(DST_SwitchHour() == DST_NO_SWITCH);
+
+    Calendar_Init(2026, 10, 25);
+    CHECK(DST_FromUTC(DST_ZONE_UK, 30) == 90 && DST_IsActive());     /* 01:30 BST */
+    CHECK(DST_FromUTC(DST_ZONE_UK, 90) == 90 && !DST_IsActive());    /* 01:30 GMT */
+
+    Calendar_Init(2026, 3, 8);
+    CHECK(DST_FromUTC(DST_ZONE_US, 7 * 60) == 3 * 60 && DST_IsActive());
+    CHECK(Calendar_GetDay() == 8);
+
+    /* West of Greenwich the date goes back, east it goes on. */
+    Calendar_Init(2026, 1, 1);
+    CHECK(DST_FromUTC(DST_ZONE_US, 2 * 60) == 21 * 60);
+    CHECK(Calendar_GetYear() == 2025 && Calendar_GetMonth() == 12 && Calendar_GetDay() == 31);
+    Calendar_Init(2026, 12, 31);
+    CHECK(DST_FromUTC(DST_ZONE_AU, 20 * 60) == 7 * 60 && DST_IsActive());
+    CHECK(Calendar_GetYear() == 2027 && Calendar_GetMonth() == 1 && Calendar_GetDay() == 1);
+
+    /* Out-of-range zone keeps the current one. */
+    Calendar_Init(2026, 7, 1);
+    CHECK(DST_FromUTC(DST_ZONE_COUNT, 600) == 600 + 600 && DST_GetZone() == DST_ZONE_AU);
+}
+
+/* Calendar_Init keeps the date real whatever it is given. */
+static void TestClamp(void) {
+    Calendar_Init(2026, 2, 31);
+    CHECK(Calendar_GetDay() == 28 && Calendar_GetDayBCD() == 0x28);
+    Calendar_Init(2028, 2, 30);
+    CHECK(Calendar_GetDay() == 29);
+    Calendar_Init(2026, 4, 0);
+    CHECK(Calendar_GetDay() == 1);
+    Calendar_Init(2026, 13, 40);
+    CHECK(Calendar_GetMonth() == 1 && Calendar_GetDay() == 31);
+    CHECK(Calendar_DaysInMonth(2000, 2) == 29 && Calendar_DaysInMonth(2100, 2) == 28);
+    CHECK(Calendar_DaysInMonth(2026, 0) == 0 && Calendar_DaysInMonth(2026, 13) == 0);
+}
+
+int main(void) {
+    TestClamp();
+    TestChanges();
+    TestAllYear();
+    return CHECK_DONE("test_dst");
+}
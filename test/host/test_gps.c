@@ -0,0 +1,206 @@
+/*******************************************************************************
+ * File:   test_gps.c
+ * Purpose: Host test - byte-wise NMEA parser and checksum (GPS.c). Sentences
+ *          are fed one byte per EUSART1 RX interrupt, with the checksum
+ *          computed here, and include the receiver faults the ISR handles:
+ *          framing and overrun errors, a line cut short, corrupt bytes.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../new/GPS.h"
+#include "check.h"
+
+static void RxByte(uint8_t c) {
+    RC1REG = c;
+    PIR3bits.RC1IF = 1;
+    GPS_Isr();
+}
+
+static void RxRaw(const char *s) {
+    while (*s) {
+        RxByte((uint8_t)*s++);
+    }
+}
+
+/* "$" body "*hh\r\n", hh the XOR of sum_of (normally the body itself). */
+static void RxWithChecksum(const char *body, const char *sum_of) {
+    char tail[8];
+    uint8_t sum = 0;
+
+    for (const char *p = sum_of; *p; p++) {
+        sum ^= (uint8_t)*p;
+    }
+    snprintf(tail, sizeof(tail), "*%02X\r\n", sum);
+    RxByte('$');
+    RxRaw(body);
+    RxRaw(tail);
+}
+
+static void RxSentence(const char *body) {
+    RxWithChecksum(body, body);
+}
+
+static bool TimeIs(const GpsTime *t, uint8_t y, uint8_t mo, uint8_t d,
+                   uint8_t h, uint8_t mi, uint8_t s) {
+    return t->year == y && t->month == mo && t->day == d &&
+           t->hours == h && t->minutes == mi && t->seconds == s;
+}
+
+static void TestRmc(void) {
+    GpsTime t;
+    int16_t lat, lon;
+
+    CHECK(!GPS_GetTime(&t));
+    CHECK(!GPS_GetPosition(&lat, &lon));
+    RxSentence("GPRMC,213045.00,A,5130.1234,N,00007.5678,W,0.02,,181026,,,A");
+    CHECK(GPS_GetTime(&t));
+    CHECK(TimeIs(&t, 0x26, 0x10, 0x18, 0x21, 0x30, 0x45));
+    CHECK(!GPS_GetTime(&t));                /* once per fix */
+    /* 51 deg 30.12' N, 0 deg 7.56' W, in hundredths of a degree */
+    CHECK(GPS_GetPosition(&lat, &lon));
+    CHECK(lat == 5150 && lon == -12);
+
+    /* Other talkers, one fraction digit, southern/eastern hemisphere */
+    RxSentence("GNRMC,000000.0,A,3351.5,S,15112.9,E,,,010127,,");
+    CHECK(GPS_GetTime(&t));
+    CHECK(TimeIs(&t, 0x27, 0x01, 0x01, 0x00, 0x00, 0x00));
+    CHECK(GPS_GetPosition(&lat, &lon));
+    CHECK(lat == -3385 && lon == 15121);
+
+    /* No fix ('V'): neither time nor position is taken */
+    RxSentence("GPRMC,101010.00,V,1000.0000,N,01000.0000,E,,,181026,,");
+    CHECK(!GPS_GetTime(&t));
+    CHECK(GPS_GetPosition(&lat, &lon));
+    CHECK(lat == -3385 && lon == 15121);
+
+    /* Leap second: 23:59:60 is held at :59 */
+    RxSentence("GPRMC,235960.00,A,5130.0000,N,00000.0000,E,,,311226,,");
+    CHECK(GPS_GetTime(&t));
+    CHECK(TimeIs(&t, 0x26, 0x12, 0x31, 0x23, 0x59, 0x59));
+}
+
+static void TestZda(void) {
+    GpsTime t;
+    int16_t lat, lon;
+
+    RxSentence("GPZDA,120001.00,07,03,2027,00,00");
+    CHECK(GPS_GetTime(&t));
+    CHECK(TimeIs(&t, 0x27, 0x03, 0x07, 0x12, 0x00, 0x01));
+    /* ZDA carries no position: the last one stands */
+    CHECK(GPS_GetPosition(&lat, &lon));
+    CHECK(lat == 5150 && lon == 0);
+
+    /* Missing year or a two-digit one: no time */
+    RxSentence("GPZDA,120002.00,07,03,,00,00");
+    RxSentence("GPZDA,120003.00,07,03,27,00,00");
+    CHECK(!GPS_GetTime(&t));
+}
+
+static void TestIgnored(void) {
+    GpsTime t;
+    uint16_t errors = GPS_GetErrors();
+    uint16_t sentences = GPS_GetSentences();
+
+    RxSentence("GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+    RxSentence("GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00");
+    RxSentence("GPRMA,A,4807.038,N,01131.000,E,,,,,,");      /* R, but not RMC */
+    RxSentence("GPZDAX,120001.00,07,03,2027,00,00");        /* too long */
+    RxRaw("garbage before a sentence\r\n");
+    CHECK(!GPS_GetTime(&t));
+    CHECK(GPS_GetErrors() == errors);
+    CHECK(GPS_GetSentences() == sentences);
+}
+
+static void TestErrors(void) {
+    GpsTime t;
+    uint16_t errors = GPS_GetErrors();
+
+    /* Good fix first, then faults: each costs only its own sentence */
+    RxSentence("GPRMC,080000.00,A,5130.0000,N,00000.0000,E,,,020226,,");
+    CHECK(GPS_GetTime(&t));
+
+    RxRaw("$GPRMC,080001.00,A,5130.0000,N,00000.0000,E,,,020226,,*00\r\n");
+    CHECK(!GPS_GetTime(&t));
+    CHECK(GPS_GetErrors() == errors + 1u);
+
+    RxRaw("$GPRMC,080002.00,A,5130.0000,N,00000.0000,E,,,020226,,\r\n");
+    CHECK(GPS_GetErrors() == errors + 2u);          /* no checksum */
+
+    RxRaw("$GPRMC,080003.00,A,5130.0000,N,00000.0000,E,,,020226,,*4g\r\n");
+    CHECK(GPS_GetErrors() == errors + 3u);          /* not hex */
+
+    /* Framing error part-way through */
+    RxRaw("$GPRMC,0800");
+    RC1STAbits.FERR = 1;
+    RxByte(0x00);
+    RC1STAbits.FERR = 0;
+    RxRaw("04.00,A,5130.0000,N,00000.0000,E,,,020226,,*00\r\n");
+    CHECK(GPS_GetErrors() == errors + 4u);
+
+    /* Overrun: the receiver is restarted and the sentence dropped */
+    RC1STAbits.CREN = 1;
+    RxRaw("$GPRMC,0800");
+    RC1STAbits.OERR = 1;
+    RxByte('0');
+    RC1STAbits.OERR = 0;
+    CHECK(RC1STAbits.CREN == 1);
+    CHECK(GPS_GetErrors() == errors + 5u);
+
+    /* A new '$' restarts a sentence that never finished */
+    RxRaw("$GPRMC,080005.00,A,51");
+    RxSentence("GPRMC,080006.00,A,5130.0000,N,00000.0000,E,,,020226,,");
+    CHECK(GPS_GetTime(&t));
+    CHECK(TimeIs(&t, 0x26, 0x02, 0x02, 0x08, 0x00, 0x06));
+
+    /* Out-of-range fields with a good checksum are still refused */
+    RxSentence("GPRMC,246000.00,A,5130.0000,N,00000.0000,E,,,020226,,");
+    RxSentence("GPRMC,080007.00,A,5130.0000,N,00000.0000,E,,,320226,,");
+    RxSentence("GPRMC,080008.00,A,5130.0000,N,00000.0000,E,,,021326,,");
+    CHECK(!GPS_GetTime(&t));
+}
+
+/* Any one byte of a sentence changed: the XOR checksum rejects it, and the
+ * fix from before is not disturbed. */
+static void TestCorruption(void) {
+    static const char good[] = "GPRMC,174512.00,A,5130.1234,N,00007.5678,W,,,150326,,";
+    GpsTime t;
+    int16_t lat, lon;
+    unsigned accepted = 0;
+    unsigned refreshed = 0;
+
+    srand(7);
+    for (unsigned trial = 0; trial < 2000; trial++) {
+        char body[sizeof(good)];
+        size_t pos = (size_t)rand() % (sizeof(good) - 1u);
+        char c = (char)(' ' + rand() % 95);
+
+        if (c == good[pos] || c == '$' || c == '*') {
+            continue;
+        }
+        RxSentence(good);
+        refreshed += GPS_GetTime(&t);
+        memcpy(body, good, sizeof(good));
+        body[pos] = c;
+        RxWithChecksum(body, good);
+        accepted += GPS_GetTime(&t);
+    }
+    CHECK(refreshed > 1900u);
+    CHECK(accepted == 0);
+    CHECK(GPS_GetPosition(&lat, &lon));
+    CHECK(lat == 5150 && lon == -12);
+}
+
+int main(void) {
+    GPS_Init();
+    CHECK(PIE3bits.RC1IE == 1 && IPR3bits.RC1IP == 0);
+
+    TestRmc();
+    TestZda();
+    TestIgnored();
+    TestErrors();
+    TestCorruption();
+    return CHECK_DONE("test_gps");
+}
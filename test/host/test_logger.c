@@ -0,0 +1,257 @@
+/*******************************************************************************
+ * File:   test_logger.c
+ * Purpose: Host test - flash history logger (Logger.c) through a program
+ *          flash stand-in that only clears bits and insists on an erase
+ *          before each row write. Every record logged is kept here and the
+ *          dump must give them back in order: runs (and run splits), the
+ *          largest zigzag deltas and the absolute resyncs beyond them, lamp
+ *          and time-mark records, a page still waiting in RAM for its erase
+ *          or write, a restart from flash, and the ring wrapping over its
+ *          oldest page.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../new/Logger.h"
+#include "../../new/NVM.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+#define FLASH_SIZE      (LOG_FLASH_END - LOG_FLASH_START)
+#define PAGES           (FLASH_SIZE / NVM_FLASH_ROW_SIZE)
+#define MAX_RECORDS     40000u
+
+/* --- Stand-in: program flash --------------------------------------------- */
+
+static uint8_t  s_flash[FLASH_SIZE];
+static unsigned s_erases, s_writes, s_bad_writes, s_bad_addresses;
+
+static uint32_t Offset(uint32_t address) {
+    if (address < LOG_FLASH_START || address >= LOG_FLASH_END) {
+        s_bad_addresses++;
+        return 0;
+    }
+    return address - LOG_FLASH_START;
+}
+
+uint8_t NVM_FlashReadByte(uint32_t address) {
+    return s_flash[Offset(address)];
+}
+
+void NVM_FlashRead(uint32_t address, uint8_t *buf, uint8_t len) {
+    memcpy(buf, &s_flash[Offset(address)], len);
+}
+
+void NVM_FlashEraseRow(uint32_t address) {
+    memset(&s_flash[Offset(address) & ~(NVM_FLASH_ROW_SIZE - 1u)], 0xFF, NVM_FLASH_ROW_SIZE);
+    s_erases++;
+}
+
+void NVM_FlashWriteRow(uint32_t address, const uint8_t *buf) {
+    uint8_t *row = &s_flash[Offset(address)];
+
+    for (unsigned i = 0; i < NVM_FLASH_ROW_SIZE; i++) {
+        s_bad_writes += (row[i] != 0xFF);
+        row[i] &= buf[i];
+    }
+    s_writes++;
+}
+
+/* --- Reference log --------------------------------------------------------- */
+
+static LogRecord s_ref[MAX_RECORDS];
+static unsigned  s_count;
+static uint32_t  s_minute;
+static uint32_t  s_tick;
+
+static void Light(uint16_t value) {
+    s_minute++;
+    Logger_LogLight(s_minute, value);
+    s_ref[s_count++] = (LogRecord){LOG_REC_LIGHT, s_minute, value > 1023u ? 1023u : value};
+}
+
+static void Lamp(bool on) {
+    Logger_LogLamp(s_minute, on);
+    s_ref[s_count++] = (LogRecord){LOG_REC_LAMP, s_minute, on};
+}
+
+/* The main loop: one Logger_Task per tick. */
+static void Ticks(unsigned n) {
+    while (n--) {
+        Logger_Task(++s_tick);
+    }
+}
+
+static LogRecord s_dump[MAX_RECORDS];
+
+static unsigned Dump(void) {
+    unsigned n = 0;
+
+    Logger_DumpBegin();
+    while (n < MAX_RECORDS && Logger_DumpNext(&s_dump[n])) {
+        n++;
+    }
+    return n;
+}
+
+static bool Same(const LogRecord *a, const LogRecord *b) {
+    return a->type == b->type && a->minute == b->minute && a->value == b->value;
+}
+
+/* The dump is exactly the last n records logged. */
+static bool DumpIsTail(unsigned n) {
+    if (n > s_count) {
+        return false;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        if (!Same(&s_dump[i], &s_ref[s_count - n + i])) {
+            printf("record %u: got %u/%lu/%u, logged %u/%lu/%u\n", i,
+                   s_dump[i].type, (unsigned long)s_dump[i].minute, s_dump[i].value,
+                   s_ref[s_count - n + i].type, (unsigned long)s_ref[s_count - n + i].minute,
+                   s_ref[s_count - n + i].value);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void Begin(void) {
+    memset(s_flash, 0xFF, sizeof(s_flash));
+    s_count = 0;
+    s_minute = 1000;
+    Logger_Init();
+}
+
+/* --- Tests --------------------------------------------------------------- */
+
+static void TestCodes(void) {
+    Begin();
+    CHECK(Dump() == 0);
+
+    Light(500);                     /* first of a page: absolute */
+    for (int i = 0; i < 150; i++) {
+        Light(500);                 /* runs of 64, 64 and 22 */
+    }
+    Light(563);                     /* +63, the largest delta */
+    Light(499);                     /* -64 */
+    Light(563);                     /* +64: absolute */
+    Light(498);                     /* -65: absolute */
+    Light(1023);
+    Light(2000);                    /* clamped to 1023 */
+    Light(0);
+    Light(1);
+    Lamp(true);                     /* same minute as the reading */
+    Light(1);
+    s_minute += 45;                 /* a gap: time mark */
+    Light(700);
+    Lamp(false);
+    s_minute += 3;
+    Lamp(true);                     /* lamp alone at a new minute: mark */
+    Light(700);
+    s_minute -= 60;                 /* DST back an hour: mark */
+    Light(701);
+    Light(701);
+    Ticks(4);
+    CHECK(s_erases == 0);           /* still one page, all in RAM */
+    CHECK(Dump() == s_count && DumpIsTail(s_count));
+}
+
+/* A full page handed to Logger_Task is read from RAM until it is written,
+ * and never from the stale flash row. */
+static void TestPending(void) {
+    unsigned pages;
+
+    Begin();
+    for (int i = 0; i < 300; i++) {
+        Light((uint16_t)(i * 7 % 1024));
+    }
+    pages = s_erases;
+    Ticks(0);
+    CHECK(Dump() == s_count && DumpIsTail(s_count));  /* nothing flushed yet */
+    Ticks(1);                                          /* erased, not written */
+    CHECK(s_erases > pages);
+    CHECK(Dump() == s_count && DumpIsTail(s_count));
+    Ticks(1);                                          /* written */
+    CHECK(Dump() == s_count && DumpIsTail(s_count));
+    Ticks(10);
+    CHECK(Dump() == s_count && DumpIsTail(s_count));
+    CHECK(s_bad_writes == 0);
+}
+
+/* After a restart only what reached flash is left; logging carries on
+ * after it, in the next page. */
+static void TestRestart(void) {
+    unsigned before, after;
+    LogRecord last;
+
+    Begin();
+    srand(26);
+    for (int i = 0; i < 2000; i++) {
+        Light((uint16_t)(300 + rand() % 40));
+        if (i % 97 == 0) {
+            Lamp(i % 2);
+        }
+        Ticks(1);
+    }
+    Ticks(4);
+    before = Dump();
+    CHECK(before == s_count && DumpIsTail(s_count));
+
+    Logger_Init();
+    after = Dump();
+    last = s_dump[after - 1u];
+    CHECK(after < before && after + 128u > before);
+    bool kept = true;
+    for (unsigned i = 0; i < after; i++) {
+        kept = kept && Same(&s_dump[i], &s_ref[i]);
+    }
+    CHECK(kept);                    /* the oldest records, in order */
+
+    /* Records since: the kept ones, then the new ones. */
+    s_count = after;
+    s_minute = last.minute + 500;
+    Light(321);
+    Light(322);
+    Lamp(true);
+    CHECK(Dump() == s_count && DumpIsTail(s_count));
+}
+
+/* Random readings, mostly absolute (two bytes), fill the ring fast: once it
+ * wraps, the dump starts at the oldest page still held and runs on to the
+ * newest record without a gap. */
+static void TestWrap(void) {
+    unsigned n;
+
+    Begin();
+    srand(126);
+    while (s_erases < PAGES + PAGES / 2) {
+        Light((uint16_t)(rand() % 1024));
+        Ticks(1);
+    }
+    n = Dump();
+    printf("wrap: %u records logged, %u held in %u pages\n", s_count, n, (unsigned)PAGES);
+    CHECK(n < s_count);
+    CHECK(n > (PAGES - 1u) * ((NVM_FLASH_ROW_SIZE - 7u) / 2u));
+    CHECK(DumpIsTail(n));
+
+    /* A page full but not yet erased: its row still holds a page from the
+     * last time round, which must not be read. */
+    for (int i = 0; i < 70; i++) {
+        Light((uint16_t)(rand() % 1024));
+    }
+    CHECK(DumpIsTail(Dump()));
+    Ticks(1);
+    CHECK(DumpIsTail(Dump()));
+    CHECK(s_bad_writes == 0);
+}
+
+int main(void) {
+    TestCodes();
+    TestPending();
+    TestRestart();
+    TestWrap();
+    CHECK(s_bad_addresses == 0);
+    return CHECK_DONE("test_logger");
+}
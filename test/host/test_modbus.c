@@ -0,0 +1,340 @@
+/*******************************************************************************
+ * File:   test_modbus.c
+ * Purpose: Host test - Modbus-RTU frame handling and CRC (Modbus.c). Bytes
+ *          go in through the EUSART2 RX interrupt path, the t3.5 gap is the
+ *          Timer2 flag, and the reply is collected from TX2REG as the TX
+ *          interrupt streams it. The CRC is checked against a bit-by-bit
+ *          reference and the published example frames.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../new/Modbus.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+static uint16_t s_regs[MB_REG_COUNT];
+static uint8_t s_reply[300];
+static uint16_t s_reply_len;
+
+/* --- Application side (Main.c on the target) ------------------------------ */
+
+uint16_t Modbus_ReadRegister(uint8_t addr) {
+    return s_regs[addr];
+}
+
+bool Modbus_WriteRegister(uint8_t addr, uint16_t value) {
+    if (addr == MB_REG_LDR) {               /* one read-only register is enough */
+        return false;
+    }
+    s_regs[addr] = value;
+    return true;
+}
+
+bool Modbus_CheckRegister(uint8_t addr, uint16_t value) {
+    (void)value;
+    return addr != MB_REG_LDR;
+}
+
+void Timer_GetStamp(uint32_t *seconds, uint16_t *counts) {
+    *seconds = 0;
+    *counts = 0;
+}
+
+/* --- Bus --------------------------------------------------------------------- */
+
+static uint16_t RefCrc(const uint8_t *p, uint16_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+        crc ^= *p++;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 1u) ? (uint16_t)((crc >> 1) ^ 0xA001u) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static void RxByte(uint8_t b, uint8_t framing) {
+    RC2STAbits.FERR = framing;
+    RC2REG = b;
+    PIR3bits.RC2IF = 1;
+    Modbus_Isr();
+    PIR3bits.RC2IF = 0;
+    RC2STAbits.FERR = 0;
+}
+
+static void Gap(void) {
+    PIR5bits.TMR2IF = 1;
+    Modbus_Isr();
+}
+
+/* Run the main loop once, then let the TX ISR send whatever it queued. */
+static void Serve(void) {
+    s_reply_len = 0;
+    Modbus_Task();
+    PIR3bits.TX2IF = 1;
+    while (PIE3bits.TX2IE && s_reply_len < sizeof(s_reply)) {
+        Modbus_Isr();
+        s_reply[s_reply_len++] = TX2REG;
+    }
+    PIR3bits.TX2IF = 0;
+    if (s_reply_len) {
+        CHECK(LATDbits.LATD2 == 1);         /* driver on while sending */
+        Gap();
+        CHECK(LATDbits.LATD2 == 0);
+        CHECK(RC2STAbits.CREN == 1);
+    }
+}
+
+/* Send len bytes, append the CRC unless raw, close the frame and serve it. */
+static void Request(const uint8_t *p, uint16_t len, bool raw) {
+    uint16_t crc = RefCrc(p, len);
+    for (uint16_t i = 0; i < len; i++) {
+        RxByte(p[i], 0);
+    }
+    if (!raw) {
+        RxByte((uint8_t)crc, 0);
+        RxByte((uint8_t)(crc >> 8), 0);
+    }
+    Gap();
+    Serve();
+}
+
+static bool ReplyCrcOk(void) {
+    return s_reply_len >= 4 && RefCrc(s_reply, s_reply_len) == 0;
+}
+
+static void CheckException(uint8_t fc, uint8_t code) {
+    CHECK(s_reply_len == 5);
+    CHECK(s_reply[1] == (uint8_t)(fc | 0x80));
+    CHECK(s_reply[2] == code);
+    CHECK(ReplyCrcOk());
+}
+
+/* --- Tests ------------------------------------------------------------------- */
+
+static void TestCrcTable(void) {
+    /* The specification's example: 01 03 00 00 00 0A C5 CD. */
+    static const uint8_t example[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x0A, 0xC5, 0xCD };
+    for (uint16_t i = 0; i < MB_REG_COUNT; i++) {
+        s_regs[i] = (uint16_t)(0x1000 + i);
+    }
+    Request(example, sizeof(example), true);
+    CHECK(s_reply_len == 3 + 20 + 2);
+    CHECK(s_reply[0] == 0x01 && s_reply[1] == 0x03 && s_reply[2] == 20);
+    CHECK(s_reply[3] == 0x10 && s_reply[4] == 0x00);
+    CHECK(s_reply[21] == 0x10 && s_reply[22] == 0x09);
+    CHECK(ReplyCrcOk());
+
+    /* Every byte value through the ISR's table: a frame is only answered
+     * when the running CRC matches, here with an address exception. */
+    for (uint16_t first = 0; first <= 10; first += 10) {
+        uint8_t all[7 + 246] = { MODBUS_SLAVE_ADDRESS, 0x10, 0x00, 0x00, 0x00, 123, 246 };
+        for (uint16_t i = 0; i < 246; i++) {
+            all[7 + i] = (uint8_t)(first + i);
+        }
+        Request(all, sizeof(all), false);
+        CheckException(0x10, 0x02);
+    }
+}
+
+static void TestRead(void) {
+    const uint8_t req[] = { MODBUS_SLAVE_ADDRESS, 0x03, 0x00, MB_REG_LDR, 0x00, 0x02 };
+    s_regs[MB_REG_LDR] = 0x0321;
+    s_regs[MB_REG_THRESHOLD] = 0x0200;
+    Request(req, sizeof(req), false);
+    CHECK(s_reply_len == 3 + 4 + 2);
+    CHECK(s_reply[2] == 4);
+    CHECK(s_reply[3] == 0x03 && s_reply[4] == 0x21);
+    CHECK(s_reply[5] == 0x02 && s_reply[6] == 0x00);
+    CHECK(ReplyCrcOk());
+}
+
+static void TestReadErrors(void) {
+    const uint8_t past_end[] = { MODBUS_SLAVE_ADDRESS, 0x03, 0x00, MB_REG_COUNT - 1, 0x00, 0x02 };
+    const uint8_t none[] = { MODBUS_SLAVE_ADDRESS, 0x03, 0x00, 0x00, 0x00, 0x00 };
+    const uint8_t too_many[] = { MODBUS_SLAVE_ADDRESS, 0x03, 0x00, 0x00, 0x00, 126 };
+    const uint8_t short_pdu[] = { MODBUS_SLAVE_ADDRESS, 0x03, 0x00, 0x00, 0x01 };
+    const uint8_t unknown[] = { MODBUS_SLAVE_ADDRESS, 0x2B, 0x0E, 0x01, 0x00 };
+
+    Request(past_end, sizeof(past_end), false);
+    CheckException(0x03, 0x02);
+    Request(none, sizeof(none), false);
+    CheckException(0x03, 0x03);
+    Request(too_many, sizeof(too_many), false);
+    CheckException(0x03, 0x03);
+    Request(short_pdu, sizeof(short_pdu), false);
+    CheckException(0x03, 0x03);
+    Request(unknown, sizeof(unknown), false);
+    CheckException(0x2B, 0x01);
+}
+
+static void TestWrite(void) {
+    const uint8_t single[] = { MODBUS_SLAVE_ADDRESS, 0x06, 0x00, MB_REG_THRESHOLD, 0x01, 0x90 };
+    const uint8_t read_only[] = { MODBUS_SLAVE_ADDRESS, 0x06, 0x00, MB_REG_LDR, 0x00, 0x01 };
+    const uint8_t multi[] = { MODBUS_SLAVE_ADDRESS, 0x10, 0x00, MB_REG_SAVE_START, 0x00, 0x02, 0x04,
+                              0x00, 0x17, 0x00, 0x05 };
+    const uint8_t bad_count[] = { MODBUS_SLAVE_ADDRESS, 0x10, 0x00, MB_REG_SAVE_START, 0x00, 0x02, 0x03,
+                                  0x00, 0x17, 0x00, 0x05 };
+    const uint8_t across_ldr[] = { MODBUS_SLAVE_ADDRESS, 0x10, 0x00, MB_REG_LDR - 1, 0x00, 0x03, 0x06,
+                                   0x00, 0x01, 0x00, 0x02, 0x00, 0x03 };
+
+    Request(single, sizeof(single), false);
+    CHECK(s_regs[MB_REG_THRESHOLD] == 400);
+    CHECK(s_reply_len == 8 && memcmp(s_reply, single, 6) == 0 && ReplyCrcOk());
+
+    Request(read_only, sizeof(read_only), false);
+    CheckException(0x06, 0x03);
+
+    Request(multi, sizeof(multi), false);
+    CHECK(s_regs[MB_REG_SAVE_START] == 23 && s_regs[MB_REG_SAVE_END] == 5);
+    CHECK(s_reply_len == 8 && memcmp(s_reply, multi, 6) == 0 && ReplyCrcOk());
+
+    s_regs[MB_REG_SAVE_START] = 0;
+    Request(bad_count, sizeof(bad_count), false);
+    CheckException(0x10, 0x03);
+    CHECK(s_regs[MB_REG_SAVE_START] == 0);
+
+    /* One refused register refuses the lot: the ones before it are kept. */
+    s_regs[MB_REG_LDR - 1] = 0;
+    s_regs[MB_REG_LDR + 1] = 0;
+    Request(across_ldr, sizeof(across_ldr), false);
+    CheckException(0x10, 0x03);
+    CHECK(s_regs[MB_REG_LDR - 1] == 0 && s_regs[MB_REG_LDR + 1] == 0);
+}
+
+/* Idle (flash work allowed) only between frames, after t3.5 of silence. */
+static void TestIdle(void) {
+    const uint8_t req[] = { MODBUS_SLAVE_ADDRESS, 0x03, 0x00, 0x00, 0x00, 0x01 };
+    uint16_t crc = RefCrc(req, sizeof(req));
+
+    CHECK(Modbus_IsIdle());
+    for (uint16_t i = 0; i < sizeof(req); i++) {
+        RxByte(req[i], 0);
+        CHECK(!Modbus_IsIdle());
+    }
+    RxByte((uint8_t)crc, 0);
+    RxByte((uint8_t)(crc >> 8), 0);
+    Gap();
+    CHECK(!Modbus_IsIdle());                /* waiting for Modbus_Task */
+    Modbus_Task();
+    CHECK(!Modbus_IsIdle());                /* reply going out */
+    PIR3bits.TX2IF = 1;
+    while (PIE3bits.TX2IE) {
+        Modbus_Isr();
+    }
+    PIR3bits.TX2IF = 0;
+    CHECK(!Modbus_IsIdle());                /* last byte draining */
+    Gap();
+    CHECK(Modbus_IsIdle());
+}
+
+static void TestDropped(void) {
+    const uint8_t req[] = { MODBUS_SLAVE_ADDRESS, 0x06, 0x00, MB_REG_THRESHOLD, 0x00, 0x42 };
+    const uint8_t other[] = { MODBUS_SLAVE_ADDRESS + 1, 0x06, 0x00, MB_REG_THRESHOLD, 0x00, 0x43 };
+    uint8_t corrupt[8];
+    uint16_t crc = RefCrc(req, sizeof(req));
+
+    s_regs[MB_REG_THRESHOLD] = 0;
+
+    /* Bad CRC: silence, and nothing written. */
+    memcpy(corrupt, req, sizeof(req));
+    corrupt[6] = (uint8_t)crc;
+    corrupt[7] = (uint8_t)((crc >> 8) ^ 0x01);
+    Request(corrupt, sizeof(corrupt), true);
+    CHECK(s_reply_len == 0 && s_regs[MB_REG_THRESHOLD] == 0);
+
+    /* Someone else's address. */
+    Request(other, sizeof(other), false);
+    CHECK(s_reply_len == 0 && s_regs[MB_REG_THRESHOLD] == 0);
+
+    /* A framing error anywhere drops the frame even with a good CRC. */
+    for (uint16_t i = 0; i < sizeof(req); i++) {
+        RxByte(req[i], i == 3);
+    }
+    RxByte((uint8_t)crc, 0);
+    RxByte((uint8_t)(crc >> 8), 0);
+    Gap();
+    Serve();
+    CHECK(s_reply_len == 0 && s_regs[MB_REG_THRESHOLD] == 0);
+
+    /* Too short to be a frame. */
+    RxByte(MODBUS_SLAVE_ADDRESS, 0);
+    RxByte(0x03, 0);
+    Gap();
+    Serve();
+    CHECK(s_reply_len == 0);
+
+    /* A gap in the middle splits the request: both halves are dropped. */
+    for (uint16_t i = 0; i < 3; i++) {
+        RxByte(req[i], 0);
+    }
+    Gap();
+    for (uint16_t i = 3; i < sizeof(req); i++) {
+        RxByte(req[i], 0);
+    }
+    RxByte((uint8_t)crc, 0);
+    RxByte((uint8_t)(crc >> 8), 0);
+    Gap();
+    Serve();
+    CHECK(s_reply_len == 0 && s_regs[MB_REG_THRESHOLD] == 0);
+
+    /* Longer than an ADU: dropped, and the next frame is served normally. */
+    for (uint16_t i = 0; i < 300; i++) {
+        RxByte((uint8_t)i, 0);
+    }
+    Gap();
+    Serve();
+    CHECK(s_reply_len == 0);
+    Request(req, sizeof(req), false);
+    CHECK(s_regs[MB_REG_THRESHOLD] == 0x42 && ReplyCrcOk());
+}
+
+static void TestBroadcast(void) {
+    const uint8_t write[] = { 0x00, 0x06, 0x00, MB_REG_THRESHOLD, 0x01, 0x23 };
+    const uint16_t values[3] = { 0x1234, 0xABCD, 0x0007 };
+
+    /* A broadcast request is carried out but never answered. */
+    Request(write, sizeof(write), false);
+    CHECK(s_reply_len == 0 && s_regs[MB_REG_THRESHOLD] == 0x0123);
+
+    /* Sending one: refused while traffic was heard since the last try. */
+    CHECK(!Modbus_Broadcast(MB_REG_SYNC_TIME_HI, 3, values));
+    CHECK(Modbus_Broadcast(MB_REG_SYNC_TIME_HI, 3, values));
+    PIR3bits.TX2IF = 1;
+    s_reply_len = 0;
+    while (PIE3bits.TX2IE && s_reply_len < sizeof(s_reply)) {
+        Modbus_Isr();
+        s_reply[s_reply_len++] = TX2REG;
+    }
+    PIR3bits.TX2IF = 0;
+    Gap();
+    CHECK(s_reply_len == 7 + 6 + 2);
+    CHECK(s_reply[0] == 0x00 && s_reply[1] == 0x10);
+    CHECK(s_reply[3] == MB_REG_SYNC_TIME_HI && s_reply[5] == 3 && s_reply[6] == 6);
+    CHECK(s_reply[7] == 0x12 && s_reply[8] == 0x34 && s_reply[12] == 0x07);
+    CHECK(ReplyCrcOk());
+    CHECK(LATDbits.LATD2 == 0);
+
+    /* Its own frame is not heard (receiver off), so the next one may go. */
+    CHECK(Modbus_Broadcast(MB_REG_SYNC_TIME_HI, 3, values));
+    PIR3bits.TX2IF = 1;
+    while (PIE3bits.TX2IE) {
+        Modbus_Isr();
+    }
+    PIR3bits.TX2IF = 0;
+    Gap();
+}
+
+int main(void) {
+    Modbus_Init();
+    TestCrcTable();
+    TestRead();
+    TestReadErrors();
+    TestWrite();
+    TestDropped();
+    TestIdle();
+    TestBroadcast();
+    return CHECK_DONE("test_modbus");
+}
@@ -0,0 +1,339 @@
+/*******************************************************************************
+ * File:   test_msf.c
+ * Purpose: Host test - MSF time-code decoder (MSF.c). Minute frames are
+ *          built bit by bit from the MSF specification and played into the
+ *          decoder as receiver edges: CCP4 captures of a free-running
+ *          Timer5 (31 counts per ms, wrapping every 2.1 s) with interrupt
+ *          latency, so captures and overflows sometimes arrive together.
+ *          Covers clean and jittered signals, glitches, dropped seconds,
+ *          a lost signal, parity errors, leap seconds and midnight, and a
+ *          long noisy run that must never confirm a wrong time.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../new/MSF.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+#define COUNTS_PER_MS   31u
+#define MS(ms)          ((uint64_t)(ms) * COUNTS_PER_MS)
+#define MAX_LATENCY     40u         /* counts, ~1.3 ms */
+
+/* --- Timer5 / CCP4 ----------------------------------------------------------- */
+
+static uint64_t s_now;              /* Timer5 counts since the test began */
+static uint64_t s_next_wrap;
+static unsigned s_together[2];      /* overflow pending with a capture: after, before it */
+
+static void Service(void) {
+    for (uint8_t i = 0; i < 4; i++) {
+        if (!(PIR6bits.CCP4IF || PIR5bits.TMR5IF)) {
+            return;
+        }
+        MSF_Isr();
+    }
+    CHECK(!(PIR6bits.CCP4IF || PIR5bits.TMR5IF));   /* ISR left a flag */
+}
+
+/* Overflows nothing else is pending with, up to time t. */
+static void RunTo(uint64_t t) {
+    while (s_next_wrap + MAX_LATENCY < t) {
+        PIR5bits.TMR5IF = 1;
+        Service();
+        s_next_wrap += 0x10000u;
+    }
+}
+
+/* Receiver edge at t. The ISR runs a little later: an overflow that falls
+ * just before or inside that latency is pending along with the capture. */
+static void Edge(uint64_t t, bool carrier_off) {
+    uint64_t service = t + (uint64_t)(rand() % (MAX_LATENCY + 1));
+
+    RunTo(t);
+    while (s_next_wrap <= service) {
+        PIR5bits.TMR5IF = 1;
+        s_next_wrap += 0x10000u;
+    }
+    CCPR4L = (uint8_t)t;
+    CCPR4H = (uint8_t)(t >> 8);
+    PIR6bits.CCP4IF = 1;
+    PORTDbits.RD3 = carrier_off ? MSF_CARRIER_OFF_LEVEL : !MSF_CARRIER_OFF_LEVEL;
+    if (PIR5bits.TMR5IF) {
+        s_together[(t & 0x8000u) != 0]++;
+    }
+    Service();
+    s_now = t;
+}
+
+/* --- Transmitter ------------------------------------------------------------- */
+
+typedef struct {
+    uint8_t year, month, day, weekday, hours, minutes;     /* binary */
+    bool    summer;
+} Civil;
+
+/* Impairments for one minute; -1 = none. */
+typedef struct {
+    int  glitch_second;     /* 5 ms carrier-off blip 600 ms into it */
+    int  drop_second;       /* carrier stays on all second */
+    int  flip_second;       /* A bit inverted (breaks that field's parity) */
+    bool leap;              /* 61-second minute */
+} Impair;
+
+static const Impair CLEAN = { -1, -1, -1, false };
+
+static int s_jitter_ms;             /* each edge moves up to this either way */
+static int s_glitch_permille;       /* random blips per second */
+static int s_drop_permille;         /* random lost seconds */
+
+static uint8_t ToBCD(uint8_t v) {
+    return (uint8_t)(((v / 10u) << 4) | (v % 10u));
+}
+
+static uint8_t Ones(uint32_t v) {
+    uint8_t n = 0;
+
+    for (; v; v >>= 1) {
+        n += v & 1u;
+    }
+    return n;
+}
+
+static void PutField(uint8_t a[60], uint8_t first, uint8_t count, uint8_t value) {
+    for (uint8_t i = 0; i < count; i++) {
+        a[first + i] = (value >> (count - 1u - i)) & 1u;
+    }
+}
+
+/* A and B bits of seconds 1-59 announcing minute c. */
+static void FrameBits(const Civil *c, uint8_t a[60], uint8_t b[60]) {
+    uint8_t year = ToBCD(c->year), month = ToBCD(c->month), day = ToBCD(c->day);
+    uint8_t hours = ToBCD(c->hours), minutes = ToBCD(c->minutes);
+
+    memset(a, 0, 60);
+    memset(b, 0, 60);
+    PutField(a, 17, 8, year);
+    PutField(a, 25, 5, month);
+    PutField(a, 30, 6, day);
+    PutField(a, 36, 3, c->weekday);
+    PutField(a, 39, 6, hours);
+    PutField(a, 45, 7, minutes);
+    PutField(a, 52, 8, 0x7E);       /* minute identifier */
+    /* Odd parity over each field and its B bit. */
+    b[54] = (Ones(year) & 1u) == 0;
+    b[55] = ((Ones(month) + Ones(day)) & 1u) == 0;
+    b[56] = (Ones(c->weekday) & 1u) == 0;
+    b[57] = ((Ones(hours) + Ones(minutes)) & 1u) == 0;
+    b[58] = c->summer;
+}
+
+static uint64_t Jitter(uint64_t t) {
+    return s_jitter_ms ? t + MS(s_jitter_ms) - MS(rand() % (2 * s_jitter_ms + 1)) : t;
+}
+
+/* One second from t: carrier off for the code's pulse(s), then on. */
+static void Second(uint64_t t, uint8_t a, uint8_t b, bool marker, bool glitch) {
+    if (marker) {
+        Edge(Jitter(t), true);
+        Edge(Jitter(t + MS(500)), false);
+    } else if (a == 0 && b == 1) {
+        Edge(Jitter(t), true);
+        Edge(Jitter(t + MS(100)), false);
+        Edge(Jitter(t + MS(200)), true);
+        Edge(Jitter(t + MS(300)), false);
+    } else {
+        Edge(Jitter(t), true);
+        Edge(Jitter(t + MS(100u * (1u + a + b))), false);
+    }
+    if (glitch) {
+        Edge(t + MS(600), true);
+        Edge(t + MS(605), false);
+    }
+}
+
+static uint64_t s_second_start;
+
+/* Seconds 1-59 for minute c, then its marker; returns what the decoder
+ * hands the main loop straight after the marker. */
+static bool SendMinute(const Civil *c, const Impair *imp, MsfTime *got) {
+    uint8_t a[60], b[60];
+
+    FrameBits(c, a, b);
+    if (imp->flip_second >= 0) {
+        a[imp->flip_second] ^= 1u;
+    }
+    for (int s = imp->leap ? 0 : 1; s <= 59; s++) {
+        int bit = (s == 0) ? 1 : s;     /* leap: one more second like second 1 */
+        bool drop = (s == imp->drop_second) ||
+                    (s_drop_permille && rand() % 1000 < s_drop_permille);
+        bool glitch = (s == imp->glitch_second) ||
+                      (s_glitch_permille && rand() % 1000 < s_glitch_permille);
+
+        s_second_start += MS(1000);
+        if (!drop) {
+            Second(s_second_start, a[bit], b[bit], false, glitch);
+        }
+    }
+    s_second_start += MS(1000);
+    Second(s_second_start, 0, 0, true, false);
+    return MSF_GetTime(got);
+}
+
+static void NextMinute(Civil *c) {
+    if (++c->minutes < 60) {
+        return;
+    }
+    c->minutes = 0;
+    if (++c->hours < 24) {
+        return;
+    }
+    c->hours = 0;
+    c->day++;                       /* tests stay inside one month */
+    c->weekday = (uint8_t)((c->weekday + 1u) % 7u);
+}
+
+static bool Matches(const MsfTime *t, const Civil *c) {
+    return t->year == ToBCD(c->year) && t->month == ToBCD(c->month) &&
+           t->day == ToBCD(c->day) && t->weekday == c->weekday &&
+           t->hours == ToBCD(c->hours) && t->minutes == ToBCD(c->minutes) &&
+           t->summer == c->summer;
+}
+
+/* --- Tests ------------------------------------------------------------------- */
+
+static Civil s_civil;
+
+/* Sends n minutes; returns how many were confirmed, all checked correct. */
+static int Run(int n, const Impair *imp) {
+    int confirmed = 0;
+
+    for (int i = 0; i < n; i++) {
+        MsfTime got;
+
+        NextMinute(&s_civil);
+        if (SendMinute(&s_civil, imp, &got)) {
+            confirmed++;
+            CHECK(Matches(&got, &s_civil));
+        }
+    }
+    return confirmed;
+}
+
+/* The next minutes after an impaired one: rejected, then the first good
+ * frame is unconfirmed and the one after confirmed. */
+static void ExpectRecovery(const Impair *imp) {
+    CHECK(Run(1, imp) == 0);
+    CHECK(Run(1, &CLEAN) == 0);
+    CHECK(Run(1, &CLEAN) == 1);
+}
+
+static void TestClean(void) {
+    uint16_t seen = MSF_GetFramesSeen();
+
+    /* Start part-way through a minute: the first marker only synchronises,
+     * the first full frame is not yet confirmed. */
+    s_second_start += MS(1000);
+    Second(s_second_start, 0, 0, true, false);
+    CHECK(Run(1, &CLEAN) == 0);
+    CHECK(MSF_GetFramesSeen() == seen + 1u);
+    CHECK(Run(5, &CLEAN) == 5);
+    CHECK(MSF_GetFramesSeen() == seen + 6u);
+}
+
+static void TestJitter(void) {
+    s_jitter_ms = 20;               /* receivers move edges by up to ~40 ms */
+    CHECK(Run(10, &CLEAN) == 10);
+    s_jitter_ms = 0;
+}
+
+static void TestImpairments(void) {
+    Impair imp;
+
+    imp = CLEAN;
+    imp.glitch_second = 30;
+    ExpectRecovery(&imp);
+
+    imp = CLEAN;
+    imp.drop_second = 12;
+    ExpectRecovery(&imp);
+
+    imp = CLEAN;
+    imp.drop_second = 59;           /* the second before the marker */
+    ExpectRecovery(&imp);
+
+    imp = CLEAN;
+    imp.flip_second = 42;           /* hours: parity fails */
+    uint16_t good = MSF_GetFramesGood();
+    ExpectRecovery(&imp);
+    CHECK(MSF_GetFramesGood() == good + 2u);
+
+    imp = CLEAN;
+    imp.flip_second = 53;           /* minute identifier */
+    ExpectRecovery(&imp);
+}
+
+static void TestSignalLost(void) {
+    MsfTime got;
+
+    /* A minute of silence: Timer5 wraps on its own, then the signal is
+     * back with a marker. */
+    NextMinute(&s_civil);
+    s_second_start += MS(60000);
+    RunTo(s_second_start);
+    Second(s_second_start, 0, 0, true, false);
+    CHECK(!MSF_GetTime(&got));
+    CHECK(Run(1, &CLEAN) == 0);     /* out of sequence with the last one */
+    CHECK(Run(2, &CLEAN) == 2);
+}
+
+static void TestLeapSecond(void) {
+    Impair imp = CLEAN;
+
+    imp.leap = true;
+    CHECK(Run(1, &imp) == 1);
+    CHECK(Run(1, &CLEAN) == 1);
+}
+
+static void TestMidnight(void) {
+    s_civil.hours = 23;
+    s_civil.minutes = 57;
+    CHECK(Run(1, &CLEAN) == 0);     /* jumped: not in sequence */
+    CHECK(Run(4, &CLEAN) == 4);     /* 23:59 -> 00:00 next day */
+    CHECK(s_civil.hours == 0 && s_civil.minutes == 2);
+}
+
+static void TestNoisyRun(void) {
+    int confirmed;
+
+    s_jitter_ms = 25;
+    s_glitch_permille = 5;
+    s_drop_permille = 2;
+    confirmed = Run(600, &CLEAN);   /* every confirmation checked in Run */
+    printf("noisy run: %d of 600 minutes confirmed\n", confirmed);
+    CHECK(confirmed > 100);
+    s_jitter_ms = 0;
+    s_glitch_permille = 0;
+    s_drop_permille = 0;
+}
+
+int main(void) {
+    srand(42);
+    s_civil = (Civil){ 26, 10, 5, 1, 12, 0, true };
+    s_now = 0;
+    s_next_wrap = 0x10000u;
+    s_second_start = MS(700);
+
+    MSF_Init();
+    TestClean();
+    TestJitter();
+    TestImpairments();
+    TestSignalLost();
+    TestLeapSecond();
+    TestMidnight();
+    TestNoisyRun();
+    CHECK(s_together[0] > 0 && s_together[1] > 0);
+    return CHECK_DONE("test_msf");
+}
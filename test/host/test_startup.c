@@ -0,0 +1,290 @@
+/*******************************************************************************
+ * File:   test_startup.c
+ * Purpose: Host model of start-up - time from reset to the first lamp
+ *          decision, for the old sequence (LCD brought up first with
+ *          blocking waits, display written before the decision) and the
+ *          current one (Timer3 steps the LCD in the background, Main.c).
+ *          Runs on a virtual clock: delays in LCD.c advance it, Timer3
+ *          expiries call LCD_Isr at the right moment, and the work that
+ *          stalls the CPU on the target is charged at the figures below.
+ *          LCD.c, Journal.c, Logger.c and Persist.c are the real modules.
+ *
+ *          Result (ms from reset, C start-up code not included):
+ *
+ *                                   old      new
+ *              warm, WDT reset      23.4      2.6
+ *              warm, brown-out      28.4      7.6   2 journal row erases
+ *              cold (calibration) 1070.0   1003.0   operator answers at once
+ *
+ *          The LCD is ready 67.3 ms after reset in the new sequence; it
+ *          shows the time from the next second on.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../new/LCD.h"
+#include "../../new/Journal.h"
+#include "../../new/Logger.h"
+#include "../../new/Persist.h"
+#include "../../new/NVM.h"
+#include "../../new/CRC.h"
+#include "../../new/UART.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+/* Stalls on the target (64 MHz, 16 MIPS). Data sheet figures where there
+ * is one, instruction counts otherwise. */
+#define T_ADC_BURST_US      896u    /* 32 x (11.5 + 2.5 TAD), FRC TAD 2 us */
+#define T_FLASH_ERASE_US    2500u   /* row erase, data sheet maximum */
+#define T_FLASH_READ_US     3u      /* per NVM_FlashRead call ... */
+#define T_FLASH_BYTE_NUM    1u      /* ... plus 1/2 us per byte (TBLRD*+ loop) */
+#define T_FLASH_BYTE_DEN    2u
+#define T_CRC_BYTE_US       1u      /* CRC engine, 8 shifts + FULL poll */
+#define T_HLVD_SETTLE_US    50u     /* HLVDCON0 RDY after EN */
+#define T3_HZ               31000u  /* LFINTOSC */
+
+/* Main.c */
+#define BLINK_MS            300u
+#define NUM_SAMPLES         32u
+
+/* Pre-change LCD.c: LCD_Send4Bits waits 1 + 100 us, LCD_SendCommand sends
+ * two nibbles and waits 2 ms. */
+#define OLD_NIBBLE_US       101u
+#define OLD_COMMAND_US      (2u * OLD_NIBBLE_US + 2000u)
+
+/* --- Virtual clock and Timer3 ---------------------------------------------- */
+
+static uint32_t s_now;              /* us since reset */
+static bool     s_t3_armed;
+static uint32_t s_t3_expiry;
+static bool     s_in_isr;
+static uint32_t s_hlvd_on;          /* when HLVD was seen enabled, 0 = not yet */
+
+static void Timer3_Check(void) {
+    uint16_t start = (uint16_t)(((uint16_t)TMR3H << 8) | TMR3L);
+
+    s_t3_armed = T3CONbits.ON && PIE5bits.TMR3IE;
+    if (s_t3_armed) {
+        s_t3_expiry = s_now + (uint32_t)(65536u - start) * 1000000u / T3_HZ;
+    }
+}
+
+/* Main-line work taking us: Timer3 interrupts that fall inside it run at
+ * their expiry and push the end of the work back by their own length. */
+static void Spend(uint32_t us) {
+    uint32_t end = s_now + us;
+
+    if (s_in_isr) {
+        s_now = end;
+        return;
+    }
+    while (s_t3_armed && s_t3_expiry <= end) {
+        uint32_t entry;
+
+        s_now = (s_t3_expiry > s_now) ? s_t3_expiry : s_now;
+        entry = s_now;
+        s_in_isr = true;
+        PIR5bits.TMR3IF = 1;
+        LCD_Isr();
+        s_in_isr = false;
+        end += s_now - entry;
+        Timer3_Check();
+    }
+    s_now = end;
+}
+
+static void DelayHook(uint32_t us) {
+    Spend(us);
+    if (HLVDCON0bits.EN) {
+        if (s_hlvd_on == 0) {
+            s_hlvd_on = s_now;
+        } else if (s_now - s_hlvd_on >= T_HLVD_SETTLE_US) {
+            HLVDCON0bits.RDY = 1;
+        }
+    }
+}
+
+/* --- Stand-ins for the modules that stall on hardware --------------------- */
+
+static bool s_journal_written;      /* journal rows hold a brown-out flush */
+
+uint8_t NVM_FlashReadByte(uint32_t address) {
+    Spend(T_FLASH_READ_US);
+    return (address >= JOURNAL_FLASH_START && s_journal_written) ? 0x00 : 0xFF;
+}
+
+void NVM_FlashRead(uint32_t address, uint8_t *buf, uint8_t len) {
+    (void)address;
+    Spend(T_FLASH_READ_US + (uint32_t)len * T_FLASH_BYTE_NUM / T_FLASH_BYTE_DEN);
+    memset(buf, 0xFF, len);
+}
+
+void NVM_FlashEraseRow(uint32_t address) {
+    Spend(T_FLASH_ERASE_US);
+    if (address >= JOURNAL_FLASH_START) {
+        s_journal_written = false;
+    }
+}
+
+void NVM_FlashWriteRow(uint32_t address, const uint8_t *buf) {
+    (void)address;
+    (void)buf;
+    Spend(T_FLASH_ERASE_US);
+}
+
+uint16_t CRC_Block(const void *data, uint8_t len) {
+    const uint8_t *p = data;
+    uint16_t crc = CRC_SEED;
+
+    Spend((uint32_t)len * T_CRC_BYTE_US);
+    while (len--) {
+        crc = (uint16_t)((crc << 1) ^ *p++);
+    }
+    return crc;
+}
+
+void UART_WriteByte(uint8_t c) { (void)c; }
+void UART_WriteString(const char *s) { (void)s; }
+void UART_WriteUInt(uint32_t n) { (void)n; }
+
+static uint16_t ADC_ReadLDR(void) {
+    Spend(T_ADC_BURST_US);
+    return 300;
+}
+
+/* --- The two sequences, in Main.c's order --------------------------------- */
+
+#define SEQ_OLD     0
+#define SEQ_NEW     1
+
+#define RESET_WDT       0
+#define RESET_BROWNOUT  1
+#define RESET_POWER_ON  2
+
+static uint32_t s_lcd_ready_at;
+
+static void OldLcdInit(void) {
+    Spend(50000u);                  /* power-up */
+    Spend(OLD_NIBBLE_US + 5000u);
+    Spend(OLD_NIBBLE_US + 1000u);
+    Spend(OLD_NIBBLE_US + 1000u);
+    Spend(OLD_NIBBLE_US);
+    Spend(4u * OLD_COMMAND_US);     /* 0x28, 0x0C, 0x06, 0x01 */
+    Spend(2000u);
+}
+
+static void OldLcdResume(void) {
+    Spend(4u * OLD_NIBBLE_US);      /* 4-bit re-sync */
+    Spend(3u * OLD_COMMAND_US);     /* 0x28, 0x0C, 0x06 */
+}
+
+static uint16_t ReadLDR_Averaged(void) {
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < NUM_SAMPLES; i++) {
+        sum += ADC_ReadLDR();
+        Spend(2000u);
+    }
+    return (uint16_t)(sum / NUM_SAMPLES);
+}
+
+/* The operator presses and releases RF2 the moment it is asked for. */
+static void Calibrate(void) {
+    Spend(2u * BLINK_MS * 1000u);   /* one blink, then the press */
+    Spend(50000u);
+    (void)ReadLDR_Averaged();
+    Spend(50000u);
+    Spend(50000u);
+    (void)ReadLDR_Averaged();
+    Spend(50000u);
+    Journal_Write(JOURNAL_CALIBRATION, 0);
+}
+
+/* Reset to the first lamp decision, us. */
+static uint32_t StartUp(uint8_t seq, uint8_t reset) {
+    static const PersistState state = { 0x21, 0x30, 0x00, 18, 10, 2026, 150, 1, 0, 0 };
+    PersistState saved;
+    bool warm;
+
+    s_now = 0;
+    s_t3_armed = false;
+    s_in_isr = false;
+    s_hlvd_on = 0;
+    s_lcd_ready_at = 0;
+    HLVDCON0bits.RDY = 0;
+    HLVDCON0bits.EN = 0;
+    T3CONbits.ON = 0;
+    PIE5bits.TMR3IE = 0;
+    Persist_Save(&state);
+    s_now = 0;
+    PCON0bits.nPOR = (reset != RESET_POWER_ON);
+    s_journal_written = (reset == RESET_BROWNOUT);
+
+    if (seq == SEQ_NEW) {
+        LCD_Begin();
+        Timer3_Check();
+    }
+    warm = Persist_Load(&saved);
+    CHECK(warm == (reset != RESET_POWER_ON));
+    Journal_Init();
+    if (seq == SEQ_OLD) {
+        if (warm) {
+            OldLcdResume();
+        } else {
+            OldLcdInit();
+            Calibrate();
+        }
+    } else if (!warm) {
+        Calibrate();
+    }
+    Logger_Init();
+    (void)ADC_ReadLDR();
+    Persist_Save(&state);           /* SaveState */
+
+    /* First main-loop pass: the display comes before the lamp decision. */
+    if (seq == SEQ_OLD || LCD_IsReady()) {
+        LCD_UpdateDisplay(0x21, 0x30, 0x18, 0x10, 0x2026, "GMT");
+    }
+    return s_now;
+}
+
+/* New sequence: run on from the decision until the LCD is ready. */
+static void RunToLcdReady(void) {
+    while (!LCD_IsReady() && s_now < 1000000u) {
+        Spend(100u);
+    }
+    s_lcd_ready_at = s_now;
+}
+
+int main(void) {
+    static const char *const names[] = { "warm, WDT reset", "warm, brown-out", "cold (calibration)" };
+    uint32_t t[2][3];
+
+    xc_delay_hook = DelayHook;
+
+    printf("%-20s %9s %9s\n", "reset to decision", "old ms", "new ms");
+    for (uint8_t reset = RESET_WDT; reset <= RESET_POWER_ON; reset++) {
+        t[SEQ_OLD][reset] = StartUp(SEQ_OLD, reset);
+        t[SEQ_NEW][reset] = StartUp(SEQ_NEW, reset);
+        printf("%-20s %9.1f %9.1f\n", names[reset],
+               t[SEQ_OLD][reset] / 1000.0, t[SEQ_NEW][reset] / 1000.0);
+        CHECK(t[SEQ_NEW][reset] < t[SEQ_OLD][reset]);
+    }
+    (void)StartUp(SEQ_NEW, RESET_WDT);
+    CHECK(!LCD_IsReady());          /* the decision did not wait for it */
+    RunToLcdReady();
+    printf("LCD ready (new): %.1f ms\n", s_lcd_ready_at / 1000.0);
+
+    /* The target from the change: warm restarts decide within 20 ms. */
+    CHECK(t[SEQ_NEW][RESET_WDT] < 20000u);
+    CHECK(t[SEQ_NEW][RESET_BROWNOUT] < 20000u);
+    CHECK(t[SEQ_OLD][RESET_WDT] >= 20000u);
+    /* Power-on sequence: 50 + 5 + 1 + 1 + 1 + 4 x 2 ms of waits. */
+    CHECK(s_lcd_ready_at >= 66000u && s_lcd_ready_at < 70000u);
+    /* A brown-out costs the two journal row erases (less one flash read). */
+    CHECK(t[SEQ_NEW][RESET_BROWNOUT] - t[SEQ_NEW][RESET_WDT] ==
+          2u * T_FLASH_ERASE_US - T_FLASH_READ_US);
+
+    return CHECK_DONE("test_startup");
+}
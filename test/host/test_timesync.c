@@ -0,0 +1,343 @@
+/*******************************************************************************
+ * File:   test_timesync.c
+ * Purpose: Host test - bus time sync (TimeSync.c) between simulated
+ *          controllers: the master build (timesync_master.c) and a
+ *          follower, each with its own crystal error, tick, trim and main
+ *          loop running 1-20 ms behind its tick. The master's broadcast
+ *          reaches the follower as a frame stamped when its t3.5 gap
+ *          closes (low-priority ISR latency included). Followers only
+ *          listen, so one stands for any number. Covers power-up far out,
+ *          lock and drift trimming, a bus outage, a crystal change, master
+ *          restarts, mismatch flags, broken frames and demo time scales.
+ ******************************************************************************/
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../new/TimeSync.h"
+#include "../../new/Timer.h"
+#include "../../new/Modbus.h"
+#include "../../new/Config.h"
+#include "check.h"
+
+#define COUNT_HZ        62500.0
+#define NOMINAL         62501       /* counts per tick, no trim */
+#define BAUD            115108.0
+#define T35_S           (219 * 8e-6)
+
+/* timesync_master.c */
+void Master_Init(void);
+int32_t Master_Task(uint32_t clock_second, uint32_t utc_second);
+uint8_t Master_GetState(void);
+
+/* --- Simulated controllers ----------------------------------------------- */
+
+typedef struct {
+    double   rate;          /* Timer0 counts per true second */
+    double   tick_start;    /* true time the current tick began */
+    uint16_t len;           /* counts in it */
+    uint32_t clock;         /* clock seconds */
+    uint32_t utc0;          /* UTC = utc0 + clock */
+    int16_t  trim;
+    uint8_t  frac;
+    int16_t  step;
+    double   next_task;     /* main loop after the tick, or INFINITY */
+} Node;
+
+static Node   s_m, s_f;             /* master, follower */
+static double s_now;
+
+static double Uniform(double lo, double hi) {
+    return lo + (hi - lo) * rand() / RAND_MAX;
+}
+
+static uint16_t Counts(const Node *n) {
+    return (uint16_t)((s_now - n->tick_start) * n->rate);
+}
+
+static double Local(const Node *n) {
+    return (double)n->utc0 + n->clock + Counts(n) / COUNT_HZ;
+}
+
+/* Timer.c's reload: nominal, less trim with its fraction, less any step. */
+static void Tick(Node *n) {
+    int16_t acc = (int16_t)(n->frac + n->trim);
+
+    n->tick_start += n->len / n->rate;
+    n->clock++;
+    n->frac = (uint8_t)acc;
+    n->len = (uint16_t)(NOMINAL + (acc >> 8) + n->step);
+    n->step = 0;
+    n->next_task = n->tick_start + Uniform(0.001, 0.020);
+}
+
+static void Power(Node *n, double ppm, uint32_t utc0) {
+    n->rate = COUNT_HZ * (1.0 + ppm * 1e-6);
+    n->tick_start = s_now - Uniform(0.0, 1.0);
+    n->len = NOMINAL;
+    n->clock = 0;
+    n->utc0 = utc0;
+    n->trim = 0;
+    n->frac = 0;
+    n->step = 0;
+    n->next_task = INFINITY;
+}
+
+/* --- Stand-ins: follower ------------------------------------------------- */
+
+static uint16_t s_scale = 1;
+static bool     s_dst;
+static uint16_t s_version = 0x1234;
+static uint32_t s_frame_second;
+static uint16_t s_frame_counts;
+
+void Timer_StepPhase(int16_t counts) { s_f.step = counts; }
+void Timer_SetTrim(int16_t trim) { s_f.trim = trim; }
+int16_t Timer_GetTrim(void) { return s_f.trim; }
+uint16_t Timer_GetTimeScale(void) { return s_scale; }
+bool DST_IsActive(void) { return s_dst; }
+uint16_t Schedule_GetVersion(void) { return s_version; }
+
+void Modbus_GetFrameTime(uint32_t *seconds, uint16_t *counts) {
+    *seconds = s_frame_second;
+    *counts = s_frame_counts;
+}
+
+/* --- Stand-ins: master and the bus --------------------------------------- */
+
+static bool     s_master_dst;
+static uint16_t s_master_version = 0x1234;
+static bool     s_bus_up = true;
+static uint8_t  s_fields_sent = TSYNC_FIELDS;   /* fewer: a frame cut short */
+static uint16_t s_frame[TSYNC_FIELDS];
+static double   s_frame_end = INFINITY;         /* follower's t3.5 expiry */
+static double   s_frame_task = INFINITY;        /* follower's main loop sees it */
+static unsigned s_frames;
+static bool     s_bad_broadcast;
+
+void Master_GetStamp(uint32_t *seconds, uint16_t *counts) {
+    *seconds = s_m.clock;
+    *counts = Counts(&s_m);
+}
+
+uint16_t Master_GetTimeScale(void) { return 1; }
+bool Master_DstActive(void) { return s_master_dst; }
+uint16_t Master_ScheduleVersion(void) { return s_master_version; }
+
+/* Sending starts as the stamp is taken: 19 bytes of 10 bits, then the
+ * follower's t3.5 and its ISR latency. */
+bool Master_Broadcast(uint8_t start, uint8_t qty, const uint16_t *values) {
+    s_bad_broadcast |= start != MB_REG_SYNC_TIME_HI || qty != TSYNC_FIELDS;
+    for (uint8_t i = 0; i < qty; i++) {
+        s_frame[i] = values[i];
+    }
+    if (s_bus_up) {
+        s_frame_end = s_now + (7 + 2 * TSYNC_FIELDS + 2) * 10 / BAUD + T35_S +
+                      Uniform(0.0, 40e-6);
+    }
+    s_frames++;
+    return true;
+}
+
+/* --- Event loop ---------------------------------------------------------- */
+
+static unsigned s_steps;            /* clock steps the follower made */
+static double   s_worst;            /* |follower - master|, s, since Measure() */
+
+static void FollowerTask(void) {
+    int32_t step = TimeSync_Task(s_f.clock, s_f.utc0 + s_f.clock);
+
+    if (step != 0) {
+        s_f.utc0 += (uint32_t)step;
+        s_steps++;
+    }
+}
+
+/* Run until true time t, tracking the worst offset once a second. */
+static void RunTo(double t) {
+    double sample = ceil(s_now);
+
+    while (s_now < t) {
+        double m_tick = s_m.tick_start + s_m.len / s_m.rate;
+        double f_tick = s_f.tick_start + s_f.len / s_f.rate;
+        double next = fmin(fmin(m_tick, f_tick), fmin(s_m.next_task, s_f.next_task));
+
+        next = fmin(next, fmin(s_frame_end, s_frame_task));
+        next = fmin(next, fmin(sample, t));
+        s_now = next;
+        if (next == m_tick) {
+            Tick(&s_m);
+        } else if (next == f_tick) {
+            Tick(&s_f);
+        } else if (next == s_m.next_task) {
+            s_m.next_task = INFINITY;
+            (void)Master_Task(s_m.clock, s_m.utc0 + s_m.clock);
+        } else if (next == s_f.next_task) {
+            s_f.next_task = INFINITY;
+            FollowerTask();
+        } else if (next == s_frame_end) {
+            s_frame_end = INFINITY;
+            s_frame_second = s_f.clock;
+            s_frame_counts = Counts(&s_f);
+            s_frame_task = s_now + Uniform(0.001, 0.020);
+        } else if (next == s_frame_task) {
+            s_frame_task = INFINITY;
+            for (uint8_t i = 0; i < s_fields_sent; i++) {
+                (void)TimeSync_Write(i, s_frame[i]);
+            }
+            FollowerTask();
+        } else if (next == sample) {
+            s_worst = fmax(s_worst, fabs(Local(&s_f) - Local(&s_m)));
+            sample += 1.0;
+        }
+    }
+}
+
+static double Measure(double seconds) {
+    s_worst = 0.0;
+    RunTo(s_now + seconds);
+    return s_worst * 1000.0;
+}
+
+/* Follower's tick with its trim against the master's, ppm. */
+static double FollowerPpm(void) {
+    return ((NOMINAL + s_f.trim / 256.0) / s_f.rate / (NOMINAL / s_m.rate) - 1.0) * 1e6;
+}
+
+/* --- Tests --------------------------------------------------------------- */
+
+#define UTC0    830000000u          /* 2026, seconds since 2000 */
+
+static void TestPowerUp(void) {
+    double ms;
+
+    Power(&s_m, -15.0, UTC0);
+    Power(&s_f, +80.0, UTC0 + 3721u);   /* an hour out: the RTC was never set */
+    Master_Init();
+    TimeSync_Init();
+    CHECK(Master_GetState() == TSYNC_MASTER && TimeSync_GetState() == TSYNC_NONE);
+
+    RunTo(2.0 * TIMESYNC_PERIOD);
+    CHECK(s_steps == 1u);               /* the whole seconds, once */
+    CHECK(fabs(Local(&s_f) - Local(&s_m)) < 0.5);
+    RunTo(1200.0);
+    ms = Measure(3600.0);
+    printf("power-up: %u step, then worst %.3f ms over an hour, %+.2f ppm left, state %u\n",
+           s_steps, ms, FollowerPpm(), TimeSync_GetState());
+    CHECK(s_steps == 1u);
+    CHECK(ms < 1.0);
+    CHECK(fabs(FollowerPpm()) < 1.0);
+    CHECK(TimeSync_GetState() == TSYNC_LOCKED);
+    CHECK(abs(TimeSync_GetOffset_ms()) <= 1);
+    CHECK(TimeSync_GetMismatch() == 0);
+}
+
+/* Ten minutes without frames: the trim holds the clock. */
+static void TestOutage(void) {
+    double ms;
+
+    s_bus_up = false;
+    ms = Measure(600.0);
+    printf("outage: worst %.3f ms over 10 min, state %u\n", ms, TimeSync_GetState());
+    CHECK(TimeSync_GetState() == TSYNC_LOST);
+    CHECK(ms < 5.0);
+    s_bus_up = true;
+    RunTo(s_now + 3.0 * TIMESYNC_PERIOD);
+    CHECK(TimeSync_GetState() == TSYNC_LOCKED);
+    CHECK(Measure(600.0) < 1.0);
+}
+
+/* The follower's crystal warms by 120 ppm: slewed and trimmed back. */
+static void TestCrystalChange(void) {
+    double ms;
+
+    s_f.rate = COUNT_HZ * (1.0 - 40e-6);
+    RunTo(s_now + 600.0);
+    ms = Measure(1800.0);
+    printf("crystal +80 -> -40 ppm: worst %.3f ms after 10 min, %+.2f ppm left\n",
+           ms, FollowerPpm());
+    CHECK(ms < 1.0);
+    CHECK(fabs(FollowerPpm()) < 1.0);
+    CHECK(s_steps == 1u);
+}
+
+/* Master restarted with its clock 7 s out: the follower steps with it;
+ * 2 s is slewed (10 ms per second) instead. */
+static void TestMasterJumps(void) {
+    unsigned steps = s_steps;
+
+    s_m.utc0 += 7u;
+    RunTo(s_now + 2.0 * TIMESYNC_PERIOD);
+    CHECK(s_steps == steps + 1u);
+    CHECK(fabs(Local(&s_f) - Local(&s_m)) < 0.5);
+    RunTo(s_now + 300.0);
+    CHECK(Measure(300.0) < 1.0);
+
+    s_m.utc0 -= 2u;
+    RunTo(s_now + 60.0);
+    CHECK(s_steps == steps + 1u);
+    CHECK(TimeSync_GetState() == TSYNC_SLEWING);
+    RunTo(s_now + 400.0);
+    CHECK(Measure(600.0) < 1.0);
+    CHECK(TimeSync_GetState() == TSYNC_LOCKED);
+}
+
+static void TestMismatch(void) {
+    s_master_dst = true;
+    RunTo(s_now + TIMESYNC_PERIOD + 1.0);
+    CHECK(TimeSync_GetMismatch() == TSYNC_MISMATCH_DST);
+    s_master_version = 0x4321;
+    RunTo(s_now + TIMESYNC_PERIOD);
+    CHECK(TimeSync_GetMismatch() == (TSYNC_MISMATCH_DST | TSYNC_MISMATCH_SCHEDULE));
+    s_dst = true;
+    s_version = 0x4321;
+    RunTo(s_now + TIMESYNC_PERIOD);
+    CHECK(TimeSync_GetMismatch() == 0);
+    CHECK(TimeSync_GetField(4) == 0x4321);
+}
+
+/* Frames cut short are never measured; a large offset stays put. */
+static void TestBrokenFrames(void) {
+    unsigned steps = s_steps;
+
+    s_fields_sent = TSYNC_FIELDS - 1u;
+    s_m.utc0 += 100u;
+    RunTo(s_now + 4.0 * TIMESYNC_PERIOD);
+    CHECK(s_steps == steps);
+    CHECK(!TimeSync_Write(TSYNC_FIELDS, 0));
+    s_fields_sent = TSYNC_FIELDS;
+    RunTo(s_now + 2.0 * TIMESYNC_PERIOD);
+    CHECK(s_steps == steps + 1u);
+    RunTo(s_now + 300.0);
+    CHECK(Measure(300.0) < 1.0);
+}
+
+/* Demo time scale on the follower: its clock seconds are not real ones,
+ * so frames are ignored and nothing is slewed or trimmed. */
+static void TestTimeScale(void) {
+    int16_t trim = s_f.trim;
+    unsigned steps = s_steps;
+
+    s_scale = 60;
+    s_m.utc0 += 9u;
+    RunTo(s_now + 4.0 * TIMESYNC_PERIOD);
+    CHECK(s_steps == steps && s_f.trim == trim);
+    s_scale = 1;
+    RunTo(s_now + 2.0 * TIMESYNC_PERIOD);
+    CHECK(s_steps == steps + 1u);
+}
+
+int main(void) {
+    srand(49);
+    TestPowerUp();
+    TestOutage();
+    TestCrystalChange();
+    TestMasterJumps();
+    TestMismatch();
+    TestBrokenFrames();
+    TestTimeScale();
+    printf("%u frames sent\n", s_frames);
+    CHECK(s_frames > 0 && !s_bad_broadcast);
+    return CHECK_DONE("test_timesync");
+}
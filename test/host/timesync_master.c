@@ -0,0 +1,24 @@
+/*******************************************************************************
+ * File:   timesync_master.c
+ * Purpose: TimeSync.c built as the bus master (TIMESYNC_MASTER) under
+ *          other names, so test_timesync can link it beside the follower
+ *          build of the same file. The master's clock, bus and DST/schedule
+ *          state are its own stand-ins in the test.
+ ******************************************************************************/
+
+#define TIMESYNC_MASTER
+
+#define TimeSync_Init           Master_Init
+#define TimeSync_Write          Master_Write
+#define TimeSync_GetField       Master_GetField
+#define TimeSync_Task           Master_Task
+#define TimeSync_GetState       Master_GetState
+#define TimeSync_GetOffset_ms   Master_GetOffset_ms
+#define TimeSync_GetMismatch    Master_GetMismatch
+#define Timer_GetStamp          Master_GetStamp
+#define Timer_GetTimeScale      Master_GetTimeScale
+#define Modbus_Broadcast        Master_Broadcast
+#define DST_IsActive            Master_DstActive
+#define Schedule_GetVersion     Master_ScheduleVersion
+
+#include "../../new/TimeSync.c"
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * File:   xc.c
+ * Purpose: Storage for the host xc.h: the SFR variables and the delay hook.
+ ******************************************************************************/
+
+#include <xc.h>
+
+void (*xc_delay_hook)(uint32_t us);
+
+void xc_delay_us(uint32_t us) {
+    if (xc_delay_hook) {
+        xc_delay_hook(us);
+    }
+}
+
+volatile ADCON0bits_t ADCON0bits;
+volatile ADCON2bits_t ADCON2bits;
+volatile ADCON3bits_t ADCON3bits;
+volatile ANSELAbits_t ANSELAbits;
+volatile ANSELBbits_t ANSELBbits;
+volatile ANSELCbits_t ANSELCbits;
+volatile ANSELDbits_t ANSELDbits;
+volatile ANSELEbits_t ANSELEbits;
+volatile ANSELFbits_t ANSELFbits;
+volatile ANSELGbits_t ANSELGbits;
+volatile BAUD1CONbits_t BAUD1CONbits;
+volatile BAUD2CONbits_t BAUD2CONbits;
+volatile BAUD4CONbits_t BAUD4CONbits;
+volatile CCP4CONbits_t CCP4CONbits;
+volatile CCPTMRS1bits_t CCPTMRS1bits;
+volatile CLC1CONbits_t CLC1CONbits;
+volatile CLC2CONbits_t CLC2CONbits;
+volatile CLC2POLbits_t CLC2POLbits;
+volatile CM1CON0bits_t CM1CON0bits;
+volatile CM1CON1bits_t CM1CON1bits;
+volatile CM1NCHbits_t CM1NCHbits;
+volatile CM1PCHbits_t CM1PCHbits;
+volatile CRCCON0bits_t CRCCON0bits;
+volatile CRCCON1bits_t CRCCON1bits;
+volatile DAC1CON0bits_t DAC1CON0bits;
+volatile DAC1CON1bits_t DAC1CON1bits;
+volatile FVRCONbits_t FVRCONbits;
+volatile HLVDCON0bits_t HLVDCON0bits;
+volatile HLVDCON1bits_t HLVDCON1bits;
+volatile INTCONbits_t INTCONbits;
+volatile IPR0bits_t IPR0bits;
+volatile IPR1bits_t IPR1bits;
+volatile IPR2bits_t IPR2bits;
+volatile IPR3bits_t IPR3bits;
+volatile IPR5bits_t IPR5bits;
+volatile IPR6bits_t IPR6bits;
+volatile LATAbits_t LATAbits;
+volatile LATBbits_t LATBbits;
+volatile LATCbits_t LATCbits;
+volatile LATDbits_t LATDbits;
+volatile LATFbits_t LATFbits;
+volatile NCO1CLKbits_t NCO1CLKbits;
+volatile NCO1CONbits_t NCO1CONbits;
+volatile NVMCON1bits_t NVMCON1bits;
+volatile PCON0bits_t PCON0bits;
+volatile PIE0bits_t PIE0bits;
+volatile PIE1bits_t PIE1bits;
+volatile PIE2bits_t PIE2bits;
+volatile PIE3bits_t PIE3bits;
+volatile PIE5bits_t PIE5bits;
+volatile PIE6bits_t PIE6bits;
+volatile PIR0bits_t PIR0bits;
+volatile PIR1bits_t PIR1bits;
+volatile PIR2bits_t PIR2bits;
+volatile PIR3bits_t PIR3bits;
+volatile PIR4bits_t PIR4bits;
+volatile PIR5bits_t PIR5bits;
+volatile PIR6bits_t PIR6bits;
+volatile PORTDbits_t PORTDbits;
+volatile PORTFbits_t PORTFbits;
+volatile PWM6CONbits_t PWM6CONbits;
+volatile RC1STAbits_t RC1STAbits;
+volatile RC2STAbits_t RC2STAbits;
+volatile RC4STAbits_t RC4STAbits;
+volatile SCANCON0bits_t SCANCON0bits;
+volatile T0CON0bits_t T0CON0bits;
+volatile T0CON1bits_t T0CON1bits;
+volatile T1CONbits_t T1CONbits;
+volatile T1GCONbits_t T1GCONbits;
+volatile T2CONbits_t T2CONbits;
+volatile T3CONbits_t T3CONbits;
+volatile T3GCONbits_t T3GCONbits;
+volatile T4CONbits_t T4CONbits;
+volatile T5CONbits_t T5CONbits;
+volatile T5GCONbits_t T5GCONbits;
+volatile T6CONbits_t T6CONbits;
+volatile TRISAbits_t TRISAbits;
+volatile TRISBbits_t TRISBbits;
+volatile TRISCbits_t TRISCbits;
+volatile TRISDbits_t TRISDbits;
+volatile TRISEbits_t TRISEbits;
+volatile TRISFbits_t TRISFbits;
+volatile TRISGbits_t TRISGbits;
+volatile TX1STAbits_t TX1STAbits;
+volatile TX2STAbits_t TX2STAbits;
+volatile TX4STAbits_t TX4STAbits;
+volatile WDTCON0bits_t WDTCON0bits;
+
+volatile uint8_t ADACQ;
+volatile uint8_t ADFLTRH;
+volatile uint8_t ADFLTRL;
+volatile uint8_t ADPCH;
+volatile uint8_t ADREF;
+volatile uint8_t ADRPT;
+volatile uint8_t CCP4PPS;
+volatile uint8_t CCPR4H;
+volatile uint8_t CCPR4L;
+volatile uint8_t CLC1GLS0;
+volatile uint8_t CLC1GLS1;
+volatile uint8_t CLC1GLS2;
+volatile uint8_t CLC1GLS3;
+volatile uint8_t CLC1POL;
+volatile uint8_t CLC1SEL0;
+volatile uint8_t CLC1SEL1;
+volatile uint8_t CLC2GLS0;
+volatile uint8_t CLC2GLS1;
+volatile uint8_t CLC2GLS2;
+volatile uint8_t CLC2GLS3;
+volatile uint8_t CLC2POL;
+volatile uint8_t CLC2SEL0;
+volatile uint8_t CRCACCH;
+volatile uint8_t CRCACCL;
+volatile uint8_t CRCDATL;
+volatile uint8_t CRCXORH;
+volatile uint8_t CRCXORL;
+volatile uint8_t INT1PPS;
+volatile uint8_t LATA;
+volatile uint8_t LATB;
+volatile uint8_t LATC;
+volatile uint8_t LATD;
+volatile uint8_t LATE;
+volatile uint8_t LATF;
+volatile uint8_t LATG;
+volatile uint8_t NCO1INCH;
+volatile uint8_t NCO1INCL;
+volatile uint8_t NCO1INCU;
+volatile uint8_t NVMADRH;
+volatile uint8_t NVMADRL;
+volatile uint8_t NVMCON2;
+volatile uint8_t NVMDAT;
+volatile uint8_t PCON0;
+volatile uint8_t PWM6DCH;
+volatile uint8_t PWM6DCL;
+volatile uint8_t RB0PPS;
+volatile uint8_t RB1PPS;
+volatile uint8_t RC0PPS;
+volatile uint8_t RC1REG;
+volatile uint8_t RC2REG;
+volatile uint8_t RC4REG;
+volatile uint8_t RD0PPS;
+volatile uint8_t RX1PPS;
+volatile uint8_t RX2PPS;
+volatile uint8_t RX4PPS;
+volatile uint8_t SCANHADRH;
+volatile uint8_t SCANHADRL;
+volatile uint8_t SCANHADRU;
+volatile uint8_t SCANLADRH;
+volatile uint8_t SCANLADRL;
+volatile uint8_t SCANLADRU;
+volatile uint8_t SP1BRGH;
+volatile uint8_t SP1BRGL;
+volatile uint8_t SP2BRGH;
+volatile uint8_t SP2BRGL;
+volatile uint8_t SP4BRGH;
+volatile uint8_t SP4BRGL;
+volatile uint8_t T2CLKCON;
+volatile uint8_t T2HLT;
+volatile uint8_t T2PR;
+volatile uint8_t T2TMR;
+volatile uint8_t T1CLK;
+volatile uint8_t T3CLK;
+volatile uint8_t T4CLKCON;
+volatile uint8_t T4HLT;
+volatile uint8_t T4PR;
+volatile uint8_t T4TMR;
+volatile uint8_t T5CLK;
+volatile uint8_t T6CLKCON;
+volatile uint8_t T6HLT;
+volatile uint8_t T6PR;
+volatile uint8_t T6TMR;
+volatile uint8_t TABLAT;
+volatile uint8_t TBLPTRH;
+volatile uint8_t TBLPTRL;
+volatile uint8_t TBLPTRU;
+volatile uint8_t TMR0H;
+volatile uint8_t TMR0L;
+volatile uint8_t TMR1H;
+volatile uint8_t TMR1L;
+volatile uint8_t TMR3H;
+volatile uint8_t TMR3L;
+volatile uint8_t TMR5H;
+volatile uint8_t TMR5L;
+volatile uint8_t TX2REG;
+volatile uint8_t TX4REG;
@@ -0,0 +1,697 @@
+/*******************************************************************************
+ * File:   xc.h
+ * Purpose: Host stand-in for the XC8 device header, so firmware modules build
+ *          with gcc for the tests in this directory. Every SFR the firmware
+ *          uses is a plain variable (xc.c) the test can set and inspect; bit
+ *          fields are 8 bits wide so multi-bit fields such as ADPCH fit.
+ *          Registers and their bit structs are separate variables: a test
+ *          sets whichever one the module reads. Delays call xc_delay_hook,
+ *          so a simulation can advance its clock.
+ ******************************************************************************/
+
+#ifndef XC_H
+#define XC_H
+
+#include <stdint.h>
+
+#define __interrupt(...)
+#define __at(x)
+#define __persistent
+#define __near
+#define __section(x)
+#define asm(x)          ((void)0)
+#define NOP()           ((void)0)
+#define SLEEP()         ((void)0)
+#define CLRWDT()        ((void)0)
+#define RESET()         ((void)0)
+#define di()            ((void)0)
+#define ei()            ((void)0)
+
+/** Called for every __delay_ms/__delay_us when set; null = delays are free. */
+extern void (*xc_delay_hook)(uint32_t us);
+void xc_delay_us(uint32_t us);
+#define __delay_ms(x)   xc_delay_us((uint32_t)(x) * 1000UL)
+#define __delay_us(x)   xc_delay_us((uint32_t)(x))
+
+typedef struct {
+    unsigned ADCS : 8;
+    unsigned ADFM : 8;
+    unsigned ADGO : 8;
+    unsigned ADON : 8;
+} ADCON0bits_t;
+extern volatile ADCON0bits_t ADCON0bits;
+
+typedef struct {
+    unsigned ADCRS : 8;
+    unsigned ADMD : 8;
+} ADCON2bits_t;
+extern volatile ADCON2bits_t ADCON2bits;
+
+typedef struct {
+    unsigned ADTMD : 8;
+} ADCON3bits_t;
+extern volatile ADCON3bits_t ADCON3bits;
+
+typedef struct {
+    unsigned ANSELA0 : 8;
+    unsigned ANSELA1 : 8;
+    unsigned ANSELA2 : 8;
+    unsigned ANSELA3 : 8;
+    unsigned ANSELA4 : 8;
+} ANSELAbits_t;
+extern volatile ANSELAbits_t ANSELAbits;
+
+typedef struct {
+    unsigned ANSELB2 : 8;
+    unsigned ANSELB3 : 8;
+    unsigned ANSELB4 : 8;
+} ANSELBbits_t;
+extern volatile ANSELBbits_t ANSELBbits;
+
+typedef struct {
+    unsigned ANSELC1 : 8;
+    unsigned ANSELC7 : 8;
+} ANSELCbits_t;
+extern volatile ANSELCbits_t ANSELCbits;
+
+typedef struct {
+    unsigned ANSELD0 : 8;
+    unsigned ANSELD1 : 8;
+    unsigned ANSELD2 : 8;
+    unsigned ANSELD3 : 8;
+} ANSELDbits_t;
+extern volatile ANSELDbits_t ANSELDbits;
+
+typedef struct {
+    unsigned ANSELE1 : 8;
+    unsigned ANSELE3 : 8;
+} ANSELEbits_t;
+extern volatile ANSELEbits_t ANSELEbits;
+
+typedef struct {
+    unsigned ANSELF2 : 8;
+    unsigned ANSELF6 : 8;
+    unsigned ANSELF7 : 8;
+} ANSELFbits_t;
+extern volatile ANSELFbits_t ANSELFbits;
+
+typedef struct {
+    unsigned ANSELG0 : 8;
+    unsigned ANSELG1 : 8;
+} ANSELGbits_t;
+extern volatile ANSELGbits_t ANSELGbits;
+
+typedef struct {
+    unsigned BRG16 : 8;
+} BAUD1CONbits_t;
+extern volatile BAUD1CONbits_t BAUD1CONbits;
+
+typedef struct {
+    unsigned BRG16 : 8;
+} BAUD2CONbits_t;
+extern volatile BAUD2CONbits_t BAUD2CONbits;
+
+typedef struct {
+    unsigned BRG16 : 8;
+} BAUD4CONbits_t;
+extern volatile BAUD4CONbits_t BAUD4CONbits;
+
+typedef struct {
+    unsigned EN : 8;
+    unsigned MODE : 8;
+} CCP4CONbits_t;
+extern volatile CCP4CONbits_t CCP4CONbits;
+
+typedef struct {
+    unsigned C4TSEL : 8;
+    unsigned P6TSEL : 8;
+} CCPTMRS1bits_t;
+extern volatile CCPTMRS1bits_t CCPTMRS1bits;
+
+typedef struct {
+    unsigned LC1EN : 8;
+    unsigned LC1MODE : 8;
+} CLC1CONbits_t;
+extern volatile CLC1CONbits_t CLC1CONbits;
+
+typedef struct {
+    unsigned LC2EN : 8;
+    unsigned LC2MODE : 8;
+} CLC2CONbits_t;
+extern volatile CLC2CONbits_t CLC2CONbits;
+
+typedef struct {
+    unsigned G4POL : 8;
+} CLC2POLbits_t;
+extern volatile CLC2POLbits_t CLC2POLbits;
+
+typedef struct {
+    unsigned EN : 8;
+    unsigned HYS : 8;
+    unsigned OUT : 8;
+    unsigned POL : 8;
+} CM1CON0bits_t;
+extern volatile CM1CON0bits_t CM1CON0bits;
+
+typedef struct {
+    unsigned INTN : 8;
+    unsigned INTP : 8;
+} CM1CON1bits_t;
+extern volatile CM1CON1bits_t CM1CON1bits;
+
+typedef struct {
+    unsigned NCH : 8;
+} CM1NCHbits_t;
+extern volatile CM1NCHbits_t CM1NCHbits;
+
+typedef struct {
+    unsigned PCH : 8;
+} CM1PCHbits_t;
+extern volatile CM1PCHbits_t CM1PCHbits;
+
+typedef struct {
+    unsigned ACCM : 8;
+    unsigned BUSY : 8;
+    unsigned CRCGO : 8;
+    unsigned EN : 8;
+    unsigned FULL : 8;
+    unsigned SHIFTM : 8;
+} CRCCON0bits_t;
+extern volatile CRCCON0bits_t CRCCON0bits;
+
+typedef struct {
+    unsigned DLEN : 8;
+    unsigned PLEN : 8;
+} CRCCON1bits_t;
+extern volatile CRCCON1bits_t CRCCON1bits;
+
+typedef struct {
+    unsigned DAC1EN : 8;
+    unsigned NSS : 8;
+    unsigned PSS : 8;
+} DAC1CON0bits_t;
+extern volatile DAC1CON0bits_t DAC1CON0bits;
+
+typedef struct {
+    unsigned DAC1R : 8;
+} DAC1CON1bits_t;
+extern volatile DAC1CON1bits_t DAC1CON1bits;
+
+typedef struct {
+    unsigned ADFVR : 8;
+    unsigned FVREN : 8;
+    unsigned TSEN : 8;
+    unsigned TSRNG : 8;
+} FVRCONbits_t;
+extern volatile FVRCONbits_t FVRCONbits;
+
+typedef struct {
+    unsigned EN : 8;
+    unsigned INTH : 8;
+    unsigned INTL : 8;
+    unsigned OUT : 8;
+    unsigned RDY : 8;
+} HLVDCON0bits_t;
+extern volatile HLVDCON0bits_t HLVDCON0bits;
+
+typedef struct {
+    unsigned SEL : 8;
+} HLVDCON1bits_t;
+extern volatile HLVDCON1bits_t HLVDCON1bits;
+
+typedef struct {
+    unsigned GIE : 8;
+    unsigned GIEH : 8;
+    unsigned GIEL : 8;
+    unsigned INT1EDG : 8;
+    unsigned IPEN : 8;
+} INTCONbits_t;
+extern volatile INTCONbits_t INTCONbits;
+
+typedef struct {
+    unsigned INT1IP : 8;
+    unsigned TMR0IP : 8;
+} IPR0bits_t;
+extern volatile IPR0bits_t IPR0bits;
+
+typedef struct {
+    unsigned ADTIP : 8;
+} IPR1bits_t;
+extern volatile IPR1bits_t IPR1bits;
+
+typedef struct {
+    unsigned C1IP : 8;
+    unsigned HLVDIP : 8;
+} IPR2bits_t;
+extern volatile IPR2bits_t IPR2bits;
+
+typedef struct {
+    unsigned RC1IP : 8;
+    unsigned RC2IP : 8;
+    unsigned TX2IP : 8;
+} IPR3bits_t;
+extern volatile IPR3bits_t IPR3bits;
+
+typedef struct {
+    unsigned TMR1IP : 8;
+    unsigned TMR2IP : 8;
+    unsigned TMR3IP : 8;
+    unsigned TMR4IP : 8;
+    unsigned TMR5IP : 8;
+    unsigned TMR6IP : 8;
+} IPR5bits_t;
+extern volatile IPR5bits_t IPR5bits;
+
+typedef struct {
+    unsigned CCP4IP : 8;
+} IPR6bits_t;
+extern volatile IPR6bits_t IPR6bits;
+
+typedef struct {
+    unsigned LATA5 : 8;
+} LATAbits_t;
+extern volatile LATAbits_t LATAbits;
+
+typedef struct {
+    unsigned LATB0 : 8;
+    unsigned LATB1 : 8;
+} LATBbits_t;
+extern volatile LATBbits_t LATBbits;
+
+typedef struct {
+    unsigned LATC2 : 8;
+    unsigned LATC6 : 8;
+} LATCbits_t;
+extern volatile LATCbits_t LATCbits;
+
+typedef struct {
+    unsigned LATD2 : 8;
+} LATDbits_t;
+extern volatile LATDbits_t LATDbits;
+
+typedef struct {
+    unsigned LATF0 : 8;
+} LATFbits_t;
+extern volatile LATFbits_t LATFbits;
+
+typedef struct {
+    unsigned N1CKS : 8;
+} NCO1CLKbits_t;
+extern volatile NCO1CLKbits_t NCO1CLKbits;
+
+typedef struct {
+    unsigned N1EN : 8;
+    unsigned N1PFM : 8;
+} NCO1CONbits_t;
+extern volatile NCO1CONbits_t NCO1CONbits;
+
+typedef struct {
+    unsigned FREE : 8;
+    unsigned NVMREG : 8;
+    unsigned RD : 8;
+    unsigned WR : 8;
+    unsigned WREN : 8;
+} NVMCON1bits_t;
+extern volatile NVMCON1bits_t NVMCON1bits;
+
+typedef struct {
+    unsigned nPOR : 8;
+} PCON0bits_t;
+extern volatile PCON0bits_t PCON0bits;
+
+typedef struct {
+    unsigned INT1IE : 8;
+    unsigned TMR0IE : 8;
+} PIE0bits_t;
+extern volatile PIE0bits_t PIE0bits;
+
+typedef struct {
+    unsigned ADTIE : 8;
+} PIE1bits_t;
+extern volatile PIE1bits_t PIE1bits;
+
+typedef struct {
+    unsigned C1IE : 8;
+    unsigned HLVDIE : 8;
+} PIE2bits_t;
+extern volatile PIE2bits_t PIE2bits;
+
+typedef struct {
+    unsigned RC1IE : 8;
+    unsigned RC2IE : 8;
+    unsigned TX2IE : 8;
+} PIE3bits_t;
+extern volatile PIE3bits_t PIE3bits;
+
+typedef struct {
+    unsigned TMR1IE : 8;
+    unsigned TMR2IE : 8;
+    unsigned TMR3IE : 8;
+    unsigned TMR4IE : 8;
+    unsigned TMR5IE : 8;
+    unsigned TMR6IE : 8;
+} PIE5bits_t;
+extern volatile PIE5bits_t PIE5bits;
+
+typedef struct {
+    unsigned CCP4IE : 8;
+} PIE6bits_t;
+extern volatile PIE6bits_t PIE6bits;
+
+typedef struct {
+    unsigned INT1IF : 8;
+    unsigned TMR0IF : 8;
+} PIR0bits_t;
+extern volatile PIR0bits_t PIR0bits;
+
+typedef struct {
+    unsigned ADTIF : 8;
+} PIR1bits_t;
+extern volatile PIR1bits_t PIR1bits;
+
+typedef struct {
+    unsigned C1IF : 8;
+    unsigned HLVDIF : 8;
+} PIR2bits_t;
+extern volatile PIR2bits_t PIR2bits;
+
+typedef struct {
+    unsigned RC1IF : 8;
+    unsigned RC2IF : 8;
+    unsigned TX2IF : 8;
+} PIR3bits_t;
+extern volatile PIR3bits_t PIR3bits;
+
+typedef struct {
+    unsigned RC4IF : 8;
+} PIR4bits_t;
+extern volatile PIR4bits_t PIR4bits;
+
+typedef struct {
+    unsigned TMR1IF : 8;
+    unsigned TMR2IF : 8;
+    unsigned TMR3IF : 8;
+    unsigned TMR4IF : 8;
+    unsigned TMR5IF : 8;
+    unsigned TMR6IF : 8;
+} PIR5bits_t;
+extern volatile PIR5bits_t PIR5bits;
+
+typedef struct {
+    unsigned CCP4IF : 8;
+} PIR6bits_t;
+extern volatile PIR6bits_t PIR6bits;
+
+typedef struct {
+    unsigned RD3 : 8;
+} PORTDbits_t;
+extern volatile PORTDbits_t PORTDbits;
+
+typedef struct {
+    unsigned RF2 : 8;
+} PORTFbits_t;
+extern volatile PORTFbits_t PORTFbits;
+
+typedef struct {
+    unsigned PWM6EN : 8;
+} PWM6CONbits_t;
+extern volatile PWM6CONbits_t PWM6CONbits;
+
+typedef struct {
+    unsigned CREN : 8;
+    unsigned FERR : 8;
+    unsigned OERR : 8;
+    unsigned SPEN : 8;
+} RC1STAbits_t;
+extern volatile RC1STAbits_t RC1STAbits;
+
+typedef struct {
+    unsigned CREN : 8;
+    unsigned FERR : 8;
+    unsigned OERR : 8;
+    unsigned SPEN : 8;
+} RC2STAbits_t;
+extern volatile RC2STAbits_t RC2STAbits;
+
+typedef struct {
+    unsigned CREN : 8;
+    unsigned OERR : 8;
+    unsigned SPEN : 8;
+} RC4STAbits_t;
+extern volatile RC4STAbits_t RC4STAbits;
+
+typedef struct {
+    unsigned EN : 8;
+    unsigned INTM : 8;
+    unsigned MODE : 8;
+    unsigned SCANGO : 8;
+} SCANCON0bits_t;
+extern volatile SCANCON0bits_t SCANCON0bits;
+
+typedef struct {
+    unsigned T016BIT : 8;
+    unsigned T0EN : 8;
+} T0CON0bits_t;
+extern volatile T0CON0bits_t T0CON0bits;
+
+typedef struct {
+    unsigned T0ASYNC : 8;
+    unsigned T0CKPS : 8;
+    unsigned T0CS : 8;
+} T0CON1bits_t;
+extern volatile T0CON1bits_t T0CON1bits;
+
+typedef struct {
+    unsigned CKPS : 8;
+    unsigned ON : 8;
+    unsigned RD16 : 8;
+} T1CONbits_t;
+extern volatile T1CONbits_t T1CONbits;
+
+typedef struct {
+    unsigned GE : 8;
+} T1GCONbits_t;
+extern volatile T1GCONbits_t T1GCONbits;
+
+typedef struct {
+    unsigned CKPS : 8;
+    unsigned ON : 8;
+    unsigned OUTPS : 8;
+} T2CONbits_t;
+extern volatile T2CONbits_t T2CONbits;
+
+typedef struct {
+    unsigned CKPS : 8;
+    unsigned ON : 8;
+    unsigned RD16 : 8;
+} T3CONbits_t;
+extern volatile T3CONbits_t T3CONbits;
+
+typedef struct {
+    unsigned GE : 8;
+} T3GCONbits_t;
+extern volatile T3GCONbits_t T3GCONbits;
+
+typedef struct {
+    unsigned CKPS : 8;
+    unsigned ON : 8;
+    unsigned OUTPS : 8;
+} T4CONbits_t;
+extern volatile T4CONbits_t T4CONbits;
+
+typedef struct {
+    unsigned CKPS : 8;
+    unsigned ON : 8;
+    unsigned RD16 : 8;
+} T5CONbits_t;
+extern volatile T5CONbits_t T5CONbits;
+
+typedef struct {
+    unsigned GE : 8;
+} T5GCONbits_t;
+extern volatile T5GCONbits_t T5GCONbits;
+
+typedef struct {
+    unsigned CKPS : 8;
+    unsigned ON : 8;
+    unsigned OUTPS : 8;
+} T6CONbits_t;
+extern volatile T6CONbits_t T6CONbits;
+
+typedef struct {
+    unsigned TRISA0 : 8;
+    unsigned TRISA1 : 8;
+    unsigned TRISA2 : 8;
+    unsigned TRISA3 : 8;
+    unsigned TRISA4 : 8;
+    unsigned TRISA5 : 8;
+} TRISAbits_t;
+extern volatile TRISAbits_t TRISAbits;
+
+typedef struct {
+    unsigned TRISB0 : 8;
+    unsigned TRISB1 : 8;
+    unsigned TRISB2 : 8;
+    unsigned TRISB3 : 8;
+    unsigned TRISB4 : 8;
+} TRISBbits_t;
+extern volatile TRISBbits_t TRISBbits;
+
+typedef struct {
+    unsigned TRISC0 : 8;
+    unsigned TRISC1 : 8;
+    unsigned TRISC2 : 8;
+    unsigned TRISC6 : 8;
+    unsigned TRISC7 : 8;
+} TRISCbits_t;
+extern volatile TRISCbits_t TRISCbits;
+
+typedef struct {
+    unsigned TRISD0 : 8;
+    unsigned TRISD1 : 8;
+    unsigned TRISD2 : 8;
+    unsigned TRISD3 : 8;
+} TRISDbits_t;
+extern volatile TRISDbits_t TRISDbits;
+
+typedef struct {
+    unsigned TRISE1 : 8;
+    unsigned TRISE3 : 8;
+} TRISEbits_t;
+extern volatile TRISEbits_t TRISEbits;
+
+typedef struct {
+    unsigned TRISF0 : 8;
+    unsigned TRISF2 : 8;
+    unsigned TRISF6 : 8;
+    unsigned TRISF7 : 8;
+} TRISFbits_t;
+extern volatile TRISFbits_t TRISFbits;
+
+typedef struct {
+    unsigned TRISG0 : 8;
+    unsigned TRISG1 : 8;
+} TRISGbits_t;
+extern volatile TRISGbits_t TRISGbits;
+
+typedef struct {
+    unsigned BRGH : 8;
+} TX1STAbits_t;
+extern volatile TX1STAbits_t TX1STAbits;
+
+typedef struct {
+    unsigned BRGH : 8;
+    unsigned TXEN : 8;
+} TX2STAbits_t;
+extern volatile TX2STAbits_t TX2STAbits;
+
+typedef struct {
+    unsigned BRGH : 8;
+    unsigned TRMT : 8;
+    unsigned TXEN : 8;
+} TX4STAbits_t;
+extern volatile TX4STAbits_t TX4STAbits;
+
+typedef struct {
+    unsigned SEN : 8;
+} WDTCON0bits_t;
+extern volatile WDTCON0bits_t WDTCON0bits;
+
+extern volatile uint8_t ADACQ;
+extern volatile uint8_t ADFLTRH;
+extern volatile uint8_t ADFLTRL;
+extern volatile uint8_t ADPCH;
+extern volatile uint8_t ADREF;
+extern volatile uint8_t ADRPT;
+extern volatile uint8_t CCP4PPS;
+extern volatile uint8_t CCPR4H;
+extern volatile uint8_t CCPR4L;
+extern volatile uint8_t CLC1GLS0;
+extern volatile uint8_t CLC1GLS1;
+extern volatile uint8_t CLC1GLS2;
+extern volatile uint8_t CLC1GLS3;
+extern volatile uint8_t CLC1POL;
+extern volatile uint8_t CLC1SEL0;
+extern volatile uint8_t CLC1SEL1;
+extern volatile uint8_t CLC2GLS0;
+extern volatile uint8_t CLC2GLS1;
+extern volatile uint8_t CLC2GLS2;
+extern volatile uint8_t CLC2GLS3;
+extern volatile uint8_t CLC2POL;
+extern volatile uint8_t CLC2SEL0;
+extern volatile uint8_t CRCACCH;
+extern volatile uint8_t CRCACCL;
+extern volatile uint8_t CRCDATL;
+extern volatile uint8_t CRCXORH;
+extern volatile uint8_t CRCXORL;
+extern volatile uint8_t INT1PPS;
+extern volatile uint8_t LATA;
+extern volatile uint8_t LATB;
+extern volatile uint8_t LATC;
+extern volatile uint8_t LATD;
+extern volatile uint8_t LATE;
+extern volatile uint8_t LATF;
+extern volatile uint8_t LATG;
+extern volatile uint8_t NCO1INCH;
+extern volatile uint8_t NCO1INCL;
+extern volatile uint8_t NCO1INCU;
+extern volatile uint8_t NVMADRH;
+extern volatile uint8_t NVMADRL;
+extern volatile uint8_t NVMCON2;
+extern volatile uint8_t NVMDAT;
+extern volatile uint8_t PCON0;
+extern volatile uint8_t PWM6DCH;
+extern volatile uint8_t PWM6DCL;
+extern volatile uint8_t RB0PPS;
+extern volatile uint8_t RB1PPS;
+extern volatile uint8_t RC0PPS;
+extern volatile uint8_t RC1REG;
+extern volatile uint8_t RC2REG;
+extern volatile uint8_t RC4REG;
+extern volatile uint8_t RD0PPS;
+extern volatile uint8_t RX1PPS;
+extern volatile uint8_t RX2PPS;
+extern volatile uint8_t RX4PPS;
+extern volatile uint8_t SCANHADRH;
+extern volatile uint8_t SCANHADRL;
+extern volatile uint8_t SCANHADRU;
+extern volatile uint8_t SCANLADRH;
+extern volatile uint8_t SCANLADRL;
+extern volatile uint8_t SCANLADRU;
+extern volatile uint8_t SP1BRGH;
+extern volatile uint8_t SP1BRGL;
+extern volatile uint8_t SP2BRGH;
+extern volatile uint8_t SP2BRGL;
+extern volatile uint8_t SP4BRGH;
+extern volatile uint8_t SP4BRGL;
+extern volatile uint8_t T2CLKCON;
+extern volatile uint8_t T2HLT;
+extern volatile uint8_t T2PR;
+extern volatile uint8_t T2TMR;
+extern volatile uint8_t T1CLK;
+extern volatile uint8_t T3CLK;
+extern volatile uint8_t T4CLKCON;
+extern volatile uint8_t T4HLT;
+extern volatile uint8_t T4PR;
+extern volatile uint8_t T4TMR;
+extern volatile uint8_t T5CLK;
+extern volatile uint8_t T6CLKCON;
+extern volatile uint8_t T6HLT;
+extern volatile uint8_t T6PR;
+extern volatile uint8_t T6TMR;
+extern volatile uint8_t TABLAT;
+extern volatile uint8_t TBLPTRH;
+extern volatile uint8_t TBLPTRL;
+extern volatile uint8_t TBLPTRU;
+extern volatile uint8_t TMR0H;
+extern volatile uint8_t TMR0L;
+extern volatile uint8_t TMR1H;
+extern volatile uint8_t TMR1L;
+extern volatile uint8_t TMR3H;
+extern volatile uint8_t TMR3L;
+extern volatile uint8_t TMR5H;
+extern volatile uint8_t TMR5L;
+extern volatile uint8_t TX2REG;
+extern volatile uint8_t TX4REG;
+
+#endif /* XC_H */
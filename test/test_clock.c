@@ -1,7 +1,9 @@
 /*******************************************************************************
  * File:   test_clock.c
  * Purpose: Standalone test - clock counts 0-23 on LEDs 1-5 only. No LDR, no LCD.
- *          In TEST_MODE, 1 tick = 1 hour (24 seconds = full day).
+ *          Runs at the 3600x time scale: 1 tick = 1 clock hour (24 seconds =
+ *          full day). Build with Timer.c, Latency.c, UART.c, LEDS.c and
+ *          Light.c.
  ******************************************************************************/
 
 #include <xc.h>
@@ -15,21 +17,24 @@
 
 #define _XTAL_FREQ 64000000
 
+#define SECONDS_PER_HOUR (MINUTES_PER_HOUR * SECONDS_PER_MINUTE)
+
 int main(void) {
     uint8_t hour = 0;
-    uint32_t last_tick;
+    uint32_t last_second;
 
     LEDs_Init();
     Timer_Init();
+    Timer_SetTimeScale(SECONDS_PER_HOUR);
 
-    last_tick = Timer_GetTicks();
+    last_second = Timer_GetClockSeconds();
     LEDs_SetClockDisplay(hour);
 
     for (;;) {
-        uint32_t now = Timer_GetTicks();
+        uint32_t now = Timer_GetClockSeconds();
 
-        if ((now - last_tick) >= TICKS_PER_HOUR) {
-            last_tick += TICKS_PER_HOUR;
+        if ((now - last_second) >= SECONDS_PER_HOUR) {
+            last_second += SECONDS_PER_HOUR;
             hour++;
             if (hour >= HOURS_PER_DAY) {
                 hour = 0;
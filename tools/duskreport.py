@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+File:    duskreport.py
+Purpose: Turn the controller's dusk response report ('r' on the console,
+         Response.c) into a JSON file, and compare two such files, so
+         firmware changes can be judged number for number:
+
+             python3 tools/duskreport.py capture.log [out.json]
+             python3 tools/duskreport.py --compare before.json after.json
+
+         The capture is any console log; the last "dusk_response" line in
+         it is used. Percentiles come from the histogram, so each is the
+         upper edge of the bucket it falls in (None: the overflow bucket).
+         --compare also takes the host benchmark's output (make -C
+         test/host bench), which has the same keys once per profile.
+"""
+
+import json
+import sys
+
+HIST_BUCKETS = 13           # RESP_HIST_BUCKETS (Response.h)
+PERCENTILES = (50, 90, 99)
+
+
+def bucket_edges():
+    """Upper edge of each histogram bucket, ms; None for the last one."""
+    return [16 << b for b in range(HIST_BUCKETS - 1)] + [None]
+
+
+def parse(text):
+    line = None
+    for candidate in text.splitlines():
+        if candidate.startswith("dusk_response"):
+            line = candidate
+    if line is None:
+        raise ValueError("no dusk_response line in the capture")
+
+    result = {}
+    for field in line.split()[1:]:
+        key, _, value = field.partition("=")
+        if key == "hist":
+            result[key] = [int(n) for n in value.split("/")]
+        else:
+            result[key] = int(value)
+    if len(result.get("hist", [])) != HIST_BUCKETS:
+        raise ValueError("histogram has %d buckets, expected %d"
+                         % (len(result.get("hist", [])), HIST_BUCKETS))
+
+    edges = bucket_edges()
+    total = sum(result["hist"])
+    for p in PERCENTILES:
+        value = None
+        seen = 0
+        for n, edge in zip(result["hist"], edges):
+            seen += n
+            if total and seen * 100 >= total * p:
+                value = edge
+                break
+        result["p%d_ms" % p] = value
+    result["bucket_edges_ms"] = edges
+    return result
+
+
+def flatten(result, prefix=""):
+    """Nested keys joined with dots (benchmark profiles); lists dropped."""
+    flat = {}
+    for key, value in result.items():
+        if isinstance(value, dict):
+            flat.update(flatten(value, prefix + key + "."))
+        elif not isinstance(value, list):
+            flat[prefix + key] = value
+    return flat
+
+
+def compare(before, after):
+    before, after = flatten(before), flatten(after)
+    print("%-32s %10s %10s %10s" % ("", "before", "after", "change"))
+    for key in after:
+        a, b = before.get(key), after.get(key)
+        if a is None or b is None:
+            change = ""
+        elif isinstance(a, int) and isinstance(b, int):
+            change = "%+d" % (b - a)
+        else:
+            change = "%+.1f" % (b - a)
+        print("%-32s %10s %10s %10s" % (key, a, b, change))
+
+
+def main(argv):
+    if len(argv) == 4 and argv[1] == "--compare":
+        with open(argv[2]) as f:
+            before = json.load(f)
+        with open(argv[3]) as f:
+            after = json.load(f)
+        compare(before, after)
+        return 0
+    if len(argv) not in (2, 3):
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    with open(argv[1], errors="replace") as f:
+        result = parse(f.read())
+    out = json.dumps(result, indent=2, sort_keys=True)
+    if len(argv) == 3:
+        with open(argv[2], "w") as f:
+            f.write(out + "\n")
+    else:
+        print(out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
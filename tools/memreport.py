@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""
+File:    memreport.py
+Purpose: Per-module RAM/flash report from the XC8 link map, checked against
+         the budgets below. Run after each build (the MPLAB project's
+         .build-post step does this):
+
+             python3 tools/memreport.py [map file] [source dir]
+
+         Defaults: the newest *.map under supersecretproject.X/dist, and new/.
+
+         Symbols are sized from the map's symbol table (next symbol or the
+         end of the psect, whichever comes first) and charged to the module
+         whose .c file defines them. The compiled stack and compiler
+         runtime (startup, cinit, library helpers) are shown on their own
+         rows. Exit status 1 if a module or a device total is over budget,
+         2 if the map is stale: it names functions or variables that no
+         longer exist in the sources, so it was linked from an older tree
+         and its figures say nothing about this one.
+"""
+
+import glob
+import os
+import re
+import sys
+
+# Device limits: PIC18F66K40 general-purpose RAM, the part of it in the
+# access bank, and program flash below LOG_FLASH_START (Config.h).
+RAM_TOTAL = 0xDE9           # 0x001-0xDE9
+ACCESS_TOTAL = 0x5F         # 0x001-0x05F, shared with the compiler's temps
+FLASH_TOTAL = 0x8000
+
+# Per-module budgets, bytes: (RAM, flash). Whatever the budgets do not
+# hand out is the room left for new subsystems.
+BUDGETS = {
+    "Main":       (96,  4096),
+    "ADC":        (32,  1024),
+    "BCD":        (0,   256),
+    "Buttons":    (0,   128),
+    "Calendar":   (16,  1024),
+    "Comparator": (8,   512),
+    "CRC":        (0,   384),
+    "DST":        (16,  1280),
+    "Dimmer":     (16,  768),
+    "Discipline": (32,  1024),
+    "FlashCheck": (16,  512),
+    "GPS":        (128, 2048),
+    "Journal":    (320, 1280),
+    "LCD":        (8,   1280),
+    "LEDS":       (0,   768),
+    "Latency":    (64,  768),
+    "Light":      (16,  768),
+    "Logger":     (336, 2048),
+    "Lux":        (4,   768),
+    "MSF":        (48,  2048),
+    "Modbus":     (320, 2048),
+    "NVM":        (0,   512),
+    "Persist":    (24,  256),
+    "Profile":    (160, 768),
+    "Response":   (80,  768),
+    "Schedule":   (272, 1024),
+    "TimeSync":   (48,  1280),
+    "Timer":      (32,  1024),
+    "UART":       (8,   384),
+    "Watchdog":   (8,   128),
+}
+DEFAULT_BUDGET = (32, 768)     # modules not listed yet
+STACK_BUDGET = 256              # compiled stack (RAM)
+RUNTIME_BUDGET = 1024           # startup, cinit, library helpers (flash)
+
+SPACE_CODE = 0
+SPACE_DATA = 1
+
+# C library functions the linker may pull in: not ours, but not stale.
+LIBRARY = {"memcpy", "memmove", "memset", "memcmp", "strlen", "strcpy", "strncpy",
+           "strcmp", "strncmp", "strcat", "sprintf", "snprintf", "printf", "abs",
+           "labs", "div", "ldiv", "atoi", "itoa", "utoa", "rand", "srand", "qsort"}
+
+FUNC_RE = re.compile(
+    r"^ ?(?!typedef\b|return\b|else\b|if\b|while\b|for\b|switch\b|#)"
+    r"[A-Za-z_][\w \t*]*?(?:__interrupt\([^)]*\)\s*)?\b([A-Za-z_]\w*)\s*\([^;{]*?\)\s*\{",
+    re.M)
+VAR_RE = re.compile(
+    r"^(?!typedef\b|return\b|extern\b|#)"
+    r"(?:(?:static|volatile|const|__near|__persistent)\s+)*"
+    r"(?:(?:unsigned|signed|struct)\s+)?\w+\s*(?:\*\s*(?:const\s+)?)*"
+    r"([A-Za-z_]\w*)\s*(?:\[[^\]]*\]\s*)*(?:=|;|__at\b)",
+    re.M)
+LOCAL_STATIC_RE = re.compile(r"^[ \t]+static\s+[^;(]*?\b([A-Za-z_]\w*)\s*(?:\[[^\]]*\]\s*)*(?:=|;)", re.M)
+
+
+def find_map(root):
+    maps = glob.glob(os.path.join(root, "supersecretproject.X", "dist", "*", "*", "*.map"))
+    if not maps:
+        sys.exit("memreport: no map file (build the project first)")
+    return max(maps, key=os.path.getmtime)
+
+
+def parse_map(path):
+    """Psect extents {name: [(start, end, space)]} and symbols [(name, psect, addr)]."""
+    psects = {}
+    symbols = []
+    in_psects = False
+    in_symbols = False
+    with open(path, errors="ignore") as f:
+        for line in f:
+            fields = line.split()
+            if line.strip().startswith("Name") and "Selector" in line and "Scale" in line:
+                in_psects = True
+                continue
+            if line.startswith("TOTAL"):
+                in_psects = False
+            if "Symbol Table" in line:
+                in_symbols = True
+                continue
+            if in_psects and len(fields) in (6, 7) and not fields[0].startswith(("CLASS", "SEGMENTS")):
+                try:
+                    link, length, space = int(fields[1], 16), int(fields[3], 16), int(fields[5])
+                except ValueError:
+                    continue
+                psects.setdefault(fields[0], []).append((link, link + length, space))
+            elif in_symbols and len(fields) == 3:
+                try:
+                    symbols.append((fields[0], fields[1], int(fields[2], 16)))
+                except ValueError:
+                    continue
+    return psects, symbols
+
+
+def parse_sources(src_dir):
+    """C name -> module, for functions, file-scope and function-local statics."""
+    owner = {}
+    clash = set()
+    for path in sorted(glob.glob(os.path.join(src_dir, "*.c"))):
+        module = os.path.splitext(os.path.basename(path))[0]
+        text = open(path, errors="ignore").read()
+        text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+        text = re.sub(r"//[^\n]*", "", text)
+        names = set(m.group(1) for m in FUNC_RE.finditer(text))
+        names |= set(m.group(1) for m in VAR_RE.finditer(text))
+        names |= set(m.group(1) for m in LOCAL_STATIC_RE.finditer(text))
+        for name in names:
+            if name in owner and owner[name] != module:
+                clash.add(name)
+            owner[name] = module
+    return owner, clash
+
+
+def module_of(symbol, owner, modules):
+    name = symbol[1:] if symbol.startswith("_") else symbol
+    if "@" in name:
+        # func@local (function-local static) or name@file (renamed static)
+        left, right = name.split("@", 1)
+        left = left.lstrip("_")
+        if left in owner:
+            return owner[left]
+        for module in modules:
+            if right.lower() == module.lower():
+                return module
+        return None
+    return owner.get(name)
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    map_path = sys.argv[1] if len(sys.argv) > 1 else find_map(root)
+    src_dir = sys.argv[2] if len(sys.argv) > 2 else os.path.join(root, "new")
+
+    psects, symbols = parse_map(map_path)
+    owner, clash = parse_sources(src_dir)
+    modules = sorted(set(owner.values()))
+
+    def extent(psect, addr):
+        for start, end, space in psects.get(psect, []):
+            if start <= addr < end:
+                return end, space
+        return None, None
+
+    # Size each symbol up to the next one in its psect.
+    by_psect = {}
+    for name, psect, addr in symbols:
+        if name.startswith(("__", "?")) or psect in ("(abs)", "__absolute__") or psect.startswith("cstack"):
+            continue
+        by_psect.setdefault(psect, []).append((addr, name))
+
+    ram = {}
+    access = {}
+    flash = {}
+    used = {}           # bytes attributed per psect
+    unknown = []
+    for psect, entries in by_psect.items():
+        entries.sort()
+        for i, (addr, name) in enumerate(entries):
+            end, space = extent(psect, addr)
+            if end is None:
+                continue
+            if i + 1 < len(entries) and entries[i + 1][0] < end:
+                end = entries[i + 1][0]
+            size = end - addr
+            if size <= 0:
+                continue
+            if not name.startswith("_") and "@" not in name:
+                module = "(runtime)"            # startup labels
+            else:
+                module = module_of(name, owner, modules)
+            if module is None or name.lstrip("_") in clash:
+                unknown.append((name, size))
+                module = "(unattributed)"
+            used[psect] = used.get(psect, 0) + size
+            if space == SPACE_DATA:
+                ram[module] = ram.get(module, 0) + size
+                if addr < 0x60:
+                    access[module] = access.get(module, 0) + size
+            elif space == SPACE_CODE:
+                flash[module] = flash.get(module, 0) + size
+
+    # Psect bytes no symbol accounts for: compiled stack and runtime.
+    stack = 0
+    stack_access = 0
+    runtime = 0
+    for psect, ranges in psects.items():
+        for start, end, space in ranges:
+            rest = end - start - used.get(psect, 0)
+            used[psect] = max(0, used.get(psect, 0) - (end - start))
+            if rest <= 0 or start >= 0x200000:      # config, ID, EEPROM
+                continue
+            if space == SPACE_DATA:
+                stack += rest
+                if start < 0x60:
+                    stack_access += rest
+            elif space == SPACE_CODE:
+                runtime += rest
+
+    over = False
+    rows = []
+    runtime += flash.pop("(runtime)", 0)
+    for module in sorted(set(modules) | set(ram) | set(flash)):
+        budget = BUDGETS.get(module, DEFAULT_BUDGET) if module in modules else (None, None)
+        r, a, fl = ram.get(module, 0), access.get(module, 0), flash.get(module, 0)
+        bad = budget[0] is not None and (r > budget[0] or fl > budget[1])
+        over |= bad
+        rows.append((module, r, a, budget[0], fl, budget[1], bad))
+    rows.append(("(compiled stack)", stack, stack_access, STACK_BUDGET, 0, None, stack > STACK_BUDGET))
+    rows.append(("(runtime)", 0, 0, None, runtime, RUNTIME_BUDGET, runtime > RUNTIME_BUDGET))
+    over |= stack > STACK_BUDGET or runtime > RUNTIME_BUDGET
+
+    print("Memory report: %s" % os.path.relpath(map_path))
+    print("%-18s %6s %6s %6s   %6s %6s" % ("module", "RAM", "access", "budget", "flash", "budget"))
+    for module, r, a, rb, fl, fb, bad in rows:
+        print("%-18s %6d %6d %6s   %6d %6s%s" % (module, r, a, "-" if rb is None else rb,
+                                              fl, "-" if fb is None else fb,
+                                              "  OVER" if bad else ""))
+
+    ram_used = sum(ram.values()) + stack
+    access_used = sum(access.values()) + stack_access
+    flash_used = sum(flash.values()) + runtime
+    ram_budgeted = sum(BUDGETS.get(m, DEFAULT_BUDGET)[0] for m in modules) + STACK_BUDGET
+    flash_budgeted = sum(BUDGETS.get(m, DEFAULT_BUDGET)[1] for m in modules) + RUNTIME_BUDGET
+    print()
+    for label, used_bytes, budgeted, total in (("RAM", ram_used, ram_budgeted, RAM_TOTAL),
+                                               ("access", access_used, None, ACCESS_TOTAL),
+                                               ("flash", flash_used, flash_budgeted, FLASH_TOTAL)):
+        line = "%-7s %6d of %6d used, %6d free" % (label, used_bytes, total, total - used_bytes)
+        if budgeted is not None:
+            line += "; %6d budgeted, %6d unbudgeted" % (budgeted, total - budgeted)
+        if used_bytes > total:
+            line += "  OVER"
+            over = True
+        print(line)
+    if unknown:
+        print("\nunattributed: " + ", ".join("%s(%d)" % u for u in sorted(unknown)))
+
+    # Plain C names the sources do not define at all (a clash is still
+    # defined somewhere): left over from an older build.
+    gone = sorted(name for name, _ in unknown
+                  if name.startswith("_") and "@" not in name
+                  and name[1:] not in owner and name[1:] not in LIBRARY)
+    if gone:
+        print("\nmemreport: STALE MAP: %s is not from these sources (%s not in %s);"
+              " rebuild the project and run again" %
+              (os.path.relpath(map_path), ", ".join(gone), os.path.relpath(src_dir)))
+        return 2
+    return 1 if over else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())